@@ -0,0 +1,680 @@
+/***************************
+ ** File:    bench.cpp
+ ** Project: CMSC 341, proj3, Spring 2023
+ **
+ ** This file benchmarks cqueue.cpp. Insertion, removal, a mixed steady state,
+ ** mergeWithQueue, the copy constructor and the setPriorityFn rebuild are timed
+ ** for every structure and both heap types, on queue sizes from 10 to 10^7.
+ ** Bucket mode is reported as its own structure, BUCKET. Lazy merging is
+ ** reported as lazy_merge, with the removal that pays for the meld. updateOrder
+ ** is reported as update, one handle at a time, cancelOrder through the
+ ** order ID index as cancel, and peekTopOrders of the best ten orders as peek.
+ ** saveSnapshot and loadSnapshot of a filled queue are reported per order as
+ ** save and load, to compare a restart from a snapshot against insert.
+ ** For SKEW and LEFTIST, PersistentCQueue::snapshot is reported per order as
+ ** snapshot, to compare against copy, and its mixed steady state as
+ ** persistent_mixed, and as snapshot_mixed with a reader's snapshot replaced
+ ** every hundred pairs.
+ ** Results are written as CSV with the time and number of allocations per operation.
+ **
+ ** With --threads, ConcurrentCQueue and MultiCQueue are instead compared against
+ ** a CQueue behind one global mutex, with 1 to 32 threads each inserting and
+ ** removing, followed by the mean and largest rank error of MultiCQueue.
+ **
+ ** With --log, insert and removal pairs on a filled queue are timed with an
+ ** OrderLog attached at several group commit intervals, and with no log,
+ ** reporting operations per second and the number of write and fsync pairs.
+ **
+ ** With --ingest, a file of orders is read into an empty queue with OrderIngest,
+ ** as CSV and as binary, and against the CSV read a line at a time with
+ ** insertOrder for each, reporting orders per second.
+ **
+ ** Usage: ./cqbench [max size]
+ **        ./cqbench --threads [max threads]
+ **        ./cqbench --log [pairs]
+ **        ./cqbench --ingest [orders]
+ **
+*****************************/
+
+#include "cqueue.h"
+#include "ccqueue.h"
+#include "cqlog.h"
+#include "cqingest.h"
+#include "pcqueue.h"
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <new>
+#include <thread>
+#include <mutex>
+
+int priorityFn1(const Order &order);// works with a MAXHEAP
+int priorityFn2(const Order &order);// works with a MINHEAP
+
+//global constants
+const long MINBENCHSIZE = 10; //smallest queue size benchmarked
+const long MAXBENCHSIZE = 10000000; //largest queue size benchmarked
+const long MINBENCHWORK = 1000000; //small sizes are repeated until about this many orders are touched
+const int MAXBENCHPRIORITY = 5003; //largest value of either priority function, the top of the bucket range
+const int MAXBENCHTHREADS = 32; //most threads in the scalability benchmark
+const int PEEKORDERS = 10; //orders read by each peekTopOrders call, one kitchen display
+const char SNAPSHOTFILE[] = "cqbench.snapshot"; //written and removed by the save and load benchmarks
+const long MINSNAPSHOTSIZE = 1000; //below this size opening the file is all a snapshot benchmark measures
+const long THREADBENCHOPS = 1000000; //insert and removal pairs shared among the threads
+const long THREADBENCHSIZE = 100000; //orders in the queue before the threads start
+const long RANKSAMPLES = 10000; //removals measured for the rank error of MultiCQueue
+const long LOGBENCHOPS = 20000; //insert and removal pairs timed for each commit interval
+const char LOGFILE[] = "cqbench.log"; //written and removed by the log benchmark
+const long SNAPSHOTPAIRS = 100; //insert and removal pairs between the snapshots of snapshot_mixed
+const long INGESTBENCHORDERS = 1000000; //orders in the files read by the ingest benchmark
+const char INGESTFILE[] = "cqbench.ingest"; //written and removed by the ingest benchmark
+
+//every allocation made by the program is counted, so allocations per operation can be reported
+static atomic<long> numAllocations(0);
+
+void* operator new(size_t size){
+    numAllocations.fetch_add(1, memory_order_relaxed);
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr){
+        throw bad_alloc();
+    }
+    return ptr;
+}
+void operator delete(void* ptr) noexcept{
+    free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept{
+    free(ptr);
+}
+
+//random class taken from driver, used to generate the benchmarked orders
+class Random {
+public:
+    Random(int min, int max) : m_min(min), m_max(max)
+    {
+        // Using a fixed seed value generates always the same sequence
+        // of pseudorandom numbers, so each run benchmarks the same orders
+        m_generator = std::mt19937(10);// 10 is the fixed seed value
+        m_unidist = std::uniform_int_distribution<>(min,max);
+    }
+    void setSeed(int seedNum){
+        m_generator = std::mt19937(seedNum);
+    }
+    int getRandNum(){
+        // this will generate a random number between min and max values
+        return m_unidist(m_generator);
+    }
+
+    private:
+    int m_min;
+    int m_max;
+    std::mt19937 m_generator;
+    std::uniform_int_distribution<> m_unidist;//integer uniform distribution
+};
+
+//Timer
+//measures the time and number of allocations of one benchmark
+class Timer{
+    public:
+    void start(){
+        m_allocations = numAllocations.load(memory_order_relaxed);
+        m_start = chrono::steady_clock::now();
+    }
+    void stop(){
+        m_nanoseconds += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - m_start).count();
+        m_totalAllocations += numAllocations.load(memory_order_relaxed) - m_allocations;
+    }
+    double nanoseconds() const {return double(m_nanoseconds);}
+    double allocations() const {return double(m_totalAllocations);}
+
+    private:
+    chrono::steady_clock::time_point m_start;
+    long m_allocations = 0;
+    long long m_nanoseconds = 0;
+    long m_totalAllocations = 0;
+};
+
+//makeOrders
+//fills the vector with random orders, the same way the tests fill a queue
+void makeOrders(vector<Order>& orders, long num, int seed){
+    Random orderIdGen(MINORDERID,MAXORDERID);
+    Random customerIdGen(MINCUSTID,MAXCUSTID);
+    customerIdGen.setSeed(seed);
+    Random membershipGen(0,5); // there are six tiers
+    membershipGen.setSeed(seed + 1);
+    Random pointsGen(MINPOINTS,MAXPOINTS);
+    pointsGen.setSeed(seed + 2);
+    Random itemGen(0,5); // there are six items
+    itemGen.setSeed(seed + 3);
+    Random countGen(0,3); // there are three possible quantity values
+    countGen.setSeed(seed + 4);
+
+    orders.clear();
+    orders.reserve(num);
+    for (long i = 0; i < num; i++){
+        orders.push_back(Order(static_cast<ITEM>(itemGen.getRandNum()),
+                    static_cast<COUNT>(countGen.getRandNum()),
+                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
+                    pointsGen.getRandNum(),
+                    customerIdGen.getRandNum(),
+                    orderIdGen.getRandNum()));
+    }
+}
+
+//structureName
+//returns the name of the structure as it appears in the CSV
+const char* structureName(STRUCTURE structure){
+    switch (structure){
+        case SKEW: return "SKEW";
+        case LEFTIST: return "LEFTIST";
+        case DARY: return "DARY";
+        case PAIRING: return "PAIRING";
+        default: return "UNKNOWN";
+    }
+}
+
+//report
+//writes one CSV row
+void report(const char* name, const char* structure, HEAPTYPE heapType, long size, long ops, const Timer& timer){
+    cout << name << ","
+         << structure << ","
+         << ((heapType == MINHEAP) ? "MINHEAP" : "MAXHEAP") << ","
+         << size << "," << ops << ","
+         << timer.nanoseconds() / ops << ","
+         << timer.allocations() / ops << endl;
+}
+
+//makeQueue
+//returns an empty queue, in bucket mode if requested
+CQueue makeQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure, bool bucketed){
+    CQueue cqueue(priFn, heapType, structure);
+    if (bucketed){
+        cqueue.setPriorityRange(0, MAXBENCHPRIORITY);
+    }
+    return cqueue;
+}
+
+long checksum = 0; //order IDs are summed so the removals cannot be optimized away
+
+//benchmark
+//runs every operation for one structure, heap type and size
+void benchmark(STRUCTURE structure, HEAPTYPE heapType, long size, bool bucketed){
+    const char* name = (bucketed ? "BUCKET" : structureName(structure));
+    prifn_t priFn = ((heapType == MAXHEAP) ? priorityFn1 : priorityFn2);
+    prifn_t oppFn = ((heapType == MAXHEAP) ? priorityFn2 : priorityFn1);
+    HEAPTYPE oppHeap = ((heapType == MAXHEAP) ? MINHEAP : MAXHEAP);
+    long reps = ((size < MINBENCHWORK) ? MINBENCHWORK / size : 1);
+
+    vector<Order> orders;
+    vector<Order> extra;
+    makeOrders(orders, size, 0);
+    makeOrders(extra, size, 100);
+
+    //insert, size orders inserted into an empty queue
+    Timer insertTimer;
+    Timer removeTimer;
+    for (long r = 0; r < reps; r++){
+        CQueue cqueue = makeQueue(priFn, heapType, structure, bucketed);
+        insertTimer.start();
+        for (long i = 0; i < size; i++){
+            cqueue.insertOrder(orders[i]);
+        }
+        insertTimer.stop();
+
+        //dequeue, every order removed from the filled queue
+        removeTimer.start();
+        for (long i = 0; i < size; i++){
+            checksum += cqueue.getNextOrder().getOrderID();
+        }
+        removeTimer.stop();
+    }
+    report("insert", name, heapType, size, size * reps, insertTimer);
+    report("dequeue", name, heapType, size, size * reps, removeTimer);
+
+    //mixed, a filled queue alternates between inserting and removing
+    Timer mixedTimer;
+    {
+        CQueue cqueue = makeQueue(priFn, heapType, structure, bucketed);
+        cqueue.insertOrders(orders);
+        mixedTimer.start();
+        for (long r = 0; r < reps; r++){
+            for (long i = 0; i < size; i++){
+                cqueue.insertOrder(extra[i]);
+                checksum += cqueue.getNextOrder().getOrderID();
+            }
+        }
+        mixedTimer.stop();
+    }
+    report("mixed", name, heapType, size, size * reps * 2, mixedTimer);
+
+    //peekTopOrders, the best PEEKORDERS orders of a filled queue read without removing them
+    Timer peekTimer;
+    {
+        CQueue cqueue = makeQueue(priFn, heapType, structure, bucketed);
+        cqueue.insertOrders(orders);
+        peekTimer.start();
+        for (long r = 0; r < reps; r++){
+            checksum += cqueue.peekTopOrders(PEEKORDERS).size();
+        }
+        peekTimer.stop();
+    }
+    report("peek", name, heapType, size, reps, peekTimer);
+
+    //saveSnapshot and loadSnapshot, a filled queue written out then read back into another queue
+    if (size >= MINSNAPSHOTSIZE){
+        Timer saveTimer;
+        Timer loadTimer;
+        CQueue cqueue = makeQueue(priFn, heapType, structure, bucketed);
+        cqueue.insertOrders(orders);
+        CQueue loadedQueue(priFn, heapType, structure);
+        for (long r = 0; r < reps; r++){
+            saveTimer.start();
+            cqueue.saveSnapshot(SNAPSHOTFILE);
+            saveTimer.stop();
+            loadTimer.start();
+            loadedQueue.loadSnapshot(SNAPSHOTFILE);
+            loadTimer.stop();
+        }
+        checksum += loadedQueue.getNextOrder().getOrderID();
+        remove(SNAPSHOTFILE);
+        report("save", name, heapType, size, size * reps, saveTimer);
+        report("load", name, heapType, size, size * reps, loadTimer);
+    }
+
+    //updateOrder, every order of a filled queue is given new data through its handle
+    if (structure != DARY){
+        Timer updateTimer;
+        CQueue cqueue = makeQueue(priFn, heapType, structure, bucketed);
+        vector<OrderHandle> handles;
+        handles.reserve(size);
+        for (long i = 0; i < size; i++){
+            handles.push_back(cqueue.insertOrder(orders[i]));
+        }
+        updateTimer.start();
+        for (long r = 0; r < reps; r++){
+            for (long i = 0; i < size; i++){
+                cqueue.updateOrder(handles[i], (((r + i) % 2 == 0) ? extra[i] : orders[i]));
+            }
+        }
+        updateTimer.stop();
+        checksum += cqueue.getNextOrder().getOrderID();
+        report("update", name, heapType, size, size * reps, updateTimer);
+
+        //cancelOrder through the order ID index, every order of a filled queue cancelled in insertion order
+        Timer cancelTimer;
+        cqueue.clear();
+        cqueue.setOrderIndex(true);
+        for (long r = 0; r < reps; r++){
+            cqueue.insertOrders(orders);
+            cancelTimer.start();
+            for (long i = 0; i < size; i++){
+                checksum += cqueue.cancelOrder(orders[i].getOrderID());
+            }
+            cancelTimer.stop();
+        }
+        report("cancel", name, heapType, size, size * reps, cancelTimer);
+    }
+
+    //mergeWithQueue, two queues of size orders merged
+    Timer mergeTimer;
+    for (long r = 0; r < reps; r++){
+        CQueue lhs = makeQueue(priFn, heapType, structure, bucketed);
+        CQueue rhs = makeQueue(priFn, heapType, structure, bucketed);
+        lhs.insertOrders(orders);
+        rhs.insertOrders(extra);
+        mergeTimer.start();
+        lhs.mergeWithQueue(rhs);
+        mergeTimer.stop();
+        checksum += lhs.numOrders();
+    }
+    report("merge", name, heapType, size, reps, mergeTimer);
+
+    //lazy mergeWithQueue, the merge is recorded and the first removal pays for one meld
+    if (!bucketed && (structure != DARY)){
+        Timer lazyTimer;
+        Timer firstTimer;
+        for (long r = 0; r < reps; r++){
+            CQueue lhs(priFn, heapType, structure);
+            CQueue rhs(priFn, heapType, structure);
+            lhs.setLazyMerge(true);
+            lhs.insertOrders(orders);
+            rhs.insertOrders(extra);
+            lazyTimer.start();
+            lhs.mergeWithQueue(rhs);
+            lazyTimer.stop();
+            firstTimer.start();
+            checksum += lhs.getNextOrder().getOrderID();
+            firstTimer.stop();
+        }
+        report("lazy_merge", name, heapType, size, reps, lazyTimer);
+        report("lazy_first_dequeue", name, heapType, size, reps, firstTimer);
+    }
+
+    //copy and setPriorityFn, reported per order in the queue
+    Timer copyTimer;
+    Timer rebuildTimer;
+    {
+        CQueue cqueue = makeQueue(priFn, heapType, structure, bucketed);
+        cqueue.insertOrders(orders);
+        for (long r = 0; r < reps; r++){
+            copyTimer.start();
+            CQueue copy(cqueue);
+            copyTimer.stop();
+            checksum += copy.numOrders();
+
+            rebuildTimer.start();
+            cqueue.setPriorityFn(((r % 2 == 0) ? oppFn : priFn), ((r % 2 == 0) ? oppHeap : heapType));
+            rebuildTimer.stop();
+        }
+    }
+    report("copy", name, heapType, size, size * reps, copyTimer);
+    report("rebuild", name, heapType, size, size * reps, rebuildTimer);
+
+    //the persistent queue, a snapshot is reported per order like copy, then the mixed steady state
+    //with no snapshot alive, and with a reader's snapshot replaced every SNAPSHOTPAIRS pairs
+    if (!bucketed && ((structure == SKEW) || (structure == LEFTIST))){
+        Timer snapshotTimer;
+        Timer persistentTimer;
+        Timer sharedTimer;
+        PersistentCQueue pqueue(priFn, heapType, structure);
+        for (long i = 0; i < size; i++){
+            pqueue.insertOrder(orders[i]);
+        }
+        for (long r = 0; r < reps; r++){
+            snapshotTimer.start();
+            PersistentCQueue version = pqueue.snapshot();
+            snapshotTimer.stop();
+            checksum += version.numOrders();
+        }
+
+        persistentTimer.start();
+        for (long r = 0; r < reps; r++){
+            for (long i = 0; i < size; i++){
+                pqueue.insertOrder(extra[i]);
+                checksum += pqueue.getNextOrder().getOrderID();
+            }
+        }
+        persistentTimer.stop();
+
+        PersistentCQueue reader = pqueue.snapshot();
+        sharedTimer.start();
+        for (long r = 0; r < reps; r++){
+            for (long i = 0; i < size; i++){
+                if (i % SNAPSHOTPAIRS == 0){
+                    reader = pqueue.snapshot();
+                }
+                pqueue.insertOrder(extra[i]);
+                checksum += pqueue.getNextOrder().getOrderID();
+            }
+        }
+        sharedTimer.stop();
+        checksum += reader.numOrders();
+        report("snapshot", name, heapType, size, size * reps, snapshotTimer);
+        report("persistent_mixed", name, heapType, size, size * reps * 2, persistentTimer);
+        report("snapshot_mixed", name, heapType, size, size * reps * 2, sharedTimer);
+    }
+}
+
+//MutexCQueue
+//the baseline for the scalability benchmark, a CQueue behind one global mutex
+class MutexCQueue{
+    public:
+    MutexCQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure) : m_queue(priFn, heapType, structure) {}
+    void insertOrder(const Order& order){
+        lock_guard<mutex> guard(m_lock);
+        m_queue.insertOrder(order);
+    }
+    bool tryGetNextOrder(Order& order){
+        lock_guard<mutex> guard(m_lock);
+        if (m_queue.numOrders() == 0){
+            return false;
+        }
+        order = m_queue.getNextOrder();
+        return true;
+    }
+
+    private:
+    CQueue m_queue;
+    mutex m_lock;
+};
+
+//runThreads
+//every thread alternates between inserting and removing until the pairs run out, returns the nanoseconds taken
+template <class Queue>
+double runThreads(Queue& queue, int numThreads, const vector<Order>& orders){
+    long pairsPerThread = THREADBENCHOPS / numThreads;
+    atomic<long> threadSum(0);
+    vector<thread> threads;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int t = 0; t < numThreads; t++){
+        threads.emplace_back([&queue, &orders, &threadSum, pairsPerThread, t](){
+            long localSum = 0;
+            Order order;
+            for (long i = 0; i < pairsPerThread; i++){
+                queue.insertOrder(orders[(t * pairsPerThread + i) % orders.size()]);
+                if (queue.tryGetNextOrder(order)){
+                    localSum += order.getOrderID();
+                }
+            }
+            threadSum += localSum;
+        });
+    }
+    for (int t = 0; t < numThreads; t++){
+        threads[t].join();
+    }
+    double nanoseconds = double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+    checksum += threadSum;
+    return nanoseconds;
+}
+
+//reportThreads
+//writes one CSV row of the scalability benchmark
+void reportThreads(const char* name, STRUCTURE structure, int numThreads, long ops, double nanoseconds){
+    cout << name << "," << structureName(structure) << ",MAXHEAP,"
+         << numThreads << "," << ops << ","
+         << nanoseconds / ops << ","
+         << (ops / nanoseconds) * 1000.0 << endl;
+}
+
+//scalability
+//compares the combining queue against the global mutex for each structure and thread count
+void scalability(int maxThreads){
+    const STRUCTURE structures[] = {SKEW, LEFTIST, DARY, PAIRING};
+    vector<Order> orders;
+    makeOrders(orders, THREADBENCHSIZE * 2, 0);
+
+    cout << "benchmark,structure,heaptype,threads,ops,ns_per_op,mops_per_sec" << endl;
+    for (STRUCTURE structure : structures){
+        for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2){
+            long ops = (THREADBENCHOPS / numThreads) * numThreads * 2;
+
+            MutexCQueue mutexQueue(priorityFn1, MAXHEAP, structure);
+            for (long i = 0; i < THREADBENCHSIZE; i++){
+                mutexQueue.insertOrder(orders[THREADBENCHSIZE + i]);
+            }
+            reportThreads("mutex", structure, numThreads, ops, runThreads(mutexQueue, numThreads, orders));
+
+            ConcurrentCQueue combiningQueue(priorityFn1, MAXHEAP, structure);
+            for (long i = 0; i < THREADBENCHSIZE; i++){
+                combiningQueue.insertOrder(orders[THREADBENCHSIZE + i]);
+            }
+            reportThreads("combining", structure, numThreads, ops, runThreads(combiningQueue, numThreads, orders));
+
+            MultiCQueue multiQueue(priorityFn1, MAXHEAP, structure, numThreads);
+            for (long i = 0; i < THREADBENCHSIZE; i++){
+                multiQueue.insertOrder(orders[THREADBENCHSIZE + i]);
+            }
+            reportThreads("multiqueue", structure, numThreads, ops, runThreads(multiQueue, numThreads, orders));
+        }
+    }
+
+    //rank error of MultiCQueue, a steady state of inserts and measured removals for each shard count
+    cout << "benchmark,structure,heaptype,shards,samples,mean_rank_error,max_rank_error" << endl;
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2){
+        MultiCQueue multiQueue(priorityFn1, MAXHEAP, LEFTIST, numThreads);
+        for (long i = 0; i < THREADBENCHSIZE; i++){
+            multiQueue.insertOrder(orders[THREADBENCHSIZE + i]);
+        }
+
+        long rankSum = 0;
+        int rankMax = 0;
+        for (long i = 0; i < RANKSAMPLES; i++){
+            Order order;
+            int rank = 0;
+            multiQueue.insertOrder(orders[i]);
+            multiQueue.measureNextOrder(order, rank);
+            rankSum += rank;
+            rankMax = ((rank > rankMax) ? rank : rankMax);
+        }
+        cout << "rank_error,LEFTIST,MAXHEAP," << multiQueue.numShards() << "," << RANKSAMPLES << ","
+             << double(rankSum) / RANKSAMPLES << "," << rankMax << endl;
+    }
+}
+
+//durability
+//times insert and removal pairs on a filled queue with no log, then with a log at each commit interval
+void durability(long numPairs){
+    const int intervals[] = {-1, 0, 100, 1000, 10000}; //commit intervals in microseconds, -1 for no log
+    vector<Order> orders;
+    makeOrders(orders, THREADBENCHSIZE + numPairs, 0);
+
+    cout << "benchmark,structure,heaptype,commit_micros,ops,ns_per_op,ops_per_sec,commits" << endl;
+    for (int interval : intervals){
+        CQueue cqueue(priorityFn1, MAXHEAP, LEFTIST);
+        cqueue.insertOrders(orders.begin(), orders.begin() + THREADBENCHSIZE);
+        OrderLog* log = nullptr;
+        if (interval >= 0){
+            remove(LOGFILE);
+            log = new OrderLog(LOGFILE, {priorityFn1, priorityFn2}, interval);
+            cqueue.attachLog(log);
+        }
+
+        //the pairs are timed until the last one is durable
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (long i = 0; i < numPairs; i++){
+            cqueue.insertOrder(orders[THREADBENCHSIZE + i]);
+            checksum += cqueue.getNextOrder().getOrderID();
+        }
+        if (log != nullptr){
+            log->sync();
+        }
+        double nanoseconds = double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+        long ops = numPairs * 2;
+        cout << "log,LEFTIST,MAXHEAP," << ((interval < 0) ? string("none") : to_string(interval)) << ","
+             << ops << "," << nanoseconds / ops << "," << (ops / nanoseconds) * 1e9 << ","
+             << ((log != nullptr) ? log->numCommits() : 0) << endl;
+        cqueue.attachLog(nullptr);
+        delete log;
+    }
+    remove(LOGFILE);
+}
+
+//ingestion
+//times reading a file of orders into an empty queue, with OrderIngest as CSV and binary, and with insertOrder
+//for each CSV line as a baseline
+void ingestion(long numOrders){
+    vector<Order> orders;
+    makeOrders(orders, numOrders, 0);
+
+    cout << "benchmark,structure,heaptype,format,orders,ns_per_order,orders_per_sec" << endl;
+    const char* names[] = {"csv", "csv_insertOrder", "binary"};
+    for (int run = 0; run < 3; run++){
+        //the file is written before the clock starts, the second run reads the CSV file of the first
+        if (run == 2){
+            OrderIngest::writeBinary(INGESTFILE, orders);
+        }
+        else if (run == 0){
+            ofstream file(INGESTFILE, ios::trunc);
+            for (const Order& order : orders){
+                file << order.getItem() << "," << order.getCount() << "," << order.getMemebership() << ","
+                     << order.getPoints() << "," << order.getCustomerID() << "," << order.getOrderID() << "\n";
+            }
+        }
+
+        CQueue cqueue(priorityFn1, MAXHEAP, LEFTIST);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        if (run == 1){
+            ifstream file(INGESTFILE);
+            string line;
+            while (getline(file, line)){
+                int item = 0, count = 0, membership = 0, points = 0, customerID = 0, orderID = 0;
+                if (sscanf(line.c_str(), "%d,%d,%d,%d,%d,%d", &item, &count, &membership, &points, &customerID, &orderID) == 6){
+                    cqueue.insertOrder(Order(static_cast<ITEM>(item), static_cast<COUNT>(count), static_cast<MEMBERSHIP>(membership),
+                                points, customerID, orderID));
+                }
+            }
+        }
+        else{
+            OrderIngest ingest((run == 0) ? CSVFORMAT : BINARYFORMAT);
+            ingest.ingest(INGESTFILE, cqueue);
+        }
+        double nanoseconds = double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        checksum += cqueue.getNextOrder().getOrderID();
+
+        cout << "ingest,LEFTIST,MAXHEAP," << names[run] << "," << numOrders << "," << nanoseconds / numOrders << ","
+             << (numOrders / nanoseconds) * 1e9 << endl;
+    }
+    remove(INGESTFILE);
+}
+
+int main(int argc, char* argv[]){
+    //if statement checks for the scalability benchmark
+    if ((argc > 1) && (strcmp(argv[1], "--threads") == 0)){
+        scalability((argc > 2) ? atoi(argv[2]) : MAXBENCHTHREADS);
+        cerr << "checksum: " << checksum << endl;
+        return 0;
+    }
+    //else if statement checks for the log benchmark
+    else if ((argc > 1) && (strcmp(argv[1], "--log") == 0)){
+        durability((argc > 2) ? atol(argv[2]) : LOGBENCHOPS);
+        cerr << "checksum: " << checksum << endl;
+        return 0;
+    }
+    //else if statement checks for the ingest benchmark
+    else if ((argc > 1) && (strcmp(argv[1], "--ingest") == 0)){
+        ingestion((argc > 2) ? atol(argv[2]) : INGESTBENCHORDERS);
+        cerr << "checksum: " << checksum << endl;
+        return 0;
+    }
+
+    long maxSize = ((argc > 1) ? atol(argv[1]) : MAXBENCHSIZE);
+    const STRUCTURE structures[] = {SKEW, LEFTIST, DARY, PAIRING};
+    const int numStructures = sizeof(structures) / sizeof(structures[0]);
+    const HEAPTYPE heapTypes[] = {MINHEAP, MAXHEAP};
+
+    cout << "benchmark,structure,heaptype,size,ops,ns_per_op,allocs_per_op" << endl;
+    for (long size = MINBENCHSIZE; size <= maxSize; size *= 10){
+        for (int s = 0; s < numStructures; s++){
+            for (int h = 0; h < 2; h++){
+                benchmark(structures[s], heapTypes[h], size, false);
+            }
+        }
+        for (int h = 0; h < 2; h++){
+            benchmark(SKEW, heapTypes[h], size, true);
+        }
+    }
+    cerr << "checksum: " << checksum << endl;
+
+    return 0;
+}
+
+int priorityFn1(const Order &order) {
+    //this function works with a MAXHEAP
+    //priority value falls in the range [0-5003]
+    int priority = static_cast<int>(order.getCount()) + order.getPoints();
+    return priority;
+}
+
+int priorityFn2(const Order &order) {
+    //this funcction works with a MINHEAP
+    //priority value falls in the range [0-10]
+    int priority = static_cast<int>(order.getItem()) + static_cast<int>(order.getMemebership());
+    return priority;
+}
@@ -0,0 +1,367 @@
+// CMSC 341 - Spring 2023 - Project 3
+#include "ccqueue.h"
+#include <thread>
+#include <functional>
+
+//overloaded constructor
+//creates an empty concurrent queue around a CQueue with the same policy
+ConcurrentCQueue::ConcurrentCQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure)
+    : m_queue(priFn, heapType, structure), m_combining(false), m_size(0), m_numSlots(0) {}
+
+//insertOrder
+//publishes an insertion and returns once a combiner has applied it
+void ConcurrentCQueue::insertOrder(const Order& order){
+    Order myOrder = order;
+    apply(INSERTOP, myOrder);
+}
+
+//getNextOrder
+//removes the highest priority order, an out of range error is thrown if the queue is empty
+Order ConcurrentCQueue::getNextOrder(){
+    Order myOrder;
+    if (!apply(NEXTOP, myOrder)){
+        throw out_of_range("Out of Range");
+    }
+    return myOrder;
+}
+
+//tryGetNextOrder
+//removes the highest priority order into order, returns false instead of throwing if the queue is empty
+bool ConcurrentCQueue::tryGetNextOrder(Order& order){
+    return apply(NEXTOP, order);
+}
+
+//numOrders
+//returns the number of orders as of the last combining pass
+int ConcurrentCQueue::numOrders() const{
+    return m_size.load(memory_order_acquire);
+}
+
+//getHeapType
+//returns heap type
+HEAPTYPE ConcurrentCQueue::getHeapType() const{
+    return m_queue.getHeapType();
+}
+
+//getStructure
+//returns the structure of the queue
+STRUCTURE ConcurrentCQueue::getStructure() const{
+    return m_queue.getStructure();
+}
+
+//apply
+//if no thread is combining, the request is run directly and any published requests are combined after it
+//otherwise the request is published in a slot, and this thread either becomes the next combiner or waits
+bool ConcurrentCQueue::apply(COMBINEOP op, Order& order){
+    //if statement takes the uncontended path, which never touches a slot
+    //an exception from this request skips the combine, the waiting threads combine once the lock is released
+    if (!m_combining.load(memory_order_relaxed) && !m_combining.exchange(true, memory_order_acquire)){
+        CombinerLock lock(m_combining);
+        bool found = execute(op, order);
+        combine();
+        return found;
+    }
+
+    CombineSlot& slot = m_slots[claimSlot()];
+    slot.m_op = op;
+    slot.m_order = order;
+    slot.m_state.store(SLOTPENDING, memory_order_release); //the request is visible to any combiner
+
+    //while loop runs until a combiner, possibly this thread, has finished the request
+    int spins = 0;
+    while (slot.m_state.load(memory_order_acquire) != SLOTDONE){
+        //if statement tries to take the combiner lock, checking it first so waiting threads only read the line
+        if (!m_combining.load(memory_order_relaxed) && !m_combining.exchange(true, memory_order_acquire)){
+            CombinerLock lock(m_combining);
+            combine();
+        }
+        else if (++spins == COMBINESPINS){
+            spins = 0;
+            this_thread::yield(); //the combiner may need this processor
+        }
+    }
+
+    //the result is read, then the slot is handed back, and an exception the request threw is rethrown here
+    order = slot.m_order;
+    bool found = slot.m_found;
+    exception_ptr error = slot.m_error;
+    slot.m_error = nullptr;
+    slot.m_state.store(SLOTFREE, memory_order_release);
+    if (error != nullptr){
+        rethrow_exception(error);
+    }
+    return found;
+}
+
+//execute
+//applies one request to the heap, a removal from an empty queue is reported as not found
+bool ConcurrentCQueue::execute(COMBINEOP op, Order& order){
+    if (op == INSERTOP){
+        m_queue.insertOrder(order);
+        return true;
+    }
+    else if (m_queue.numOrders() == 0){
+        return false;
+    }
+    else{
+        order = m_queue.getNextOrder();
+        return true;
+    }
+}
+
+//claimSlot
+//each thread starts at the slot it used last, the first time at slot zero, so the claimed slots stay
+//packed at the front and the combiner only scans as far as m_numSlots
+int ConcurrentCQueue::claimSlot(){
+    thread_local int lastSlot = 0; //slot this thread claimed last time, in any queue
+    int index = lastSlot;
+
+    //while loop probes the slots in order until a free one is claimed
+    while (true){
+        for (int i = 0; i < NUMCOMBINESLOTS; i++){
+            int expected = SLOTFREE;
+            if ((m_slots[index].m_state.load(memory_order_relaxed) == SLOTFREE)
+                    && m_slots[index].m_state.compare_exchange_strong(expected, SLOTCLAIMED, memory_order_acquire)){
+                //m_numSlots raised if this slot is past the end of the scanned range
+                int numSlots = m_numSlots.load(memory_order_relaxed);
+                while ((numSlots <= index) && !m_numSlots.compare_exchange_weak(numSlots, index + 1, memory_order_release)){
+                }
+                lastSlot = index;
+                return index;
+            }
+            index = (index + 1) % NUMCOMBINESLOTS;
+        }
+        this_thread::yield(); //every slot is in use, so another thread must finish first
+    }
+}
+
+//combine
+//applies every pending request to the heap, passing over the slots again while new requests keep arriving
+//each request that throws has the exception stored in its slot instead of leaving the combiner
+void ConcurrentCQueue::combine(){
+    //for loop makes up to COMBINEPASSES passes, stopping early once a pass finds nothing
+    for (int pass = 0; pass < COMBINEPASSES; pass++){
+        bool foundRequest = false;
+        int numSlots = m_numSlots.load(memory_order_acquire);
+
+        for (int i = 0; i < numSlots; i++){
+            CombineSlot& slot = m_slots[i];
+            if (slot.m_state.load(memory_order_acquire) != SLOTPENDING){
+                continue;
+            }
+
+            //an exception belongs to the slot's owner, so it is kept for them and the pass goes on
+            try{
+                slot.m_found = execute(slot.m_op, slot.m_order);
+            }
+            catch(...){
+                slot.m_found = false;
+                slot.m_error = current_exception();
+            }
+            slot.m_state.store(SLOTDONE, memory_order_release); //the owner may now read the result
+            foundRequest = true;
+        }
+
+        if (!foundRequest){
+            break;
+        }
+    }
+    m_size.store(m_queue.numOrders(), memory_order_release);
+}
+
+//tryLock
+//takes the lock if it is free, checking it first so a busy shard is only read
+bool MultiShard::tryLock(){
+    return !m_locked.load(memory_order_relaxed) && !m_locked.exchange(true, memory_order_acquire);
+}
+
+//lock
+//waits until the lock is taken
+void MultiShard::lock(){
+    while (!tryLock()){
+        this_thread::yield();
+    }
+}
+
+//unlock
+//publishes the size and top priority of the shard, then releases the lock
+void MultiShard::unlock(){
+    int size = m_queue.numOrders();
+    m_size.store(size, memory_order_relaxed);
+    if (size > 0){
+        m_top.store(m_queue.getNextPriority(), memory_order_relaxed);
+    }
+    m_locked.store(false, memory_order_release);
+}
+
+//overloaded constructor
+//creates shardFactor shards for each thread, and never fewer than MINSHARDS
+MultiCQueue::MultiCQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure, int numThreads, int shardFactor){
+    m_heapType = heapType;
+    m_structure = structure;
+    int numShards = ((numThreads * shardFactor < MINSHARDS) ? MINSHARDS : numThreads * shardFactor);
+    for (int i = 0; i < numShards; i++){
+        m_shards.push_back(new MultiShard(priFn, heapType, structure));
+    }
+}
+
+//destructor
+//deletes every shard
+MultiCQueue::~MultiCQueue(){
+    for (unsigned int i = 0; i < m_shards.size(); i++){
+        delete m_shards[i];
+    }
+}
+
+//insertOrder
+//inserts the order into the first random shard whose lock is free
+void MultiCQueue::insertOrder(const Order& order){
+    while (true){
+        MultiShard& shard = *m_shards[randomShard()];
+        if (shard.tryLock()){
+            shard.m_queue.insertOrder(order);
+            shard.unlock();
+            return;
+        }
+    }
+}
+
+//getNextOrder
+//removes a high priority order, an out of range error is thrown if every shard is empty
+Order MultiCQueue::getNextOrder(){
+    Order myOrder;
+    if (!tryGetNextOrder(myOrder)){
+        throw out_of_range("Out of Range");
+    }
+    return myOrder;
+}
+
+//tryGetNextOrder
+//removes the top of the better of two random shards, trying again with new shards if the lock is taken
+bool MultiCQueue::tryGetNextOrder(Order& order){
+    while (true){
+        int index = pickShard();
+        if (index < 0){
+            return false;
+        }
+
+        //if statement takes the lock, the shard may have been emptied since its size was published
+        MultiShard& shard = *m_shards[index];
+        if (shard.tryLock()){
+            bool found = (shard.m_queue.numOrders() > 0);
+            if (found){
+                order = shard.m_queue.getNextOrder();
+            }
+            shard.unlock();
+            if (found){
+                return true;
+            }
+        }
+    }
+}
+
+//measureNextOrder
+//locks every shard in index order, removes an order the same way as tryGetNextOrder, then counts
+//the orders of every shard that were ahead of it; rank is zero when the best order was removed
+bool MultiCQueue::measureNextOrder(Order& order, int& rank){
+    int numShards = int(m_shards.size());
+    for (int i = 0; i < numShards; i++){
+        m_shards[i]->lock();
+    }
+
+    //with every shard locked, the published sizes and tops are exact
+    int index = pickShard();
+    bool found = (index >= 0);
+    if (found){
+        CQueue& cqueue = m_shards[index]->m_queue;
+        int priority = cqueue.getNextPriority();
+        order = cqueue.getNextOrder();
+
+        rank = 0;
+        for (int i = 0; i < numShards; i++){
+            rank += m_shards[i]->m_queue.countAhead(priority);
+        }
+    }
+
+    for (int i = numShards - 1; i >= 0; i--){
+        m_shards[i]->unlock();
+    }
+    return found;
+}
+
+//numOrders
+//returns the sum of the sizes published by the shards
+int MultiCQueue::numOrders() const{
+    int total = 0;
+    for (unsigned int i = 0; i < m_shards.size(); i++){
+        total += m_shards[i]->m_size.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+//numShards
+//returns the number of shards
+int MultiCQueue::numShards() const{
+    return int(m_shards.size());
+}
+
+//getHeapType
+//returns heap type
+HEAPTYPE MultiCQueue::getHeapType() const{
+    return m_heapType;
+}
+
+//getStructure
+//returns the structure of every shard
+STRUCTURE MultiCQueue::getStructure() const{
+    return m_structure;
+}
+
+//randomShard
+//returns a random shard index, each thread keeps its own xorshift generator so no state is shared
+int MultiCQueue::randomShard() const{
+    thread_local unsigned int state = static_cast<unsigned int>(hash<thread::id>()(this_thread::get_id())) | 1u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<int>(state % m_shards.size());
+}
+
+//pickShard
+//compares the published tops of two random shards and returns the better non-empty one
+//if both are empty, every shard is checked, so -1 is only returned when the whole queue is empty
+int MultiCQueue::pickShard() const{
+    int first = randomShard();
+    int second = randomShard();
+    int firstSize = m_shards[first]->m_size.load(memory_order_relaxed);
+    int secondSize = m_shards[second]->m_size.load(memory_order_relaxed);
+
+    //if statements check which of the two shards have orders
+    if ((firstSize > 0) && (secondSize > 0)){
+        int firstTop = m_shards[first]->m_top.load(memory_order_relaxed);
+        int secondTop = m_shards[second]->m_top.load(memory_order_relaxed);
+        return (hasPriority(firstTop, secondTop) ? first : second);
+    }
+    else if (firstSize > 0){
+        return first;
+    }
+    else if (secondSize > 0){
+        return second;
+    }
+
+    //both were empty, so the best shard is found by checking them all
+    int best = -1;
+    for (int i = 0; i < int(m_shards.size()); i++){
+        if ((m_shards[i]->m_size.load(memory_order_relaxed) > 0)
+                && ((best < 0) || hasPriority(m_shards[i]->m_top.load(memory_order_relaxed), m_shards[best]->m_top.load(memory_order_relaxed)))){
+            best = i;
+        }
+    }
+    return best;
+}
+
+//hasPriority
+//returns true if priority lhs belongs above priority rhs
+bool MultiCQueue::hasPriority(int lhs, int rhs) const{
+    return ((m_heapType == MINHEAP) ? (lhs <= rhs) : (lhs >= rhs));
+}
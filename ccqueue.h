@@ -0,0 +1,138 @@
+// CMSC 341 - Spring 2023 - Project 3
+#ifndef CCQUEUE_H
+#define CCQUEUE_H
+#include "cqueue.h"
+#include <atomic>
+#include <exception>
+class ConcurrentCQueue; // forward declaration
+class MultiCQueue;      // forward declaration
+const int NUMCOMBINESLOTS = 64; // requests that can be published at once, more threads wait for a free slot
+const int COMBINEPASSES = 4;    // passes a combiner makes over the slots before handing off the lock
+const int COMBINESPINS = 64;    // checks a waiting thread makes before it yields the processor
+const int DEFAULTSHARDFACTOR = 2; // shards per thread in a MultiCQueue, the c in c*P
+const int MINSHARDS = 2;        // a MultiCQueue always has two shards to choose between
+
+enum COMBINEOP {INSERTOP, NEXTOP};
+enum SLOTSTATE {SLOTFREE, SLOTCLAIMED, SLOTPENDING, SLOTDONE};
+
+class alignas(64) CombineSlot{
+    // one published request, aligned to a cache line so threads spinning
+    // on their own slot never share a line with another thread's slot
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class ConcurrentCQueue;
+    CombineSlot() : m_state(SLOTFREE), m_op(INSERTOP), m_found(false) {}
+
+    private:
+    atomic<int> m_state; // a SLOTSTATE, handed back and forth between the owner and the combiner
+    COMBINEOP m_op;      // the request
+    Order m_order;       // the order to insert, or the order removed
+    bool m_found;        // false if a removal found the queue empty
+    exception_ptr m_error; // what the request threw in the combiner, rethrown by the owner
+};
+
+class CombinerLock{
+    // releases the combiner lock of a ConcurrentCQueue when it goes out of scope,
+    // so a request that throws while this thread combines cannot leave it held
+    public:
+    explicit CombinerLock(atomic<bool>& combining) : m_combining(combining) {}
+    ~CombinerLock() {m_combining.store(false, memory_order_release);}
+    CombinerLock(const CombinerLock& rhs) = delete;
+    CombinerLock& operator=(const CombinerLock& rhs) = delete;
+
+    private:
+    atomic<bool>& m_combining; // the lock, already taken by this thread
+};
+
+class ConcurrentCQueue{
+    // thread-safe queue built on CQueue by flat combining: every thread
+    // publishes its request in a slot, and whichever thread holds the
+    // combiner lock applies all published requests to the heap in one pass,
+    // so the heap stays in one cache and the lock changes hands once per batch;
+    // when no thread is combining, a request skips the slots and runs at once;
+    // each request takes effect while the combiner holds the lock, which
+    // makes insertOrder and getNextOrder linearizable; a request that throws
+    // in the combiner is rethrown on the thread that made it
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+
+    ConcurrentCQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure);
+    ConcurrentCQueue(const ConcurrentCQueue& rhs) = delete;
+    ConcurrentCQueue& operator=(const ConcurrentCQueue& rhs) = delete;
+    void insertOrder(const Order& order);
+    Order getNextOrder(); // Return the highest priority order, throws out_of_range if empty
+    bool tryGetNextOrder(Order& order); // Remove the highest priority order into order, false if empty
+    int numOrders() const; // Return number of orders as of the last combining pass
+    HEAPTYPE getHeapType() const;
+    STRUCTURE getStructure() const;
+
+    private:
+    CQueue m_queue;                         // the heap, only touched by the combiner
+    atomic<bool> m_combining;               // the combiner lock
+    atomic<int> m_size;                     // size of m_queue, published after each pass
+    atomic<int> m_numSlots;                 // one past the highest slot ever claimed, the combiner scans no further
+    CombineSlot m_slots[NUMCOMBINESLOTS];   // published requests
+
+    bool apply(COMBINEOP op, Order& order); //runs a request, publishing it and waiting if another thread is combining
+    bool execute(COMBINEOP op, Order& order); //applies one request to the heap, the caller must hold the combiner lock
+    int claimSlot(); //finds a free slot and claims it for this thread
+    void combine(); //applies every published request, catching what each throws, the caller must hold the combiner lock
+};
+
+class alignas(64) MultiShard{
+    // one shard of a MultiCQueue; its size and top priority are published
+    // after every change, so other threads can compare shards without the lock
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class MultiCQueue;
+    MultiShard(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure)
+        : m_locked(false), m_size(0), m_top(0), m_queue(priFn, heapType, structure) {}
+
+    private:
+    atomic<bool> m_locked; // the shard's try-lock
+    atomic<int> m_size;    // orders in m_queue as of the last unlock
+    atomic<int> m_top;     // priority of the next order of m_queue as of the last unlock
+    CQueue m_queue;        // the shard's heap, only touched while locked
+
+    bool tryLock(); //takes the lock if it is free, returns false otherwise
+    void lock(); //waits for the lock
+    void unlock(); //publishes the size and top priority, then releases the lock
+};
+
+class MultiCQueue{
+    // relaxed priority queue made of c*P independent CQueue shards: an insert
+    // goes to a random shard, and a removal takes the better top of two random
+    // shards, so threads rarely meet on a lock; the order removed is only
+    // approximately the best, and measureNextOrder reports how far off it was
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+
+    MultiCQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure, int numThreads, int shardFactor = DEFAULTSHARDFACTOR);
+    ~MultiCQueue();
+    MultiCQueue(const MultiCQueue& rhs) = delete;
+    MultiCQueue& operator=(const MultiCQueue& rhs) = delete;
+    void insertOrder(const Order& order);
+    Order getNextOrder(); // Return a high priority order, throws out_of_range if every shard is empty
+    bool tryGetNextOrder(Order& order); // Remove a high priority order into order, false if empty
+    // Remove an order the same way with every shard locked, and set rank to the
+    // number of orders in the whole queue that had a strictly higher priority
+    bool measureNextOrder(Order& order, int& rank);
+    int numOrders() const; // Return number of orders as published by the shards
+    int numShards() const; // Return number of shards
+    HEAPTYPE getHeapType() const;
+    STRUCTURE getStructure() const;
+
+    private:
+    vector<MultiShard*> m_shards; // the shards, each on its own cache lines
+    HEAPTYPE m_heapType;          // either a MINHEAP or a MAXHEAP
+    STRUCTURE m_structure;        // structure of every shard
+
+    int randomShard() const; //returns a random shard index from a per-thread generator
+    int pickShard() const; //returns the better of two random shards, -1 if every shard is empty
+    bool hasPriority(int lhs, int rhs) const; //true if priority lhs belongs above priority rhs
+};
+#endif
@@ -0,0 +1,333 @@
+// CMSC 341 - Spring 2023 - Project 3
+#include "cqingest.h"
+#include <fstream>
+#include <cstring>
+#include <cerrno>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+//overloaded constructor
+//creates an ingest for one format, a chunk is never smaller than one byte
+OrderIngest::OrderIngest(INGESTFORMAT format, int chunkSize)
+    : m_format(format), m_chunkSize((chunkSize < 1) ? 1 : chunkSize), m_numOrders(0), m_numRejected(0),
+      m_firstRejected(0), m_recordNumber(0), m_numFilled(0), m_numParsed(0), m_readDone(false), m_readFailed(false){
+    for (int i = 0; i < INGESTBUFFERS; i++){
+        m_lengths[i] = 0;
+    }
+}
+
+//ingest
+//starts the reader thread, parses each chunk as soon as it is published, then bulk builds the valid orders
+//into cqueue; if a read fails nothing is inserted
+bool OrderIngest::ingest(const string& path, CQueue& cqueue){
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0){
+        return false;
+    }
+    posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL); //the file is read once from front to back
+
+    //the orders are reserved from the file size, a CSV line is rarely shorter than 24 bytes
+    m_numOrders = 0;
+    m_numRejected = 0;
+    m_firstRejected = 0;
+    m_recordNumber = 0;
+    m_orders.clear();
+    m_carry.clear();
+    struct stat info;
+    if (fstat(file, &info) == 0){
+        m_orders.reserve(static_cast<size_t>(info.st_size) / ((m_format == BINARYFORMAT) ? BINARYORDERSIZE : 24));
+    }
+    for (int i = 0; i < INGESTBUFFERS; i++){
+        m_buffers[i].resize(m_chunkSize);
+    }
+    m_numFilled = 0;
+    m_numParsed = 0;
+    m_readDone = false;
+    m_readFailed = false;
+    thread reader(&OrderIngest::readChunks, this, file);
+
+    //while loop parses the chunks in the order they were read, until the last one
+    bool last = false;
+    while (!last){
+        int slot = 0;
+        size_t length = 0;
+        {
+            unique_lock<mutex> lock(m_lock);
+            m_wakeParser.wait(lock, [this](){ return m_numParsed < m_numFilled; });
+            slot = static_cast<int>(m_numParsed % INGESTBUFFERS);
+            length = m_lengths[slot];
+            last = m_readDone && (m_numParsed + 1 == m_numFilled);
+        }
+
+        //the chunk is parsed outside the lock while the reader fills the next one
+        parseChunk(m_buffers[slot].data(), length);
+        {
+            lock_guard<mutex> guard(m_lock);
+            ++m_numParsed;
+        }
+        m_wakeReader.notify_one();
+    }
+    reader.join();
+    close(file);
+
+    //if statement checks for a last line without a newline, or a binary record cut short
+    if (!m_carry.empty()){
+        if (m_format == CSVFORMAT){
+            parseLine(m_carry.data(), m_carry.data() + m_carry.size());
+        }
+        else{
+            ++m_recordNumber;
+            reject();
+        }
+        m_carry.clear();
+    }
+
+    bool read = !m_readFailed;
+    if (read){
+        cqueue.insertOrders(m_orders);
+        m_numOrders = static_cast<long>(m_orders.size());
+    }
+    vector<Order>().swap(m_orders); //the parsed orders are released, a nightly batch can be large
+    return read;
+}
+
+//writeBinary
+//writes each order as one fixed-width record, every integer in little-endian byte order
+bool OrderIngest::writeBinary(const string& path, const vector<Order>& orders){
+    ofstream file(path.c_str(), ios::binary | ios::trunc);
+    if (!file){
+        return false;
+    }
+    vector<unsigned char> bytes(orders.size() * BINARYORDERSIZE, 0);
+    for (size_t i = 0; i < orders.size(); i++){
+        unsigned char* record = &bytes[i * BINARYORDERSIZE];
+        record[0] = static_cast<unsigned char>(orders[i].getItem());
+        record[1] = static_cast<unsigned char>(orders[i].getCount());
+        record[2] = static_cast<unsigned char>(orders[i].getMemebership());
+        uint32_t values[3] = {static_cast<uint32_t>(orders[i].getPoints()),
+            static_cast<uint32_t>(orders[i].getCustomerID()), static_cast<uint32_t>(orders[i].getOrderID())};
+        for (int v = 0; v < 3; v++){
+            for (int b = 0; b < 4; b++){
+                record[4 + 4 * v + b] = static_cast<unsigned char>(values[v] >> (8 * b));
+            }
+        }
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    file.close();
+    return !file.fail();
+}
+
+//numOrders
+//returns the number of orders the last ingest inserted
+long OrderIngest::numOrders() const{
+    return m_numOrders;
+}
+
+//numRejected
+//returns the number of lines or records the last ingest rejected
+long OrderIngest::numRejected() const{
+    return m_numRejected;
+}
+
+//firstRejected
+//returns the number of the first line or record rejected, 0 if none was
+long OrderIngest::firstRejected() const{
+    return m_firstRejected;
+}
+
+//readChunks
+//fills each chunk in turn once the parser has handed it back, and publishes it with the number of bytes read;
+//a chunk that is not full is the last, and a failed read ends the file early
+void OrderIngest::readChunks(int file){
+    for (long chunk = 0; ; chunk++){
+        int slot = static_cast<int>(chunk % INGESTBUFFERS);
+        {
+            unique_lock<mutex> lock(m_lock);
+            m_wakeReader.wait(lock, [this](){ return m_numFilled - m_numParsed < INGESTBUFFERS; });
+        }
+
+        //the chunk is filled outside the lock, the parser does not touch it until it is published
+        vector<char>& buffer = m_buffers[slot];
+        size_t length = 0;
+        bool failed = false;
+        while (length < buffer.size()){
+            ssize_t numRead = read(file, buffer.data() + length, buffer.size() - length);
+            if ((numRead < 0) && (errno == EINTR)){
+                continue;
+            }
+            else if (numRead <= 0){
+                failed = (numRead < 0);
+                break;
+            }
+            length += static_cast<size_t>(numRead);
+        }
+
+        bool done = (length < buffer.size());
+        {
+            lock_guard<mutex> guard(m_lock);
+            m_lengths[slot] = length;
+            m_readDone = done;
+            m_readFailed = failed;
+            ++m_numFilled;
+        }
+        m_wakeParser.notify_one();
+        if (done){
+            return;
+        }
+    }
+}
+
+//parseChunk
+//finishes the line or record carried from the last chunk, parses every whole one in this chunk,
+//and carries whatever is left at the end
+void OrderIngest::parseChunk(const char* data, size_t length){
+    const char* end = data + length;
+
+    if (m_format == CSVFORMAT){
+        //if statement checks for a carried line, which is finished by the bytes up to the first newline
+        if (!m_carry.empty()){
+            const char* newline = static_cast<const char*>(memchr(data, '\n', length));
+            if (newline == nullptr){
+                m_carry.append(data, length);
+                return;
+            }
+            m_carry.append(data, newline - data);
+            parseLine(m_carry.data(), m_carry.data() + m_carry.size());
+            m_carry.clear();
+            data = newline + 1;
+        }
+
+        //while loop parses each line that ends in this chunk
+        const char* newline = static_cast<const char*>(memchr(data, '\n', end - data));
+        while (newline != nullptr){
+            parseLine(data, newline);
+            data = newline + 1;
+            newline = static_cast<const char*>(memchr(data, '\n', end - data));
+        }
+    }
+    else{
+        //if statement checks for a carried record, which is finished by the first bytes of this chunk
+        if (!m_carry.empty()){
+            size_t needed = BINARYORDERSIZE - m_carry.size();
+            if (length < needed){
+                m_carry.append(data, length);
+                return;
+            }
+            m_carry.append(data, needed);
+            parseRecord(reinterpret_cast<const unsigned char*>(m_carry.data()));
+            m_carry.clear();
+            data += needed;
+        }
+
+        //while loop parses each whole record in this chunk
+        while (end - data >= BINARYORDERSIZE){
+            parseRecord(reinterpret_cast<const unsigned char*>(data));
+            data += BINARYORDERSIZE;
+        }
+    }
+    m_carry.append(data, end - data);
+}
+
+//parseLine
+//parses the six numbers of a CSV line, each may have spaces around it; a blank line or a header is skipped,
+//and a line with a missing, extra or non-numeric field is rejected
+void OrderIngest::parseLine(const char* begin, const char* end){
+    ++m_recordNumber;
+
+    //while loop trims a carriage return and any spaces at the end
+    while ((end > begin) && ((end[-1] == '\r') || (end[-1] == ' ') || (end[-1] == '\t'))){
+        --end;
+    }
+    if ((begin == end) || ((m_recordNumber == 1) && (*begin != '-') && ((*begin < '0') || (*begin > '9')))){
+        return;
+    }
+
+    long fields[INGESTFIELDS];
+    const char* curr = begin;
+    bool valid = true;
+    for (int i = 0; (i < INGESTFIELDS) && valid; i++){
+        while ((curr < end) && ((*curr == ' ') || (*curr == '\t'))){
+            ++curr;
+        }
+        bool negative = ((curr < end) && (*curr == '-'));
+        if (negative){
+            ++curr;
+        }
+
+        //at most nine digits are taken, which is more than any field needs and cannot overflow
+        const char* digits = curr;
+        long value = 0;
+        while ((curr < end) && (*curr >= '0') && (*curr <= '9') && (curr - digits < 9)){
+            value = value * 10 + (*curr - '0');
+            ++curr;
+        }
+        valid = (curr > digits) && ((curr == end) || (*curr < '0') || (*curr > '9'));
+        fields[i] = (negative ? -value : value);
+
+        while ((curr < end) && ((*curr == ' ') || (*curr == '\t'))){
+            ++curr;
+        }
+        //each field but the last must be followed by a comma, and the last must end the line
+        if (i < INGESTFIELDS - 1){
+            valid = valid && (curr < end) && (*curr == ',');
+            ++curr;
+        }
+        else{
+            valid = valid && (curr == end);
+        }
+    }
+
+    if (valid){
+        addOrder(fields);
+    }
+    else{
+        reject();
+    }
+}
+
+//parseRecord
+//decodes one binary record, reading each integer byte by byte so the host byte order does not matter
+void OrderIngest::parseRecord(const unsigned char* bytes){
+    ++m_recordNumber;
+    long fields[INGESTFIELDS] = {bytes[0], bytes[1], bytes[2], 0, 0, 0};
+    for (int v = 0; v < 3; v++){
+        const unsigned char* value = bytes + 4 + 4 * v;
+        uint32_t word = uint32_t(value[0]) | (uint32_t(value[1]) << 8) | (uint32_t(value[2]) << 16) | (uint32_t(value[3]) << 24);
+        fields[3 + v] = static_cast<int32_t>(word);
+    }
+
+    //the zero byte must be zero, so a file of another layout is not taken for orders
+    if (bytes[3] != 0){
+        reject();
+    }
+    else{
+        addOrder(fields);
+    }
+}
+
+//addOrder
+//keeps the order if every field is in its range from cqueue.h, otherwise rejects it
+void OrderIngest::addOrder(const long fields[]){
+    bool valid = (fields[0] >= COFFEE) && (fields[0] <= ICEDTEA)
+        && (fields[1] >= ONE) && (fields[1] <= DOZEN)
+        && (fields[2] >= TIER1) && (fields[2] <= TIER6)
+        && (fields[3] >= MINPOINTS) && (fields[3] <= MAXPOINTS)
+        && (fields[4] >= MINCUSTID) && (fields[4] <= MAXCUSTID)
+        && (fields[5] >= MINORDERID) && (fields[5] <= MAXORDERID);
+    if (!valid){
+        reject();
+        return;
+    }
+    m_orders.push_back(Order(static_cast<ITEM>(fields[0]), static_cast<COUNT>(fields[1]), static_cast<MEMBERSHIP>(fields[2]),
+                static_cast<int>(fields[3]), static_cast<int>(fields[4]), static_cast<int>(fields[5])));
+}
+
+//reject
+//counts a rejected line or record, remembering the first
+void OrderIngest::reject(){
+    ++m_numRejected;
+    if (m_firstRejected == 0){
+        m_firstRejected = m_recordNumber;
+    }
+}
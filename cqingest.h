@@ -0,0 +1,68 @@
+// CMSC 341 - Spring 2023 - Project 3
+#ifndef CQINGEST_H
+#define CQINGEST_H
+#include "cqueue.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+const int INGESTCHUNK = 1 << 20; // bytes the reader thread reads at a time
+const int INGESTBUFFERS = 3;     // chunks in flight, so the reader fills one while another is parsed
+const int INGESTFIELDS = 6;      // fields of an order in either format
+// a binary order is item, count and membership as one byte each, a zero byte, then points,
+// customer ID and order ID as little-endian 32-bit integers
+const int BINARYORDERSIZE = 16;
+
+enum INGESTFORMAT {CSVFORMAT, BINARYFORMAT};
+
+class OrderIngest{
+    // reads orders from a CSV or fixed-width binary file into a CQueue; a
+    // reader thread reads the file in chunks while the calling thread parses
+    // the chunk before it, every field is checked against the ranges in
+    // cqueue.h, and the valid orders go into the queue with one bulk build;
+    // a CSV line is item,count,membership,points,customerID,orderID with each
+    // enum as its number, and a first line that does not start with a digit
+    // is taken as a header
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+
+    explicit OrderIngest(INGESTFORMAT format, int chunkSize = INGESTCHUNK);
+    OrderIngest(const OrderIngest& rhs) = delete;
+    OrderIngest& operator=(const OrderIngest& rhs) = delete;
+    // Insert every valid order of the file into cqueue, return false and leave cqueue alone if it cannot be read
+    bool ingest(const string& path, CQueue& cqueue);
+    // Write the orders to path in the binary format, return false if it cannot be written
+    static bool writeBinary(const string& path, const vector<Order>& orders);
+    long numOrders() const; // Return number of orders the last ingest inserted
+    long numRejected() const; // Return number of lines or records the last ingest rejected
+    long firstRejected() const; // Return the line or record number, from 1, of the first rejected, 0 if none
+
+    private:
+    INGESTFORMAT m_format;  // format of the files read
+    int m_chunkSize;        // bytes in each chunk
+    long m_numOrders;       // orders inserted by the last ingest
+    long m_numRejected;     // lines or records rejected by the last ingest
+    long m_firstRejected;   // number of the first rejected line or record
+    long m_recordNumber;    // lines or records parsed so far
+    vector<Order> m_orders; // valid orders parsed so far
+    string m_carry;         // the start of a line or record cut off at the end of a chunk
+
+    //shared between the reader thread and the parser
+    vector<char> m_buffers[INGESTBUFFERS]; // chunks, filled and parsed in turn
+    size_t m_lengths[INGESTBUFFERS];       // bytes read into each chunk
+    long m_numFilled;       // chunks the reader has published
+    long m_numParsed;       // chunks the parser has handed back
+    bool m_readDone;        // true once the last chunk is published
+    bool m_readFailed;      // true if a read failed
+    mutex m_lock;                     // guards the counts and flags
+    condition_variable m_wakeReader;  // signalled when a chunk is handed back
+    condition_variable m_wakeParser;  // signalled when a chunk is published
+
+    void readChunks(int file); //the reader thread, fills each free chunk in turn until the file ends
+    void parseChunk(const char* data, size_t length); //parses every whole line or record, carrying the rest
+    void parseLine(const char* begin, const char* end); //parses one CSV line
+    void parseRecord(const unsigned char* bytes); //parses one binary record
+    void addOrder(const long fields[]); //checks the ranges, then keeps the order or rejects it
+    void reject(); //counts a rejected line or record
+};
+#endif
@@ -0,0 +1,472 @@
+// CMSC 341 - Spring 2023 - Project 3
+#include "cqlog.h"
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+//overloaded constructor
+//opens the log for appending and starts the flusher, a log that cannot be opened reports every sync as failed
+OrderLog::OrderLog(const string& path, const vector<prifn_t>& priFns, int commitMicros)
+    : m_path(path), m_priFns(priFns), m_commitMicros((commitMicros < 0) ? 0 : commitMicros),
+      m_appended(0), m_batched(0), m_committed(0), m_commits(0),
+      m_syncRequested(false), m_stopping(false), m_failed(false){
+    m_file = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    m_failed = (m_file < 0);
+    m_flusher = thread(&OrderLog::flush, this);
+}
+
+//destructor
+//the flusher commits whatever is waiting before it stops
+OrderLog::~OrderLog(){
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_stopping = true;
+    }
+    m_wakeFlusher.notify_one();
+    m_flusher.join();
+    if (m_file >= 0){
+        close(m_file);
+    }
+}
+
+//sync
+//asks the flusher to commit at once, then waits until every record appended so far is durable
+bool OrderLog::sync(){
+    unique_lock<mutex> lock(m_lock);
+    long target = m_appended;
+    if (m_committed < target){
+        m_syncRequested = true;
+        m_wakeFlusher.notify_one();
+        m_wakeWaiters.wait(lock, [this, target](){ return m_committed >= target; });
+    }
+    return !m_failed;
+}
+
+//checkpoint
+//writes a new log holding only the priority function and a snapshot of cqueue, then renames it over the
+//old log, so a crash at any point leaves one whole log or the other and nothing is ever replayed twice
+bool OrderLog::checkpoint(const CQueue& cqueue){
+    int index = priorityIndex(cqueue.m_priorFunc);
+    if (index < 0){
+        throw invalid_argument("Invalid argument");
+    }
+
+    //every record appended so far is committed first, so no write to the old log is in flight
+    sync();
+
+    vector<char> image;
+    int32_t policy[2] = {index, static_cast<int32_t>(cqueue.m_heapType)};
+    encode(image, LOGPRIORITY, reinterpret_cast<const char*>(policy), sizeof(policy));
+    ostringstream snapshot;
+    cqueue.writeSnapshot(snapshot);
+    string bytes = snapshot.str();
+    encode(image, LOGSNAPSHOT, bytes.data(), bytes.size());
+
+    //the new log is written and synced beside the old one, then renamed over it
+    string tempPath = m_path + ".tmp";
+    int file = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool written = (file >= 0) && writeAll(file, image.data(), image.size()) && (fsync(file) == 0)
+        && (rename(tempPath.c_str(), m_path.c_str()) == 0);
+    if (!written){
+        if (file >= 0){
+            close(file);
+        }
+        unlink(tempPath.c_str());
+        lock_guard<mutex> guard(m_lock);
+        m_failed = true;
+        return false;
+    }
+
+    //the directory is synced so the rename itself survives a crash
+    size_t slash = m_path.find_last_of('/');
+    string directory = ((slash == string::npos) ? string(".") : m_path.substr(0, slash + 1));
+    int dirFile = open(directory.c_str(), O_RDONLY);
+    if (dirFile >= 0){
+        fsync(dirFile);
+        close(dirFile);
+    }
+
+    //the flusher is idle, so the new log takes the place of the old one under the lock
+    lock_guard<mutex> guard(m_lock);
+    if (m_file >= 0){
+        close(m_file);
+    }
+    m_file = file;
+    m_failed = false; //everything the queue holds is durable again
+    return true;
+}
+
+//recover
+//maps the log read-only, loads its snapshot in place and replays each later record into cqueue,
+//stopping at the first record that is incomplete or fails its checksum, which is cut off the file
+bool OrderLog::recover(CQueue& cqueue, const string& path, const vector<prifn_t>& priFns){
+    int file = open(path.c_str(), O_RDWR);
+    if (file < 0){
+        return false;
+    }
+    struct stat info;
+    if (fstat(file, &info) != 0){
+        close(file);
+        return false;
+    }
+    size_t length = static_cast<size_t>(info.st_size);
+    const char* data = nullptr;
+    if (length > 0){
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapped == MAP_FAILED){
+            close(file);
+            return false;
+        }
+        madvise(mapped, length, MADV_SEQUENTIAL); //the records are read once from front to back
+        data = static_cast<const char*>(mapped);
+    }
+
+    //the queue is detached from any log until this returns or throws, so the replay is not logged again
+    LogPause pause(cqueue.m_log);
+    cqueue.clear();
+
+    size_t offset = 0; //end of the last record applied
+    bool applied = true;
+    try{
+        //while loop applies each whole record until the log ends or a record cannot be applied
+        while (applied && (length - offset >= sizeof(LogRecord))){
+            const LogRecord* record = reinterpret_cast<const LogRecord*>(data + offset);
+            const char* payload = data + offset + sizeof(LogRecord);
+            size_t padded = (static_cast<size_t>(record->m_length) + LOGALIGN - 1) / LOGALIGN * LOGALIGN;
+
+            //if statement checks for a torn record, which ends the log
+            if ((record->m_op < LOGINSERT) || (record->m_op > LOGUPDATE)
+                    || (padded > length - offset - sizeof(LogRecord))
+                    || (checksum(payload, record->m_length) != record->m_checksum)){
+                break;
+            }
+            applied = apply(cqueue, static_cast<LOGOP>(record->m_op), payload, record->m_length, priFns);
+            if (applied){
+                offset += sizeof(LogRecord) + padded;
+            }
+        }
+    }
+    catch (...){
+        //whatever a replayed operation throws, the mapping and the file are released before it is passed on
+        if (data != nullptr){
+            munmap(const_cast<char*>(data), length);
+        }
+        close(file);
+        throw;
+    }
+
+    //if statement checks for a torn tail, which is cut off so new records follow the last whole one
+    if (applied && (offset < length)){
+        applied = (ftruncate(file, static_cast<off_t>(offset)) == 0);
+    }
+    if (data != nullptr){
+        munmap(const_cast<char*>(data), length);
+    }
+    close(file);
+    return applied;
+}
+
+//getCommitMicros
+//returns the longest a record waits before it is committed
+int OrderLog::getCommitMicros() const{
+    return m_commitMicros;
+}
+
+//numCommits
+//returns the number of write and fsync pairs so far
+long OrderLog::numCommits() const{
+    lock_guard<mutex> guard(m_lock);
+    return m_commits;
+}
+
+//hasFailed
+//returns true if any write or sync failed since the last checkpoint
+bool OrderLog::hasFailed() const{
+    lock_guard<mutex> guard(m_lock);
+    return m_failed;
+}
+
+//append
+//adds a record to the batch; the first record of a batch starts its interval and wakes the flusher,
+//and with no interval the caller waits for its own commit
+void OrderLog::append(LOGOP op, const char* data, size_t length){
+    {
+        lock_guard<mutex> guard(m_lock);
+        size_t oldSize = m_batch.size();
+        if (m_batched == 0){
+            m_batchStart = chrono::steady_clock::now();
+            m_wakeFlusher.notify_one();
+        }
+        encode(m_batch, op, data, length);
+        ++m_appended;
+        ++m_batched;
+
+        //if statement checks if the batch just filled, it is committed without waiting out the interval
+        if ((oldSize < static_cast<size_t>(MAXLOGBATCH)) && (m_batch.size() >= static_cast<size_t>(MAXLOGBATCH))){
+            m_wakeFlusher.notify_one();
+        }
+    }
+    if (m_commitMicros == 0){
+        sync();
+    }
+}
+
+//logInsert
+//logs the order given to insertOrder
+void OrderLog::logInsert(const Order& order){
+    append(LOGINSERT, reinterpret_cast<const char*>(&order), sizeof(Order));
+}
+
+//logInserts
+//logs the orders given to insertOrders as one record
+void OrderLog::logInserts(const vector<Order>& orders){
+    append(LOGINSERTS, reinterpret_cast<const char*>(orders.data()), orders.size() * sizeof(Order));
+}
+
+//logNext
+//logs count removals of the highest priority order, the orders themselves follow from the queue
+void OrderLog::logNext(int count){
+    int32_t value = count;
+    append(LOGNEXT, reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+//logMerge
+//logs mergeWithQueue with a snapshot of rhs, so the replay merges a heap of exactly the same shape
+void OrderLog::logMerge(const CQueue& rhs){
+    ostringstream snapshot;
+    rhs.writeSnapshot(snapshot);
+    string bytes = snapshot.str();
+    append(LOGMERGE, bytes.data(), bytes.size());
+}
+
+//logClear
+//logs that every order was removed at once, the record has no payload
+void OrderLog::logClear(){
+    append(LOGCLEAR, nullptr, 0);
+}
+
+//logCancel
+//logs the whole order a cancelOrder removed, so the replay removes the same one even where
+//several orders share its ID and the replay has no index, or another one
+void OrderLog::logCancel(const Order& order){
+    append(LOGCANCEL, reinterpret_cast<const char*>(&order), sizeof(order));
+}
+
+//logUpdate
+//logs updateOrder as the order the handle held followed by the new order, a handle cannot be logged
+//so the replay finds the node holding the old order
+void OrderLog::logUpdate(const Order& oldOrder, const Order& order){
+    Order orders[2] = {oldOrder, order};
+    append(LOGUPDATE, reinterpret_cast<const char*>(orders), sizeof(orders));
+}
+
+//logSnapshot
+//logs a snapshot of cqueue, for a change that replaces the orders or the layout all at once
+void OrderLog::logSnapshot(const CQueue& cqueue){
+    ostringstream snapshot;
+    cqueue.writeSnapshot(snapshot);
+    string bytes = snapshot.str();
+    append(LOGSNAPSHOT, bytes.data(), bytes.size());
+}
+
+//logPriorityFn
+//logs setPriorityFn by the position of the function in m_priFns
+//an invalid argument error is thrown if it is not there, before anything is logged
+void OrderLog::logPriorityFn(prifn_t priFn, HEAPTYPE heapType){
+    int index = priorityIndex(priFn);
+    if (index < 0){
+        throw invalid_argument("Invalid argument");
+    }
+    int32_t policy[2] = {index, static_cast<int32_t>(heapType)};
+    append(LOGPRIORITY, reinterpret_cast<const char*>(policy), sizeof(policy));
+}
+
+//priorityIndex
+//returns the position of priFn in m_priFns, or -1 if it is not there
+int OrderLog::priorityIndex(prifn_t priFn) const{
+    for (unsigned int i = 0; i < m_priFns.size(); i++){
+        if (m_priFns[i] == priFn){
+            return int(i);
+        }
+    }
+    return -1;
+}
+
+//flush
+//the flusher loop; each batch is taken once its interval is up, it fills, a caller waits or the log closes,
+//then written and synced outside the lock while the queue keeps appending to a fresh batch
+void OrderLog::flush(){
+    unique_lock<mutex> lock(m_lock);
+    while (true){
+        //waits for the first record of a batch, the flusher only stops once nothing is left
+        m_wakeFlusher.wait(lock, [this](){ return (m_batched > 0) || m_stopping; });
+        if (m_batched == 0){
+            return;
+        }
+        m_wakeFlusher.wait_until(lock, m_batchStart + chrono::microseconds(m_commitMicros), [this](){
+            return m_syncRequested || m_stopping || (m_batch.size() >= static_cast<size_t>(MAXLOGBATCH));
+        });
+
+        //the batch is taken, the buffers are swapped so both keep their capacity
+        m_writing.swap(m_batch);
+        long records = m_batched;
+        m_batched = 0;
+        m_syncRequested = false;
+        int file = m_file;
+        lock.unlock();
+
+        bool written = writeAll(file, m_writing.data(), m_writing.size()) && (fdatasync(file) == 0);
+        m_writing.clear();
+
+        lock.lock();
+        m_failed = m_failed || !written;
+        m_committed += records;
+        ++m_commits;
+        m_wakeWaiters.notify_all();
+    }
+}
+
+//encode
+//appends a record header, the payload and zero padding up to the next 8-byte boundary
+void OrderLog::encode(vector<char>& out, LOGOP op, const char* data, size_t length){
+    LogRecord record = LogRecord();
+    record.m_op = op;
+    record.m_length = static_cast<uint32_t>(length);
+    record.m_checksum = checksum(data, length);
+
+    size_t start = out.size();
+    size_t padded = (length + LOGALIGN - 1) / LOGALIGN * LOGALIGN;
+    out.resize(start + sizeof(LogRecord) + padded); //the new bytes are zeroed, which covers the padding
+    memcpy(&out[start], &record, sizeof(LogRecord));
+    if (length > 0){
+        memcpy(&out[start + sizeof(LogRecord)], data, length);
+    }
+}
+
+//checksum
+//returns the 32-bit FNV-1a hash of the payload
+uint32_t OrderLog::checksum(const char* data, size_t length){
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++){
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//writeAll
+//writes every byte, retrying short and interrupted writes, returns false on any other error
+bool OrderLog::writeAll(int file, const char* data, size_t length){
+    while (length > 0){
+        ssize_t written = write(file, data, length);
+        if (written < 0){
+            if (errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+//apply
+//applies one record to cqueue the same way the logged operation changed it
+//returns false if the payload does not fit the operation or the queue cannot take it
+bool OrderLog::apply(CQueue& cqueue, LOGOP op, const char* data, size_t length, const vector<prifn_t>& priFns){
+    switch (op){
+    case LOGINSERT:
+        if (length != sizeof(Order)){
+            return false;
+        }
+        cqueue.insertOrder(*reinterpret_cast<const Order*>(data));
+        return true;
+    case LOGINSERTS:
+        if (length % sizeof(Order) != 0){
+            return false;
+        }
+        cqueue.insertOrders(reinterpret_cast<const Order*>(data), reinterpret_cast<const Order*>(data + length));
+        return true;
+    case LOGNEXT:{
+        int32_t count = 0;
+        if (length != sizeof(count)){
+            return false;
+        }
+        memcpy(&count, data, sizeof(count));
+        if ((count < 0) || (count > cqueue.numOrders())){
+            return false;
+        }
+        for (int i = 0; i < count; i++){
+            cqueue.getNextOrder();
+        }
+        return true;
+    }
+    case LOGMERGE:{
+        CQueue rhs(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        if (!rhs.loadImage(data, length)){
+            return false;
+        }
+        cqueue.mergeWithQueue(rhs);
+        return true;
+    }
+    case LOGPRIORITY:{
+        int32_t policy[2] = {0, 0};
+        if (length != sizeof(policy)){
+            return false;
+        }
+        memcpy(policy, data, sizeof(policy));
+        if ((policy[0] < 0) || (policy[0] >= int(priFns.size())) || ((policy[1] != MINHEAP) && (policy[1] != MAXHEAP))){
+            return false;
+        }
+        cqueue.setPriorityFn(priFns[policy[0]], static_cast<HEAPTYPE>(policy[1]));
+        return true;
+    }
+    case LOGSNAPSHOT:{
+        //a snapshot replaces every order, so the queue first takes the structure it was written from,
+        //which is how a change of structure is replayed
+        if (length >= sizeof(SnapshotHeader)){
+            int32_t structure = reinterpret_cast<const SnapshotHeader*>(data)->m_structure;
+            if ((structure >= SKEW) && (structure <= PAIRING) && (structure != cqueue.m_structure)){
+                cqueue.clear();
+                cqueue.setStructure(static_cast<STRUCTURE>(structure));
+            }
+        }
+        return cqueue.loadImage(data, length);
+    }
+    case LOGCLEAR:
+        if (length != 0){
+            return false;
+        }
+        cqueue.clear();
+        return true;
+    case LOGCANCEL:{
+        if (length != sizeof(Order)){
+            return false;
+        }
+        Order order;
+        memcpy(&order, data, sizeof(order));
+        return cqueue.removeOrder(order.getOrderID(), &order);
+    }
+    case LOGUPDATE:{
+        if (length != 2 * sizeof(Order)){
+            return false;
+        }
+        Order orders[2];
+        memcpy(orders, data, sizeof(orders));
+        Node* node = cqueue.findOrder(orders[0]);
+        if (node == nullptr){
+            return false;
+        }
+        cqueue.updateOrder(OrderHandle(node), orders[1]);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
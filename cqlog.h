@@ -0,0 +1,101 @@
+// CMSC 341 - Spring 2023 - Project 3
+#ifndef CQLOG_H
+#define CQLOG_H
+#include "cqueue.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+const int DEFAULTCOMMITMICROS = 1000; // longest a logged operation waits in memory before its batch is committed
+const int MAXLOGBATCH = 1 << 20;      // bytes that commit a batch without waiting out the interval
+const int LOGALIGN = 8;               // every record starts on an 8-byte boundary, so a payload can be read in place
+
+// starts at one, so a zeroed tail left behind by a crash never reads as a record
+enum LOGOP {LOGINSERT = 1, LOGINSERTS, LOGNEXT, LOGMERGE, LOGPRIORITY, LOGSNAPSHOT, LOGCLEAR, LOGCANCEL, LOGUPDATE};
+
+class LogRecord{
+    // written in front of every payload of an OrderLog file
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class OrderLog;
+
+    private:
+    uint32_t m_op;       // a LOGOP
+    uint32_t m_length;   // bytes of payload that follow, not counting the padding
+    uint32_t m_checksum; // checksum of the payload, a torn write at the end of the log fails it
+    uint32_t m_unused;   // padding, written as zero
+};
+static_assert(sizeof(LogRecord) % LOGALIGN == 0, "LogRecord must keep the payload aligned");
+
+class OrderLog{
+    // append-only write-ahead log for one CQueue; records from many operations
+    // are gathered in memory, and a flusher thread commits each batch with one
+    // write and one fsync (group commit) at most commitMicros after its first
+    // record, so a crash loses at most one interval of work; a commit interval
+    // of zero makes every operation wait for its own commit; the log always
+    // starts with a snapshot of the queue, and checkpoint swaps in a fresh one,
+    // so recovery is one snapshot load followed by a replay of the operations
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class CQueue;
+
+    // Open the log at path for appending; priFns lists every priority function the queue
+    // may be given, since only the position of a function in priFns can be logged
+    OrderLog(const string& path, const vector<prifn_t>& priFns, int commitMicros = DEFAULTCOMMITMICROS);
+    ~OrderLog(); // Commit every waiting record, then stop the flusher
+    OrderLog(const OrderLog& rhs) = delete;
+    OrderLog& operator=(const OrderLog& rhs) = delete;
+    bool sync(); // Commit every record appended so far and wait for it, false if any write failed
+    // Replace the log with a snapshot of cqueue, false if it cannot be written;
+    // an invalid argument error is thrown if the priority function of cqueue is not in priFns
+    bool checkpoint(const CQueue& cqueue);
+    // Replace the orders of cqueue with the snapshot in the log at path and replay the operations
+    // logged after it; a torn record at the end is cut off, and false is returned if the log cannot
+    // be read or a record cannot be applied; cqueue takes the policy and layout of the log, but must
+    // have the lazy merging it was logged with
+    static bool recover(CQueue& cqueue, const string& path, const vector<prifn_t>& priFns);
+    int getCommitMicros() const;
+    long numCommits() const; // Return number of write and fsync pairs so far
+    bool hasFailed() const; // Return true if any write or sync failed
+
+    private:
+    string m_path;            // path of the log file
+    vector<prifn_t> m_priFns; // priority functions that can be logged, by position
+    int m_commitMicros;       // longest a record waits before it is committed
+    int m_file;               // descriptor of the log file, only written by the flusher
+    vector<char> m_batch;     // records appended since the flusher last took a batch
+    vector<char> m_writing;   // the batch being committed, only touched by the flusher
+    chrono::steady_clock::time_point m_batchStart; // when the first record of m_batch was appended
+    long m_appended;          // records appended
+    long m_batched;           // records in m_batch
+    long m_committed;         // records written and synced
+    long m_commits;           // write and fsync pairs
+    bool m_syncRequested;     // true if a caller is waiting for the batch
+    bool m_stopping;          // true once the log is closing
+    bool m_failed;            // true if a write or sync failed
+    mutable mutex m_lock;              // guards everything the flusher shares with the queue
+    condition_variable m_wakeFlusher;  // signalled when a batch starts, fills, or is waited for
+    condition_variable m_wakeWaiters;  // signalled after each commit
+    thread m_flusher;                  // commits the batches
+
+    void append(LOGOP op, const char* data, size_t length); //adds a record to the batch
+    void logInsert(const Order& order); //logs insertOrder
+    void logInserts(const vector<Order>& orders); //logs insertOrders
+    void logNext(int count); //logs count removals of the highest priority order
+    void logMerge(const CQueue& rhs); //logs mergeWithQueue with a snapshot of rhs
+    void logClear(); //logs that every order was removed, as by clear or a merge into another queue
+    void logCancel(const Order& order); //logs cancelOrder by the order it removed
+    void logUpdate(const Order& oldOrder, const Order& order); //logs updateOrder by the order the handle held
+    void logSnapshot(const CQueue& cqueue); //logs every order and the layout of cqueue, replacing what it held
+    void logPriorityFn(prifn_t priFn, HEAPTYPE heapType); //logs setPriorityFn, throws if priFn cannot be named
+    int priorityIndex(prifn_t priFn) const; //position of priFn in m_priFns, -1 if it is not there
+    void flush(); //the flusher loop, commits each batch once it is due
+    static void encode(vector<char>& out, LOGOP op, const char* data, size_t length); //appends one record to out
+    static uint32_t checksum(const char* data, size_t length); //FNV-1a checksum of a payload
+    static bool writeAll(int file, const char* data, size_t length); //writes every byte, retrying short writes
+    // applies one record to cqueue, false if it cannot be applied
+    static bool apply(CQueue& cqueue, LOGOP op, const char* data, size_t length, const vector<prifn_t>& priFns);
+};
+#endif
@@ -1,29 +1,61 @@
 // CMSC 341 - Spring 2023 - Project 3
 #include "cqueue.h"
+#include "cqlog.h"
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 //overloaded constructor
 //creates an empty cqueue object
-CQueue::CQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure){
+CQueue::CQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure, int arity){
   m_heap = nullptr;
   m_size = 0;
   m_priorFunc = priFn;
 
   //if statement checks to ensure that the data sent is valid or else defaults to skewed minheap
   m_heapType = ((heapType == MINHEAP) || (heapType = MAXHEAP)) ? heapType: MINHEAP;
-  m_structure = ((structure == SKEW) || (structure == LEFTIST)) ? structure: SKEW;
+  m_structure = ((structure == SKEW) || (structure == LEFTIST) || (structure == DARY) || (structure == PAIRING)) ? structure: SKEW;
+  m_arity = ((arity == 2) || (arity == 4) || (arity == 8)) ? arity: DEFAULTARITY;
+  m_bucketMode = false; //orders start in the structure until a priority range is declared
+  m_lazyMerge = false; //mergeWithQueue melds at once unless lazy merging is turned on
+  m_indexed = false; //cancelOrder searches for its order unless the index is turned on
+  m_log = nullptr; //nothing is logged until a log is attached
 }
 
 //destructor
 //clears the function to delete everything, then sets all variables to the default
 CQueue::~CQueue(){
-    clear(); //clear called
+    releaseAll(); //every node returned, a queue going away is not logged
 }
 
 //clear
-//clears the function and sets m_heap to nullptr
+//empties the queue, logging it first if there is a log
 void CQueue::clear(){
-    recursiveClear(m_heap); //recursiveClear called starting with the heap
+    if (m_log != nullptr){
+        m_log->logClear();
+    }
+    releaseAll();
+}
+
+//releaseAll
+//returns every node to the pool and sets m_heap to nullptr, without logging it
+void CQueue::releaseAll(){
+    m_pool.releaseTree(m_heap); //every node returned to the pool starting with the heap
     m_heap = nullptr; //m_heap set to nullptr since only dynamically allocated data
+    m_pool.releaseTree(m_buckets.takeAll()); //the buckets are emptied, bucket mode itself is kept
+
+    //every pending heap is released as well
+    for (unsigned int i = 0; i < m_pending.size(); i++){
+        m_pool.releaseTree(m_pending[i]);
+    }
+    m_pending.clear();
+    m_array.clear(); //the array keeps its capacity for reuse
+    m_index.clear(); //the index is emptied, but kept on if it was
     m_size = 0; //size set to zero
 }
 
@@ -32,6 +64,11 @@ CQueue::CQueue(const CQueue& rhs){
     //m_heap set to nullptr and m_size set to zero
     m_heap = nullptr;
     m_size = 0;
+    m_arity = DEFAULTARITY;
+    m_bucketMode = false;
+    m_lazyMerge = false;
+    m_indexed = false;
+    m_log = nullptr; //a copy is never logged, the log stays with rhs
     *this = rhs; //this is set equal to rhs
 }
 
@@ -40,38 +77,197 @@ CQueue::CQueue(const CQueue& rhs){
 CQueue& CQueue::operator=(const CQueue& rhs) {
     //if statement checks to ensure that no self assignment is occuring
     if (this != &rhs){
-        clear(); //clear called
+        //the policy of rhs is logged first, which throws before anything changes if the log cannot name it
+        if (m_log != nullptr){
+            m_log->logPriorityFn(rhs.m_priorFunc, rhs.m_heapType);
+        }
+        releaseAll(); //every node returned, the copy below is logged as a whole
         
         //member variables set to member variables of left side
         m_priorFunc = rhs.m_priorFunc;
         m_heapType = rhs.m_heapType;
         m_structure = rhs.m_structure;
         m_size = rhs.m_size;
+        m_arity = rhs.m_arity;
+        m_array = rhs.m_array; //a DARY heap is copied with the array
+        m_bucketMode = rhs.m_bucketMode;
+        m_lazyMerge = rhs.m_lazyMerge;
+        m_indexed = rhs.m_indexed;
 
-        //if statement checks to see if m_heap equals nullptr, then returns
-        if (rhs.m_heap == nullptr){
-            return *this;
+        //every pending heap is copied into this pool
+        for (unsigned int i = 0; i < rhs.m_pending.size(); i++){
+            m_pending.push_back(m_pool.copyTree(rhs.m_pending[i]));
         }
-        //else, preOrderAssignment called with the rhs m_heap
-        else{
-            m_heap = preOrderAssignment(rhs.m_heap);
+
+        //if statement checks for bucket mode, each bucket is copied front to back so FIFO order is kept
+        if (rhs.m_bucketMode){
+            m_buckets.setRange(rhs.m_buckets.getMinPriority(), rhs.m_buckets.getMaxPriority());
+            for (int i = 0; i < int(rhs.m_buckets.m_heads.size()); i++){
+                for (const Node* curr = rhs.m_buckets.m_heads[i]; curr != nullptr; curr = curr->m_right){
+                    m_buckets.push(m_pool.acquire(curr->m_order, curr->m_priority));
+                }
+            }
+        }
+        //else if rhs m_heap is not nullptr, it is copied into this pool using preorder traversal
+        else if (rhs.m_heap != nullptr){
+            m_heap = m_pool.copyTree(rhs.m_heap);
+        }
+
+        //the copied nodes are indexed if rhs kept an index, then the copy is logged
+        rebuildIndex();
+        logSnapshot();
+    }
+
+    return *this; //this returned
+}
+
+//move constructor
+//takes over the heap of rhs in constant time, nothing is logged so nothing can throw
+CQueue::CQueue(CQueue&& rhs) noexcept{
+    //m_heap set to nullptr and m_size set to zero
+    m_heap = nullptr;
+    m_size = 0;
+    m_arity = DEFAULTARITY;
+    m_bucketMode = false;
+    m_lazyMerge = false;
+    m_indexed = false;
+    m_log = nullptr; //the log of rhs, if any, is taken over with its orders
+    takeOver(rhs); //this takes over rhs
+}
+
+//move assignment operator
+//takes over the root, size, policy, pool and log of rhs, leaving rhs empty and unlogged
+//the log of this queue may throw while recording that its orders were dropped, before anything changes
+CQueue& CQueue::operator=(CQueue&& rhs) {
+    //if statement checks to ensure that no self assignment is occuring
+    if (this != &rhs){
+        //the log follows the orders it describes; a log of this queue records that its orders were dropped,
+        //so recovering it gives back the empty queue rather than orders this queue no longer holds
+        if ((m_log != nullptr) && (m_log != rhs.m_log)){
+            m_log->logClear();
         }
+        takeOver(rhs);
     }
 
     return *this; //this returned
 }
 
+//takeOver
+//returns every node of this queue, then takes over the root, size, policy, pool and log of rhs
+//leaving rhs empty and unlogged; nothing is logged, so a move cannot throw
+void CQueue::takeOver(CQueue& rhs) noexcept{
+    m_log = rhs.m_log;
+    rhs.m_log = nullptr;
+
+    releaseAll(); //every node returned, the old nodes stay in this pool and go to rhs with it
+
+    //member variables set to member variables of rhs
+    m_priorFunc = rhs.m_priorFunc;
+    m_heapType = rhs.m_heapType;
+    m_structure = rhs.m_structure;
+    m_heap = rhs.m_heap;
+    m_size = rhs.m_size;
+    m_arity = rhs.m_arity;
+    m_bucketMode = rhs.m_bucketMode;
+    m_lazyMerge = rhs.m_lazyMerge;
+    m_indexed = rhs.m_indexed;
+
+    //the pools, arrays, buckets, pending heaps and indexes are swapped, since the nodes of rhs live in its slabs
+    m_pool.swap(rhs.m_pool);
+    m_array.swap(rhs.m_array);
+    m_buckets.swap(rhs.m_buckets);
+    m_pending.swap(rhs.m_pending);
+    m_index.swap(rhs.m_index);
+
+    //rhs's m_heap set to nullptr and size set to zero
+    rhs.m_heap = nullptr;
+    rhs.m_size = 0;
+    rhs.m_bucketMode = false;
+}
+
 //mergeWithQueue
 //the rhs CQueue object is merged with the lhs CQueue object, and rhs is left empty
 void CQueue::mergeWithQueue(CQueue& rhs) {
+    CQUEUE_STAT(LatencyTimer timer(m_stats.m_mergeLatency);)
     //if statement checks to ensure that the type and structure match up
     if ((rhs.m_heapType != m_heapType) || (rhs.m_structure != m_structure)){
         throw domain_error("Domain error");
     }
     else{
-        if (this != &rhs){
-            //merges the lhs's m_heap with the rhs's m_heap
-            m_heap = merge(m_heap, rhs.m_heap); //merge called
+        //if statement checks for a log, rhs is logged as it is now, so a replay merges the same shape
+        if ((m_log != nullptr) && (this != &rhs)){
+            m_log->logMerge(rhs);
+        }
+        //if statement checks for a log of rhs, which records that rhs is left empty, so recovering it
+        //does not bring back the orders that now belong to this queue
+        if ((rhs.m_log != nullptr) && (this != &rhs)){
+            rhs.m_log->logClear();
+        }
+
+        //if statement checks for bucket mode, the orders of rhs are added to the buckets
+        if ((this != &rhs) && m_bucketMode){
+            //matching ranges are concatenated bucket by bucket, otherwise every order of rhs is detached
+            //the nodes of rhs are indexed before they move, or once they are all in the detached list
+            Node* list = nullptr;
+            if (rhs.m_bucketMode && (rhs.m_buckets.getMinPriority() == m_buckets.getMinPriority())
+                    && (rhs.m_buckets.getMaxPriority() == m_buckets.getMaxPriority())){
+                indexQueue(rhs);
+                m_buckets.append(rhs.m_buckets);
+            }
+            else{
+                list = (rhs.m_bucketMode ? rhs.m_buckets.takeAll() : rhs.takeList());
+                indexTree(list);
+            }
+
+            //the nodes of rhs now belong to this queue, so their slabs are taken over as well
+            m_pool.adopt(rhs.m_pool);
+            m_size += rhs.m_size;
+            rhs.m_size = 0;
+            rhs.m_index.clear();
+            fillBuckets(list);
+            return;
+        }
+        //else if only rhs is in bucket mode, its orders are put back into its structure first
+        else if ((this != &rhs) && rhs.m_bucketMode){
+            rhs.leaveBucketMode();
+        }
+
+        //if statement checks for a queue of nodes, the nodes of rhs are indexed before they move
+        if ((this != &rhs) && (m_structure != DARY)){
+            indexQueue(rhs);
+            rhs.m_index.clear();
+        }
+
+        //if statement checks for lazy merging, the heap of rhs and its pending heaps are only recorded
+        //the melding is paid down by later removals, so the merge never walks a spine
+        if ((this != &rhs) && m_lazyMerge && (m_structure != DARY)){
+            if (rhs.m_heap != nullptr){
+                m_pending.push_back(rhs.m_heap);
+            }
+            m_pending.insert(m_pending.end(), rhs.m_pending.begin(), rhs.m_pending.end());
+            rhs.m_pending.clear();
+            m_pool.adopt(rhs.m_pool);
+            m_size += rhs.m_size;
+            rhs.m_heap = nullptr;
+            rhs.m_size = 0;
+            return;
+        }
+        //else if rhs has pending heaps of its own, they are melded before the merge
+        else if ((this != &rhs) && !rhs.m_pending.empty()){
+            rhs.meldPending();
+        }
+
+        if ((this != &rhs) && (m_structure == DARY)){
+            //the rhs array is appended, then the whole array is rebuilt in linear time
+            m_array.insert(m_array.end(), rhs.m_array.begin(), rhs.m_array.end());
+            rhs.m_array.clear();
+            m_size += rhs.m_size;
+            rhs.m_size = 0;
+            heapify();
+        }
+        else if (this != &rhs){
+            //merges the lhs's m_heap with the rhs's m_heap, the nodes of rhs and their slabs now belong to this heap
+            NodeHeap<CQueue>::meld(*this, m_heap, m_pool, rhs.m_heap, rhs.m_pool);
         }
         
         //m_size changes to be the normal size plus the new size
@@ -85,15 +281,117 @@ void CQueue::mergeWithQueue(CQueue& rhs) {
 
 //insertOrder
 //a new order is inserted by merging it with the existing heap of orders
-void CQueue::insertOrder(const Order& order) {
-    //newNode declared and initialized with the order
-    Node* newNode = new Node(order);
+//returns a handle to the node holding it, or an empty handle if it went into a DARY array
+OrderHandle CQueue::insertOrder(const Order& order) {
+    CQUEUE_STAT(LatencyTimer timer(m_stats.m_insertLatency);)
 
-    //merge called to insert the newNode into the heap, so it can be determined what priority it is
-    //starts with m_heap since we do not know what will be changed
-    m_heap = merge(m_heap, newNode);
+    //the priority is computed once here and cached for every later comparison, then the insertion is logged,
+    //so a priority function that throws leaves nothing in the log
+    int priority = priorityOf(order);
+    if (m_log != nullptr){
+        m_log->logInsert(order);
+    }
+
+    //if statement checks for bucket mode, the order goes to the back of its bucket
+    //an order outside the range makes the queue fall back to its structure
+    if (m_bucketMode){
+        if (m_buckets.inRange(priority)){
+            Node* newNode = m_pool.acquire(order, priority);
+            indexNode(newNode);
+            m_buckets.push(newNode);
+            ++m_size;
+            return OrderHandle(newNode);
+        }
+        leaveBucketMode();
+    }
+
+    //if statement checks for a DARY heap, the order is added to the end of the array and moved up
+    if (m_structure == DARY){
+        m_array.push_back(DaryEntry(order, priority));
+        siftUp(m_size);
+        ++m_size;
+        return OrderHandle();
+    }
+
+    //newNode declared and initialized with the order and its cached priority
+    Node* newNode = m_pool.acquire(order, priority);
+    indexNode(newNode);
+
+    //the newNode is merged into the heap by the same code BasicCQueue runs, with this queue picking the MergeEngine
+    NodeHeap<CQueue>::insertNode(*this, m_heap, newNode);
     
     ++m_size; //m_size increased by one
+    return OrderHandle(newNode);
+}
+
+//updateOrder
+//replaces the order held by handle and moves only its node, instead of rebuilding the whole heap
+//an empty handle throws invalid_argument, and a DARY heap, which has no nodes, throws domain_error, as does
+//a stale handle, whose node has been taken back by the pool since, even if it was handed out again
+void CQueue::updateOrder(OrderHandle handle, const Order& order){
+    if (handle.m_node == nullptr){
+        throw invalid_argument("Invalid argument");
+    }
+    else if (((m_structure == DARY) && !m_bucketMode) || !handle.isValid()){
+        throw domain_error("Domain error");
+    }
+
+    //the priority is computed before the update is logged, so a priority function that throws leaves nothing in the log
+    Node* node = handle.m_node;
+    int priority = priorityOf(order);
+    if (m_log != nullptr){
+        m_log->logUpdate(node->m_order, order);
+    }
+
+    //if statement checks if the order ID changed, if so the node is filed under the new one
+    bool newID = (order.getOrderID() != node->m_order.getOrderID());
+    if (newID){
+        unindexNode(node);
+    }
+    node->m_order = order;
+    if (newID){
+        indexNode(node);
+    }
+
+    //if statement checks for bucket mode, the node moves to the back of the bucket for its new priority
+    //a priority outside the range makes the queue fall back to its structure, with node at the front of the list
+    if (m_bucketMode){
+        m_buckets.remove(node);
+        node->m_priority = priority;
+        if (m_buckets.inRange(priority)){
+            m_buckets.push(node);
+        }
+        else{
+            node->m_right = m_buckets.takeAll();
+            m_bucketMode = false;
+            buildFromList(node);
+        }
+        return;
+    }
+
+    //the subtree of node is cut out, whether the priority got better or worse is checked first
+    bool improved = ((m_heapType == MINHEAP) ? (priority <= node->m_priority) : (priority >= node->m_priority));
+    cutNode(node);
+    node->m_priority = priority;
+
+    //if statement checks if the priority improved, if so node still belongs above its subtree and they move together
+    if (improved){
+        m_heap = merge(m_heap, node);
+    }
+    //else node is taken off its subtree like a root, and both are merged back separately
+    else{
+        Node* subtree = removeRoot(node);
+        node->m_left = nullptr;
+        node->m_right = nullptr;
+        m_heap = merge(m_heap, subtree);
+        NodeHeap<CQueue>::insertNode(*this, m_heap, node);
+    }
+}
+
+//insertOrders
+//inserts every order in the vector with a linear-time bulk build
+void CQueue::insertOrders(const vector<Order>& orders) {
+    insertOrders(orders.begin(), orders.end());
 }
 
 //numOrders
@@ -111,297 +409,2228 @@ prifn_t CQueue::getPriorityFn() const {
 //getNextOrder
 //returns the priority order
 Order CQueue::getNextOrder() {
-    //if m_heap is a nullptr, an out of range error is thrown
-    if (m_heap == nullptr){
+    //if the queue is empty, an out of range error is thrown
+    if (m_size == 0){
         throw out_of_range("Out of Range");
     }
+    CQUEUE_STAT(LatencyTimer timer(m_stats.m_nextLatency);)
+
+    logRemovals(1);
+    //if it is a DARY heap, the top of the array is removed
+    if ((m_structure == DARY) && !m_bucketMode){
+        return popEntry().m_order;
+    }
     else{
-        Node* returnedNode = m_heap; //Node* returnedNode is set equal to m_heap
+        Node* returnedNode = popNode(); //the old m_heap is detached
         Order myOrder = returnedNode->getOrder(); //myOrder holds returnedNode's order
-        m_heap = merge(m_heap->m_left, m_heap->m_right); //merges the two subtrees of the tree deleted
-        delete returnedNode; //deletes the old m_heap entirely
-        --m_size; //m_size reduced by one
+        m_pool.release(returnedNode); //returns the old m_heap to the pool
         return myOrder; 
     }
 }
 
-//setPriorityFn
-//Changes the priority function and then changes the heap
-void CQueue::setPriorityFn(prifn_t priFn, HEAPTYPE heapType) {
-    //if statement checks to ensure the heapType is valid
-    if ((heapType != MINHEAP) && (heapType != MAXHEAP)){
-        return;
+//getNextPriority
+//returns the cached priority of the next order without removing it, throws out_of_range if empty
+int CQueue::getNextPriority() const{
+    if (m_size == 0){
+        throw out_of_range("Out of Range");
     }
-    //else if the heap type and priFn are the same, nothing must be changed
-    else if (priFn == m_priorFunc && heapType == m_heapType){
-        return;
+    else if (m_bucketMode){
+        return m_buckets.front(m_heapType)->m_priority;
+    }
+    else if (m_structure == DARY){
+        return m_array[0].m_priority;
     }
     else{
-    //else, a new heap is created, which has the same structure but different members than this
-        CQueue* newHeap = new CQueue(priFn, heapType, m_structure);
+        //the best root is found among m_heap and every pending heap
+        const Node* top = m_heap;
+        for (unsigned int i = 0; i < m_pending.size(); i++){
+            if ((top == nullptr) || !hasPriority(top, m_pending[i])){
+                top = m_pending[i];
+            }
+        }
+        return top->m_priority;
+    }
+}
 
-        //priorityFunction helper adds the nodes into the new heap
-        priorityFuncHelper(m_heap, *newHeap);
+//countAhead
+//returns the number of orders with a strictly higher priority than priority
+//a subtree is skipped as soon as its root is not ahead, since nothing below it can be
+int CQueue::countAhead(int priority) const{
+    int count = 0;
+    if (m_size == 0){
+        return count;
+    }
+
+    //if statement checks for bucket mode, every bucket ahead of priority is counted
+    if (m_bucketMode){
+        int numBuckets = int(m_buckets.m_heads.size());
+        for (int i = 0; i < numBuckets; i++){
+            int bucketPriority = m_buckets.getMinPriority() + i;
+            if ((m_heapType == MINHEAP) ? (bucketPriority < priority) : (bucketPriority > priority)){
+                for (const Node* curr = m_buckets.m_heads[i]; curr != nullptr; curr = curr->m_right){
+                    ++count;
+                }
+            }
+        }
+        return count;
+    }
+
+    //else if it is a DARY heap, the array is searched from the root with an explicit stack of indices
+    if (m_structure == DARY){
+        vector<int> stack(1, 0);
+        while (!stack.empty()){
+            int index = stack.back();
+            stack.pop_back();
+            int currPriority = m_array[index].m_priority;
+            if ((m_heapType == MINHEAP) ? (currPriority < priority) : (currPriority > priority)){
+                ++count;
+                for (int i = m_arity * index + 1; (i <= m_arity * index + m_arity) && (i < m_size); i++){
+                    stack.push_back(i);
+                }
+            }
+        }
+        return count;
+    }
 
-        *this = *newHeap; //this is set equal to newHeap, so that the new structure takes over
-        delete newHeap; //newHeap deleted
+    //else the tree and every pending heap are searched from their roots with an explicit stack of nodes
+    vector<const Node*> stack(1, m_heap);
+    stack.insert(stack.end(), m_pending.begin(), m_pending.end());
+    while (!stack.empty()){
+        const Node* curr = stack.back();
+        stack.pop_back();
+        if (curr == nullptr){
+            continue;
+        }
+        if ((m_heapType == MINHEAP) ? (curr->m_priority < priority) : (curr->m_priority > priority)){
+            ++count;
+            stack.push_back(curr->m_left);
+            stack.push_back(curr->m_right);
+        }
+        //else if it is a pairing heap, m_right holds siblings rather than children, so it is still searched
+        else if (m_structure == PAIRING){
+            stack.push_back(curr->m_right);
+        }
     }
+    return count;
 }
 
-//setStructure
-//Changes the structure of the heap, and thus reorders the heap based on the new structure
-void CQueue::setStructure(STRUCTURE structure){
-   //if statement checks to ensure that the structure is valid
-   if ((structure != SKEW) && (structure != LEFTIST)){
-    return;
-   }
-   //else if structure is the same, nothing must be changed
-    else if (structure == m_structure){
-        return;
+//peekTopOrders
+//returns up to k of the highest priority orders, best first, without changing the queue
+//a small frontier heap holds every node that could come next, and a node only joins it once its
+//parent has been returned; a skew, leftist or DARY heap looks at about k nodes in O(k log k), but a
+//pairing node's children are not ordered against each other, so each returned node scans all of them,
+//which is O(n) for a root left with every order as a child by inserts alone
+vector<Order> CQueue::peekTopOrders(int k) const{
+    vector<Order> top;
+    if ((k <= 0) || (m_size == 0)){
+        return top;
     }
-    else{   
-        //else, a new heap is created, which has the same members as the current heap except for the structure
-        CQueue* newHeap = new CQueue(m_priorFunc, m_heapType, structure);
+    k = ((k < m_size) ? k : m_size);
+    top.reserve(k);
 
-        //priorityFuncHelper called to help add them to the end of the new heap
-        priorityFuncHelper(m_heap, *newHeap);
+    //if statement checks for bucket mode, the buckets are already in priority order
+    if (m_bucketMode){
+        m_buckets.peek(m_heapType, k, top);
+        return top;
+    }
+
+    bool minHeap = (m_heapType == MINHEAP);
 
-        *this = *newHeap; //this is set equal to newHeap, so that the new structure takes over
-        delete newHeap; //newHeap deleted
+    //if statement checks for a DARY heap, the frontier holds array indices and each returned entry adds its children
+    if (m_structure == DARY){
+        auto worseEntry = [this, minHeap](int lhs, int rhs){
+            return minHeap ? (m_array[lhs].m_priority > m_array[rhs].m_priority) : (m_array[lhs].m_priority < m_array[rhs].m_priority);
+        };
+        vector<int> frontier;
+        frontier.reserve(k * m_arity + 1); //each returned entry adds at most m_arity
+        frontier.push_back(0);
+        while (int(top.size()) < k){
+            pop_heap(frontier.begin(), frontier.end(), worseEntry);
+            int index = frontier.back();
+            frontier.pop_back();
+            top.push_back(m_array[index].m_order);
+            for (int i = m_arity * index + 1; (i <= m_arity * index + m_arity) && (i < m_size); i++){
+                frontier.push_back(i);
+                push_heap(frontier.begin(), frontier.end(), worseEntry);
+            }
+        }
+        return top;
     }
-}
 
-//getStructure
-//returns the m_structure of the queue
-STRUCTURE CQueue::getStructure() const {
-    return m_structure;
-}
+    //else the frontier holds nodes, starting with the root of m_heap and of every pending heap
+    auto worseNode = [minHeap](const Node* lhs, const Node* rhs){
+        return minHeap ? (lhs->m_priority > rhs->m_priority) : (lhs->m_priority < rhs->m_priority);
+    };
+    vector<const Node*> frontier;
+    frontier.reserve(2 * k + m_pending.size() + 1);
+    if (m_heap != nullptr){
+        frontier.push_back(m_heap);
+    }
+    frontier.insert(frontier.end(), m_pending.begin(), m_pending.end());
+    make_heap(frontier.begin(), frontier.end(), worseNode);
+    vector<const Node*> children; //sibling list of a pairing node, before the worst are dropped
 
-//getHeapType
-//returns heap type
-HEAPTYPE CQueue::getHeapType() const{
-    return m_heapType;
-}
+    //while loop returns the best node of the frontier and adds its children
+    while (int(top.size()) < k){
+        pop_heap(frontier.begin(), frontier.end(), worseNode);
+        const Node* curr = frontier.back();
+        frontier.pop_back();
+        top.push_back(curr->m_order);
 
-//printorders queue
-//using preorder traversal, prints the current amount of items within the queue
-void CQueue::printOrdersQueue() const {
-    preorderTraversal(m_heap); //preorderTraversal called with m_heap, or the root, starting
+        //if statement checks for a pairing heap, every child is on the sibling list from m_left and none is
+        //ordered against the others; only the best that could still be returned join the frontier, so it
+        //stays O(k) however wide the list is, and the rest are never looked at again, nor is anything below them
+        if (m_structure == PAIRING){
+            size_t wanted = k - top.size();
+            children.clear();
+            for (const Node* child = curr->m_left; child != nullptr; child = child->m_right){
+                children.push_back(child);
+            }
+            if (children.size() > wanted){
+                nth_element(children.begin(), children.begin() + wanted, children.end(),
+                        [&worseNode](const Node* lhs, const Node* rhs){ return worseNode(rhs, lhs); });
+                children.resize(wanted);
+            }
+            for (const Node* child : children){
+                frontier.push_back(child);
+                push_heap(frontier.begin(), frontier.end(), worseNode);
+            }
+        }
+        //else both children join the frontier
+        else{
+            if (curr->m_left != nullptr){
+                frontier.push_back(curr->m_left);
+                push_heap(frontier.begin(), frontier.end(), worseNode);
+            }
+            if (curr->m_right != nullptr){
+                frontier.push_back(curr->m_right);
+                push_heap(frontier.begin(), frontier.end(), worseNode);
+            }
+        }
+    }
+    return top;
 }
 
-//dump
-//dumps out the function
-void CQueue::dump() const {
-  if (m_size == 0) {
-    cout << "Empty heap.\n" ;
-  } else {
-    dump(m_heap);
-  }
-  cout << endl;
-}
+//popNode
+//detaches the root and rebuilds the heap from what was below it, the caller must release the node
+Node* CQueue::popNode(){
+    //if statement checks for bucket mode, the front of the best bucket is detached
+    if (m_bucketMode){
+        --m_size;
+        Node* returnedNode = m_buckets.pop(m_heapType);
+        unindexNode(returnedNode);
+        return returnedNode;
+    }
 
-//dump
-//overloaded function which dumps the items in the queue if not empty
-void CQueue::dump(Node *pos) const {
-  if ( pos != nullptr ) {
-    cout << "(";
-    dump(pos->m_left);
-    if (m_structure == SKEW)
-        cout << m_priorFunc(pos->m_order) << ":" << pos->m_order.getPoints();
-    else
-        cout << m_priorFunc(pos->m_order) << ":" << pos->m_order.getPoints() << ":" << pos->m_npl;
-    dump(pos->m_right);
-    cout << ")";
-  }
-}
+    //if statement checks for pending heaps, the one with the best root is melded in first,
+    //so the root of m_heap is the best order of the whole queue
+    if (!m_pending.empty()){
+        meldBestPending();
+    }
 
-//operator<<
-//done for orders, and nodes, to output the orders
-ostream& operator<<(ostream& sout, const Order& order) {
-  sout << "Order ID: " << order.getOrderID() 
-        << ", customer ID: " << order.getCustomerID()
-        << ", # of points: " << order.getPoints()
-        << ", membership tier: " << order.getTierString()
-        << ", item ordered: " << order.getItemString()
-        << ", quantity: " << order.getCountString();
-  return sout;
-}
-ostream& operator<<(ostream& sout, const Node& node) {
-  sout << node.getOrder();
-  return sout;
+    //the root is detached, and the subtrees are merged, or the children paired, into the new heap
+    Node* returnedNode = NodeHeap<CQueue>::removeNode(*this, m_heap);
+    --m_size; //m_size reduced by one
+    unindexNode(returnedNode);
+    return returnedNode;
 }
 
-//recursiveClear
-//uses recursion to completely delete the heap, using postorder traversal
-void CQueue::recursiveClear(Node* curr){
-    //if statement checks to ensure that curr is not a nullptr
-    if (curr != nullptr){
-        //postorder traversal used to completely delete the heap
-        recursiveClear(curr->m_left);
-        recursiveClear(curr->m_right);
-        delete curr; //curr is deleted
-    }
+//cancelOrder
+//removes one order with the order ID from anywhere in the queue, returns false if no order has it
+//the node is found through the index if the queue keeps one, otherwise every order is searched in O(n);
+//a DARY heap has no nodes to index, so its array is always searched
+bool CQueue::cancelOrder(int orderID){
+    return removeOrder(orderID, nullptr);
 }
 
+//removeOrder
+//removes one order with the order ID, or exactly order if it is given, and logs the order removed
+//returns false if there is none
+bool CQueue::removeOrder(int orderID, const Order* order){
+    //if statement checks for an ID no order can hold, which is not found without a search
+    if ((orderID < 0) || (orderID >= (1 << IDBITS))){
+        return false;
+    }
 
-//merge
-//helper function which helps with merging
-Node* CQueue::merge(Node* leftNode, Node* rightNode){
-    Node* newSubtree = nullptr; //newSubtree set to nullptr
+    //if statement checks for a DARY heap, the array is searched and the entry erased in place
+    if ((m_structure == DARY) && !m_bucketMode){
+        for (int i = 0; i < m_size; i++){
+            if ((m_array[i].m_order.getOrderID() == orderID)
+                    && ((order == nullptr) || sameOrder(m_array[i].m_order, *order))){
+                if (m_log != nullptr){
+                    m_log->logCancel(m_array[i].m_order);
+                }
+                eraseEntry(i);
+                return true;
+            }
+        }
+        return false;
+    }
 
-    //if statement checks if both are nullptrs, which is our base case
-    if ((leftNode == nullptr) && (rightNode == nullptr)){
-        return newSubtree; //newSubtree, or nullptr, is returned
+    //node found through the index, or by a search
+    Node* node = nullptr;
+    if (m_indexed){
+        pair<unordered_multimap<int, Node*>::iterator, unordered_multimap<int, Node*>::iterator> found = m_index.equal_range(orderID);
+        for (unordered_multimap<int, Node*>::iterator curr = found.first; curr != found.second; ++curr){
+            if ((order == nullptr) || sameOrder(curr->second->m_order, *order)){
+                node = curr->second;
+                m_index.erase(curr);
+                break;
+            }
+        }
     }
-    //else statement checks if the left isn't a nullptr, but the right one is
-    else if ((leftNode != nullptr) && (rightNode == nullptr)){
-        newSubtree = leftNode; //newSubtree takes on the left side
+    else{
+        node = findNode(orderID, order);
+    }
+
+    //if statement checks if the order was found, if so it is logged, detached and returned to the pool
+    if (node == nullptr){
+        return false;
     }
-    //else if leftNode is nullptr but right is not a nullptr, the newSubtree becomes the right
-    else if ((leftNode == nullptr) && (rightNode != nullptr)){
-        newSubtree = rightNode; //newSubtree takes on the right
+    if (m_log != nullptr){
+        m_log->logCancel(node->m_order);
     }
+    detachNode(node);
+    m_pool.release(node);
+    return true;
+}
 
-    //else, both are not nullptrs, and newSubtree has to be determined
-    else{
-        //if statement determines if a MINHEAP or MAXHEAP
-        //this determines which gets set to the left and which is set to the right
-        if (m_heapType == MINHEAP){
-            //if statement determines which value is lesser, then makes 
-            //priorFunction called to determine the valueS
-            if (m_priorFunc(leftNode->m_order) <= m_priorFunc(rightNode->m_order)){
-                leftNode->m_right = merge(leftNode->m_right, rightNode);
-                newSubtree = leftNode; //the newSubtree becomes the ptr to the left node
-            }
-            //else, the left subtree is compared and merged
-            else{
-                rightNode->m_right = merge(rightNode->m_right, leftNode);
-                newSubtree = rightNode; //newSubtree takes on the right node
-            }
+//cutNode
+//detaches the subtree rooted at node, which is left as the root of a heap of its own
+//a root is taken off m_heap or the pending list, any other node is unlinked from the node pointing to it
+void CQueue::cutNode(Node* node){
+    Node* parent = node->m_parent;
+
+    //if statement checks if node is a root, if so it is found among m_heap and the pending heaps
+    if (parent == nullptr){
+        if (node == m_heap){
+            m_heap = nullptr;
+            return;
         }
-        else{
-            //if statement determines which value is greater since MAXHEAP, then makes 
-            //m_priorFunc called
-            if (m_priorFunc(leftNode->m_order) >= m_priorFunc(rightNode->m_order)){
-                leftNode->m_right = merge(leftNode->m_right, rightNode);
-                newSubtree = leftNode; //the newSubtree becomes the ptr to the left node
-            }
-            //else, the left subtree is compared and merged
-            else{
-                rightNode->m_right = merge(rightNode->m_right, leftNode);
-                newSubtree = rightNode; //newSubtree is set equal to right
+        for (unsigned int i = 0; i < m_pending.size(); i++){
+            if (m_pending[i] == node){
+                m_pending[i] = m_pending.back();
+                m_pending.pop_back();
+                return;
             }
         }
+        return;
     }
 
-    //if statement determines which type of heap it is, then determines whether to swap or not
-    if (m_structure == SKEW){
-        swap(newSubtree->m_left, newSubtree->m_right); //swaps newSubtree's left and right value, as required in skew heaps
+    //if statement checks for a pairing heap, the later siblings of node take its place
+    if (m_structure == PAIRING){
+        if (parent->m_left == node){
+            parent->m_left = node->m_right;
+        }
+        else{
+            parent->m_right = node->m_right;
+        }
+        if (node->m_right != nullptr){
+            node->m_right->m_parent = parent;
+        }
+        node->m_right = nullptr;
     }
-    //else, it is a leftist heap, since only two types of heaps
+    //else the link from the parent is cleared, and a leftist heap is fixed on the way up
     else{
-        //if statement checks if m_right is not a nullptr and determines if a swap is needed
-        if ((newSubtree->m_right != nullptr)){
-            //if statement is if m_left is not a nullptr
-            if (newSubtree->m_left != nullptr){
-                //if statement determines which NPL is lesser 
-                //if the right one is greater than the left, it is swapped based on the leftist heap theorem, since we want a left skew
-                if (newSubtree->m_right->getNPL() > newSubtree->m_left->getNPL()){
-                    //if this is true, they are swapped
-                    swap(newSubtree->m_left, newSubtree->m_right);
-                }
-            }
-            //else, if m_left is a nullptr, a swap is automatically needed since skew is on right side
-            else{
-                swap(newSubtree->m_left, newSubtree->m_right); //swaps nullptr to right side
-            }
+        if (parent->m_left == node){
+            parent->m_left = nullptr;
+        }
+        else{
+            parent->m_right = nullptr;
+        }
+        if (m_structure == LEFTIST){
+            fixNPL(parent);
         }
-
-        //NPL updated for the newSubtree
-        updateNPL(newSubtree);
     }
-    //newSubtree is returned
-    return newSubtree;
+    node->m_parent = nullptr;
 }
 
-//swap
-//helper function which helps with swapping left and right heaps
-void CQueue::swap(Node*& leftNode, Node*& rightNode){
-    //memory addresses sent to that merge knows the changes which take place
-    Node* temp = leftNode; //temp declared and initialized to leftNode
-    leftNode = rightNode; //leftNode set equal to the right node
-    rightNode = temp; //right node set equal to temp
-}
-
-//updateNPL
-//updates the NPL for nodes
-void CQueue::updateNPL(Node* node){
-    //if statement checks to ensure that node is not a nullptr
-    if (node != nullptr){
-        //leftNPL and rightNPL declared and initialized
-        //determines if a nullptr is present
-        int leftNPL = ((node->m_left == nullptr) ? 0 : node->m_left->getNPL());
-        int rightNPL = ((node->m_right == nullptr) ? 0 : node->m_right->getNPL());
-        //newHeight is one plus the ternary operator depending on which NPL is lesser
-        //if leftNPL is greater, rightNPL is set, else the leftNPL is set
-        //it depends on which is lesser
-        int newNPL = 1 + ((leftNPL < rightNPL) ? leftNPL : rightNPL);
-        node->setNPL(newNPL); //node's new NPL is set
+//fixNPL
+//restores the leftist property from curr up towards the root after a subtree was cut
+//the walk stops as soon as an NPL is unchanged, so it never climbs more than O(log n) nodes
+void CQueue::fixNPL(Node* curr){
+    while (curr != nullptr){
+        //if the right NPL is greater than the left, or the left is empty, they are swapped
+        if ((curr->m_left == nullptr) || ((curr->m_right != nullptr) && (curr->m_right->m_npl > curr->m_left->m_npl))){
+            CQUEUE_STAT(m_stats.nplSwap();)
+            Node* temp = curr->m_left;
+            curr->m_left = curr->m_right;
+            curr->m_right = temp;
+        }
+
+        //NPL updated, one plus the NPL of the right child, if it did not change nothing above can
+        int npl = 1 + ((curr->m_right == nullptr) ? 0 : curr->m_right->m_npl);
+        if (npl == curr->m_npl){
+            return;
+        }
+        curr->m_npl = npl;
+        curr = curr->m_parent;
     }
 }
 
-//preorderTraversal
-//prints out the items in the function by preorder traversal
-void CQueue::preorderTraversal(const Node* curr) const{
-    //if curr is a nullptr, that means that it will seg fault, so if statement checks for that
-    //base case of this recursive function
-    if (curr == nullptr){
+//detachNode
+//removes node from its bucket or its heap, leaving everything else in place
+//in a skew or leftist heap the two subtrees of node are merged into its place, and a leftist heap
+//is fixed on the way up; in a pairing heap the children are paired and merged with the root
+void CQueue::detachNode(Node* node){
+    --m_size;
+
+    //if statement checks for bucket mode, node is unlinked from its bucket
+    if (m_bucketMode){
+        m_buckets.remove(node);
         return;
     }
+
+    Node* parent = node->m_parent;
+    Node* subtree = nullptr;
+
+    //if statement checks if node is a root or in a pairing heap, if so what was below it is merged with the root
+    if ((parent == nullptr) || (m_structure == PAIRING)){
+        cutNode(node);
+        subtree = removeRoot(node);
+        m_heap = merge(m_heap, subtree);
+    }
+    //else the merged subtrees take the place of node under its parent
     else{
-        //follows print parent first, then left child, then right child principle of preorde traversal 
-        cout << "[" << m_priorFunc(curr->m_order) << "] " << *curr << endl;
+        subtree = removeRoot(node);
+        if (parent->m_left == node){
+            parent->m_left = subtree;
+        }
+        else{
+            parent->m_right = subtree;
+        }
+        if (subtree != nullptr){
+            subtree->m_parent = parent;
+        }
+        if (m_structure == LEFTIST){
+            fixNPL(parent);
+        }
+    }
+    node->m_left = nullptr;
+    node->m_right = nullptr;
+    node->m_parent = nullptr;
+}
 
-        //preorderTraversal called for left and right children
-        preorderTraversal(curr->m_left);
-        preorderTraversal(curr->m_right);
+//saveSnapshot
+//writes the snapshot to a file, returns false if it cannot be written
+bool CQueue::saveSnapshot(const string& path) const{
+    ofstream file(path.c_str(), ios::binary | ios::trunc);
+    if (!file){
+        return false;
     }
+    writeSnapshot(file);
+    file.close();
+    return !file.fail();
 }
 
-//preorderAssignment
-//Helper function of the assignment operator, assigns a new node to curr for the lhs tree
-Node* CQueue::preOrderAssignment(const Node* rhsNode){
-    //if rhsNode is nullptr, nothing is done
-    if (rhsNode == nullptr){
-        return nullptr;
+//writeSnapshot
+//writes a header, then one record per order: the trees in preorder with their links and NPL,
+//the DARY array in index order, or each bucket front to back, so loading needs no search
+void CQueue::writeSnapshot(ostream& out) const{
+    //the header describes the queue, the priority function cannot be saved and is left to the loader
+    SnapshotHeader header = SnapshotHeader();
+    header.m_magic = SNAPSHOTMAGIC;
+    header.m_version = SNAPSHOTVERSION;
+    header.m_recordSize = sizeof(SnapshotRecord);
+    header.m_heapType = m_heapType;
+    header.m_structure = m_structure;
+    header.m_arity = m_arity;
+    header.m_bucketMode = (m_bucketMode ? 1 : 0);
+    header.m_minPriority = (m_bucketMode ? m_buckets.getMinPriority() : 0);
+    header.m_maxPriority = (m_bucketMode ? m_buckets.getMaxPriority() : 0);
+    header.m_size = m_size;
+
+    //the heap and every pending heap are saved as separate trees, so nothing is melded
+    vector<const Node*> roots;
+    if (!m_bucketMode && (m_structure != DARY)){
+        if (m_heap != nullptr){
+            roots.push_back(m_heap);
+        }
+        for (unsigned int i = 0; i < m_pending.size(); i++){
+            if (m_pending[i] != nullptr){
+                roots.push_back(m_pending[i]);
+            }
+        }
     }
-    else{
-        //curr set to be a new node with the same info as rhsNode, NPL set to be the same
-        Node* curr = new Node(rhsNode->getOrder());
-        curr->setNPL(rhsNode->getNPL());
+    header.m_numTrees = static_cast<int32_t>(roots.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
 
-        //preorderAssignment called with rhsNode going to the left first then right
-        //set as left and right subtrees of curr
-        curr->m_left = preOrderAssignment(rhsNode->m_left);
-        curr->m_right = preOrderAssignment(rhsNode->m_right);
+    //records are gathered in a buffer and written a block at a time
+    vector<SnapshotRecord> buffer;
+    buffer.reserve(SNAPSHOTBUFFER);
+    auto addRecord = [&](const Order& order, int priority, int links, int npl){
+        SnapshotRecord record = SnapshotRecord();
+        record.m_order = order;
+        record.m_priority = priority;
+        record.m_links = static_cast<uint8_t>(links);
+        record.m_npl = static_cast<uint8_t>(npl);
+        buffer.push_back(record);
+        if (buffer.size() == static_cast<size_t>(SNAPSHOTBUFFER)){
+            out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(SnapshotRecord));
+            buffer.clear();
+        }
+    };
+
+    //if statements check where the orders are kept, each is written in the order it is rebuilt
+    if (m_bucketMode){
+        for (unsigned int i = 0; i < m_buckets.m_heads.size(); i++){
+            for (const Node* curr = m_buckets.m_heads[i]; curr != nullptr; curr = curr->m_right){
+                addRecord(curr->m_order, curr->m_priority, 0, curr->m_npl);
+            }
+        }
+    }
+    else if (m_structure == DARY){
+        for (int i = 0; i < m_size; i++){
+            addRecord(m_array[i].m_order, m_array[i].m_priority, 0, 0);
+        }
+    }
+    else{
+        vector<const Node*> stack;
+        for (unsigned int i = 0; i < roots.size(); i++){
+            stack.push_back(roots[i]);
 
-        return curr; //curr is returned
+            //while loop writes the tree parent first, then left subtree, then right subtree
+            while (!stack.empty()){
+                const Node* curr = stack.back();
+                stack.pop_back();
+                int links = ((curr->m_left != nullptr) ? SNAPLEFT : 0) | ((curr->m_right != nullptr) ? SNAPRIGHT : 0);
+                addRecord(curr->m_order, curr->m_priority, links, curr->m_npl);
+                if (curr->m_right != nullptr){
+                    stack.push_back(curr->m_right);
+                }
+                if (curr->m_left != nullptr){
+                    stack.push_back(curr->m_left);
+                }
+            }
+        }
     }
+    out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(SnapshotRecord));
 }
 
-//priorityFuncHelper
-//uses postorder traversal to add nodes into the rebuilt heap
-void CQueue::priorityFuncHelper(const Node* curr, CQueue& newCQueue){
-    if (curr == nullptr){
-        return;
+//loadSnapshot
+//maps the file read-only and rebuilds the queue straight from the mapped records, nothing is parsed or copied first
+//a domain error is thrown if the snapshot came from a queue with a different heap type or structure,
+//and a file with a valid header but damaged records leaves the queue empty
+bool CQueue::loadSnapshot(const string& path){
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0){
+        return false;
     }
-    else{
-        //checks left first then checks right
-        priorityFuncHelper(curr->m_left, newCQueue);
-        priorityFuncHelper(curr->m_right, newCQueue);
 
-        //order is then added into the function
-        newCQueue.insertOrder(curr->m_order);
+    //if statement checks the file is at least big enough for a header
+    struct stat info;
+    if ((fstat(file, &info) != 0) || (info.st_size < static_cast<off_t>(sizeof(SnapshotHeader)))){
+        close(file);
+        return false;
     }
+    size_t length = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); //the mapping stays valid once the file is closed
+    if (data == MAP_FAILED){
+        return false;
+    }
+    madvise(data, length, MADV_SEQUENTIAL); //the records are read once from front to back
 
-}
\ No newline at end of file
+    //the mapping is released even if the snapshot is of another kind of queue
+    bool loaded = false;
+    try{
+        loaded = loadImage(static_cast<const char*>(data), length);
+    }
+    catch (const domain_error& e){
+        munmap(data, length);
+        throw;
+    }
+    munmap(data, length);
+
+    //if statement checks if the orders were replaced, or dropped by damaged records, either is logged
+    if (loaded){
+        logSnapshot();
+    }
+    else if ((m_size == 0) && (m_log != nullptr)){
+        m_log->logClear();
+    }
+    return loaded;
+}
+
+//loadImage
+//replaces every order with a snapshot held in memory, which must be 8-byte aligned so the records are read in place
+//a domain error is thrown if the snapshot came from a queue with a different heap type or structure
+bool CQueue::loadImage(const char* data, size_t length){
+    //if statement checks there is room for a header
+    if (length < sizeof(SnapshotHeader)){
+        return false;
+    }
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(data);
+    const SnapshotRecord* records = reinterpret_cast<const SnapshotRecord*>(header + 1);
+
+    //if statement checks the header is from this layout and the image holds exactly its records
+    bool valid = (header->m_magic == SNAPSHOTMAGIC) && (header->m_version == SNAPSHOTVERSION)
+        && (header->m_recordSize == sizeof(SnapshotRecord)) && (header->m_size >= 0) && (header->m_size <= INT32_MAX)
+        && (length == sizeof(SnapshotHeader) + static_cast<size_t>(header->m_size) * sizeof(SnapshotRecord))
+        && (header->m_numTrees >= 0) && (header->m_numTrees <= header->m_size);
+    if (valid && ((header->m_heapType != m_heapType) || (header->m_structure != m_structure))){
+        throw domain_error("Domain error");
+    }
+    return (valid && loadRecords(*header, records));
+}
+
+//setPriorityFn
+//Changes the priority function and then changes the heap
+void CQueue::setPriorityFn(prifn_t priFn, HEAPTYPE heapType) {
+    //if statement checks to ensure the heapType is valid
+    if ((heapType != MINHEAP) && (heapType != MAXHEAP)){
+        return;
+    }
+    //else if the heap type and priFn are the same, nothing must be changed
+    else if (priFn == m_priorFunc && heapType == m_heapType){
+        return;
+    }
+    else{
+        //else, the change is logged, which throws if the log cannot name priFn, then the pending heaps
+        //are melded with the old policy, the new function and heap type are set, and the nodes are rebuilt in place
+        if (m_log != nullptr){
+            m_log->logPriorityFn(priFn, heapType);
+        }
+        meldPending();
+        m_priorFunc = priFn;
+        m_heapType = heapType;
+        rebuild();
+    }
+}
+
+//setStructure
+//Changes the structure of the heap, and thus reorders the heap based on the new structure
+void CQueue::setStructure(STRUCTURE structure){
+   //if statement checks to ensure that the structure is valid
+   if ((structure != SKEW) && (structure != LEFTIST) && (structure != DARY) && (structure != PAIRING)){
+    return;
+   }
+   //else if structure is the same, nothing must be changed
+    else if (structure == m_structure){
+        return;
+    }
+
+    //the pending heaps are melded with the old structure before anything is converted
+    meldPending();
+
+    //if statement checks if the queue is in bucket mode, the structure is only used if it falls back
+    if (m_bucketMode){
+        m_structure = structure;
+    }
+    //else if the new structure is DARY, every node is moved into the array
+    else if (structure == DARY){
+        treeToArray();
+        m_structure = structure;
+        heapify();
+    }
+    //else if the old structure is DARY, every entry is moved into a node and the tree is built
+    else if (m_structure == DARY){
+        m_structure = structure;
+        arrayToTree();
+    }
+    else{   
+        //else, the new structure is set, and the existing nodes are rebuilt in place
+        m_structure = structure;
+        rebuild();
+    }
+    logSnapshot(); //the new layout is logged with every order in it
+}
+
+//getArity
+//returns the number of children per node of a DARY heap
+int CQueue::getArity() const {
+    return m_arity;
+}
+
+//setArity
+//changes the number of children per node, a DARY heap is rebuilt for the new arity
+void CQueue::setArity(int arity){
+    //if statement checks to ensure that the arity is valid and different
+    if (((arity != 2) && (arity != 4) && (arity != 8)) || (arity == m_arity)){
+        return;
+    }
+    m_arity = arity;
+    if ((m_structure == DARY) && !m_bucketMode){
+        heapify();
+    }
+    logSnapshot();
+}
+
+//setPriorityRange
+//moves every order into FIFO buckets, one per priority in [minPriority, maxPriority]
+//invalid or too wide ranges are ignored, and the queue falls back at once if an order does not fit
+void CQueue::setPriorityRange(int minPriority, int maxPriority){
+    //if statement checks to ensure that the range is valid and not too wide
+    if ((maxPriority < minPriority) || (static_cast<long long>(maxPriority) - minPriority >= MAXBUCKETS)){
+        return;
+    }
+
+    //every order is detached from the buckets or the structure, then sorted into the new buckets
+    Node* list = (m_bucketMode ? m_buckets.takeAll() : takeList());
+    m_buckets.setRange(minPriority, maxPriority);
+    m_bucketMode = true;
+    fillBuckets(list);
+    logSnapshot();
+}
+
+//clearPriorityRange
+//leaves bucket mode, every order is put back into the structure
+void CQueue::clearPriorityRange(){
+    if (m_bucketMode){
+        leaveBucketMode();
+        logSnapshot();
+    }
+}
+
+//isBucketMode
+//returns true if the orders are kept in buckets
+bool CQueue::isBucketMode() const {
+    return m_bucketMode;
+}
+
+//setLazyMerge
+//turns lazy merging on or off, turning it off melds every pending heap
+//a DARY heap or a queue in bucket mode always merges at once
+void CQueue::setLazyMerge(bool lazy){
+    m_lazyMerge = lazy;
+
+    //if statement checks for pending heaps being melded, which changes the shape of the heap, so it is logged
+    if (!lazy && !m_pending.empty()){
+        meldPending();
+        logSnapshot();
+    }
+}
+
+//getLazyMerge
+//returns true if mergeWithQueue is lazy
+bool CQueue::getLazyMerge() const {
+    return m_lazyMerge;
+}
+
+//setOrderIndex
+//turns the order ID index on or off, turning it on indexes every node already in the queue
+void CQueue::setOrderIndex(bool indexed){
+    m_indexed = indexed;
+    rebuildIndex();
+}
+
+//getOrderIndex
+//returns true if the queue keeps an order ID index
+bool CQueue::getOrderIndex() const {
+    return m_indexed;
+}
+
+//getPoolHighWater
+//returns the most nodes the queue's pool has handed out at once
+int CQueue::getPoolHighWater() const {
+    return m_pool.highWaterMark();
+}
+
+//stats
+//returns a copy of the counters with the pool counts filled in, or empty counters when nothing is counted
+QueueStats CQueue::stats() const {
+    QueueStats copy;
+#ifdef CQUEUE_STATS
+    copy = m_stats;
+    copy.m_allocations = m_pool.numAcquired() - m_stats.m_allocations;
+    copy.m_slabs = m_pool.numSlabs() - m_stats.m_slabs;
+#endif
+    return copy;
+}
+
+//resetStats
+//starts every counter and histogram again, the pool counts are remembered as the new zero
+void CQueue::resetStats(){
+#ifdef CQUEUE_STATS
+    m_stats = QueueStats();
+    m_stats.m_allocations = m_pool.numAcquired();
+    m_stats.m_slabs = m_pool.numSlabs();
+#endif
+}
+
+//getStructure
+//returns the m_structure of the queue
+STRUCTURE CQueue::getStructure() const {
+    return m_structure;
+}
+
+//getHeapType
+//returns heap type
+HEAPTYPE CQueue::getHeapType() const{
+    return m_heapType;
+}
+
+//printorders queue
+//using preorder traversal, prints the current amount of items within the queue
+void CQueue::printOrdersQueue() const {
+    //if statement checks for bucket mode, the buckets are printed from the highest priority down
+    if (m_bucketMode){
+        bucketTraversal(false);
+    }
+    //else if it is a DARY heap, which is traversed from the first index
+    else if (m_structure == DARY){
+        arrayPreorderTraversal(0);
+    }
+    else{
+        preorderTraversal(m_heap); //preorderTraversal called with m_heap, or the root, starting
+
+        //each pending heap is printed after the main heap
+        for (unsigned int i = 0; i < m_pending.size(); i++){
+            preorderTraversal(m_pending[i]);
+        }
+    }
+}
+
+//attachLog
+//starts logging to log with a checkpoint of every order, or stops logging if log is nullptr
+//an invalid argument error is thrown if log cannot name the priority function
+void CQueue::attachLog(OrderLog* log){
+    if (log != nullptr){
+        log->checkpoint(*this);
+    }
+    m_log = log;
+}
+
+//getLog
+//returns the attached log
+OrderLog* CQueue::getLog() const {
+    return m_log;
+}
+
+//dump
+//dumps out the function
+void CQueue::dump() const {
+  if (m_size == 0) {
+    cout << "Empty heap.\n" ;
+  } else if (m_bucketMode) {
+    bucketTraversal(true);
+  } else if (m_structure == DARY) {
+    dumpArray(0);
+  } else {
+    dump(m_heap);
+    for (unsigned int i = 0; i < m_pending.size(); i++) {
+      cout << " + ";
+      dump(m_pending[i]);
+    }
+  }
+  cout << endl;
+}
+
+//dump
+//overloaded function which dumps the items in the queue if not empty
+//each node is visited three times from an explicit stack: to open it, to print it after its left
+//subtree, and to close it after its right subtree, so a deep tree cannot overflow the call stack
+void CQueue::dump(Node *pos) const {
+  vector<pair<const Node*, int> > stack; //nodes still being dumped, with how many visits they had
+  if ( pos != nullptr ) {
+    stack.push_back(make_pair(pos, 0));
+  }
+  while (!stack.empty()) {
+    const Node* curr = stack.back().first;
+    int visits = stack.back().second++;
+    if (visits == 0) {
+      cout << "(";
+      if (curr->m_left != nullptr)
+        stack.push_back(make_pair(curr->m_left, 0));
+    } else if (visits == 1) {
+      if (m_structure == LEFTIST)
+          cout << curr->m_priority << ":" << curr->m_order.getPoints() << ":" << curr->m_npl;
+      else
+          cout << curr->m_priority << ":" << curr->m_order.getPoints();
+      if (curr->m_right != nullptr)
+        stack.push_back(make_pair(curr->m_right, 0));
+    } else {
+      cout << ")";
+      stack.pop_back();
+    }
+  }
+}
+
+//dumpArray
+//dumps a DARY heap, each entry is followed by its children in parentheses
+void CQueue::dumpArray(int index) const {
+  if (index < m_size) {
+    cout << "(" << m_array[index].m_priority << ":" << m_array[index].m_order.getPoints();
+    for (int i = 1; i <= m_arity; i++) {
+      dumpArray(m_arity * index + i);
+    }
+    cout << ")";
+  }
+}
+
+//operator<<
+//done for orders, and nodes, to output the orders
+ostream& operator<<(ostream& sout, const Order& order) {
+  sout << "Order ID: " << order.getOrderID() 
+        << ", customer ID: " << order.getCustomerID()
+        << ", # of points: " << order.getPoints()
+        << ", membership tier: " << order.getTierString()
+        << ", item ordered: " << order.getItemString()
+        << ", quantity: " << order.getCountString();
+  return sout;
+}
+ostream& operator<<(ostream& sout, const Node& node) {
+  sout << node.getOrder();
+  return sout;
+}
+
+//merge
+//helper function which helps with merging
+//the heap type and structure are checked once, then the matching compiled MergeEngine does the work
+//and counts it into m_stats when the queue is built with CQUEUE_STATS
+Node* CQueue::merge(Node* leftNode, Node* rightNode){
+#ifdef CQUEUE_STATS
+    QueueStats& counter = m_stats;
+#else
+    NoMergeCount counter;
+#endif
+    //switch statement determines which structure it is, then the heap type picks the matching engine
+    switch (m_structure){
+        case SKEW:
+            return (m_heapType == MINHEAP) ? MergeEngine<MINHEAP, SKEW>::merge(leftNode, rightNode, counter)
+                                           : MergeEngine<MAXHEAP, SKEW>::merge(leftNode, rightNode, counter);
+        case LEFTIST:
+            return (m_heapType == MINHEAP) ? MergeEngine<MINHEAP, LEFTIST>::merge(leftNode, rightNode, counter)
+                                           : MergeEngine<MAXHEAP, LEFTIST>::merge(leftNode, rightNode, counter);
+        case PAIRING:
+            return (m_heapType == MINHEAP) ? MergeEngine<MINHEAP, PAIRING>::merge(leftNode, rightNode, counter)
+                                           : MergeEngine<MAXHEAP, PAIRING>::merge(leftNode, rightNode, counter);
+        default:
+            return nullptr; //a DARY heap has no nodes to merge
+    }
+}
+
+//removeRoot
+//helper function which returns the heap left behind when root is removed
+//skew and leftist heaps merge the two subtrees, a pairing heap combines the children in pairs
+Node* CQueue::removeRoot(Node* root){
+#ifdef CQUEUE_STATS
+    QueueStats& counter = m_stats;
+#else
+    NoMergeCount counter;
+#endif
+    //switch statement determines which structure it is, then the heap type picks the matching engine
+    switch (m_structure){
+        case SKEW:
+            return (m_heapType == MINHEAP) ? MergeEngine<MINHEAP, SKEW>::removeRoot(root, counter)
+                                           : MergeEngine<MAXHEAP, SKEW>::removeRoot(root, counter);
+        case LEFTIST:
+            return (m_heapType == MINHEAP) ? MergeEngine<MINHEAP, LEFTIST>::removeRoot(root, counter)
+                                           : MergeEngine<MAXHEAP, LEFTIST>::removeRoot(root, counter);
+        case PAIRING:
+            return (m_heapType == MINHEAP) ? MergeEngine<MINHEAP, PAIRING>::removeRoot(root, counter)
+                                           : MergeEngine<MAXHEAP, PAIRING>::removeRoot(root, counter);
+        default:
+            return nullptr; //a DARY heap has no nodes to remove
+    }
+}
+
+//buildStep
+//adds a node to a bulk build, like incrementing a binary counter
+//two heaps of 2^k orders are merged into one of 2^(k+1), so every merge pairs equal sizes
+void CQueue::buildStep(Node* slots[], Node* node){
+    int k = 0;
+
+    //while loop carries the merged heap up until an empty slot is found
+    while (slots[k] != nullptr){
+        node = merge(slots[k], node);
+        slots[k] = nullptr;
+        ++k;
+    }
+    slots[k] = node;
+}
+
+//buildFinish
+//merges whatever is left in the slots, smallest first, into one heap
+Node* CQueue::buildFinish(Node* slots[]){
+    Node* newSubtree = nullptr;
+
+    //for loop merges each remaining slot and empties it
+    for (int k = 0; k < MAXBUILDSLOTS; k++){
+        if (slots[k] != nullptr){
+            newSubtree = merge(newSubtree, slots[k]);
+            slots[k] = nullptr;
+        }
+    }
+    return newSubtree;
+}
+
+//rebuild
+//re-keys every order with the current priority function and rebuilds the heap in place
+void CQueue::rebuild(){
+    //if statement checks for bucket mode, every node is re-keyed and put back in the buckets
+    if (m_bucketMode){
+        CQUEUE_STAT(++m_stats.m_rebuilds;)
+        Node* list = m_buckets.takeAll();
+        for (Node* curr = list; curr != nullptr; curr = curr->m_right){
+            curr->m_priority = priorityOf(curr->m_order);
+        }
+        fillBuckets(list);
+        return;
+    }
+
+    //if statement checks for a DARY heap, which is re-keyed and rebuilt in the array
+    if (m_structure == DARY){
+        for (int i = 0; i < m_size; i++){
+            m_array[i].m_priority = priorityOf(m_array[i].m_order);
+        }
+        heapify();
+        return;
+    }
+
+    CQUEUE_STAT(++m_stats.m_rebuilds;) //a DARY rebuild is counted by heapify
+    Node* slots[MAXBUILDSLOTS] = {nullptr}; //slot k holds a heap built from 2^k orders
+    Node* curr = flatten(m_heap);
+
+    //while loop detaches each node, re-keys it, and adds it to the build
+    while (curr != nullptr){
+        Node* next = curr->m_right;
+        curr->m_right = nullptr;
+        curr->m_priority = priorityOf(curr->m_order);
+        curr->setNPL(1); //a lone node has a null path length of one
+        buildStep(slots, curr);
+        curr = next;
+    }
+
+    m_heap = buildFinish(slots);
+}
+
+//flatten
+//turns the tree into a list linked through m_right, every m_left is left as nullptr
+//left children are rotated up until there are none, so no stack and no allocation is needed
+Node* CQueue::flatten(Node* curr){
+    Node* head = nullptr; //first node of the list
+    Node** tail = &head;  //where the next node of the list is attached
+
+    //while loop walks the tree, rotating left children up until curr has none
+    while (curr != nullptr){
+        if (curr->m_left != nullptr){
+            //the left child moves above curr, leaving curr on its right
+            Node* left = curr->m_left;
+            curr->m_left = left->m_right;
+            left->m_right = curr;
+            curr = left;
+        }
+        else{
+            //curr has no left child, so it is added to the list
+            *tail = curr;
+            tail = &curr->m_right;
+            curr = curr->m_right;
+        }
+    }
+    return head;
+}
+
+//hasPriority
+//returns true if lhs belongs above rhs in a DARY heap
+bool CQueue::hasPriority(const DaryEntry& lhs, const DaryEntry& rhs) const{
+    if (m_heapType == MINHEAP){
+        return lhs.m_priority < rhs.m_priority;
+    }
+    else{
+        return lhs.m_priority > rhs.m_priority;
+    }
+}
+
+//siftUp
+//moves the entry at index up, parents are shifted down into the hole until the entry fits
+void CQueue::siftUp(int index){
+    DaryEntry entry = m_array[index];
+
+    //while loop runs until the root is reached or the parent has priority
+    while (index > 0){
+        int parent = (index - 1) / m_arity;
+        if (!hasPriority(entry, m_array[parent])){
+            break;
+        }
+        m_array[index] = m_array[parent];
+        index = parent;
+    }
+    m_array[index] = entry;
+}
+
+//siftDown
+//moves the entry at index down, the best child is shifted up into the hole until the entry fits
+void CQueue::siftDown(int index){
+    DaryEntry entry = m_array[index];
+
+    //while loop runs until the entry has no children
+    while (m_arity * index + 1 < m_size){
+        //best child found among the children of index
+        int first = m_arity * index + 1;
+        int last = ((first + m_arity < m_size) ? first + m_arity : m_size);
+        int best = first;
+        for (int child = first + 1; child < last; child++){
+            if (hasPriority(m_array[child], m_array[best])){
+                best = child;
+            }
+        }
+
+        //if the best child does not have priority over the entry, it stops here
+        if (!hasPriority(m_array[best], entry)){
+            break;
+        }
+        m_array[index] = m_array[best];
+        index = best;
+    }
+    m_array[index] = entry;
+}
+
+//heapify
+//bottom-up construction, every entry with children is sifted down starting from the last one
+void CQueue::heapify(){
+    //if statement checks if there is anything to sift, an empty array has no first entry
+    if (m_size < 2){
+        return;
+    }
+    CQUEUE_STAT(++m_stats.m_rebuilds;)
+    for (int i = (m_size - 2) / m_arity; i >= 0; i--){
+        siftDown(i);
+    }
+}
+
+//popEntry
+//removes the first entry, the last entry takes its place and is sifted down
+DaryEntry CQueue::popEntry(){
+    DaryEntry top = m_array[0];
+    m_array[0] = m_array[m_size - 1];
+    m_array.pop_back();
+    --m_size;
+    if (m_size > 0){
+        siftDown(0);
+    }
+    return top;
+}
+
+//eraseEntry
+//removes the entry at index, the last entry takes its place and is sifted whichever way it belongs
+void CQueue::eraseEntry(int index){
+    m_array[index] = m_array[m_size - 1];
+    m_array.pop_back();
+    --m_size;
+    if (index < m_size){
+        siftUp(index);
+        siftDown(index);
+    }
+}
+
+//arrayToTree
+//every entry is put into a lone node and the tree is built by pairwise merging
+void CQueue::arrayToTree(){
+    Node* slots[MAXBUILDSLOTS] = {nullptr}; //slot k holds a heap built from 2^k orders
+
+    for (int i = 0; i < m_size; i++){
+        Node* newNode = m_pool.acquire(m_array[i].m_order, m_array[i].m_priority);
+        newNode->setNPL(1); //a lone node has a null path length of one
+        buildStep(slots, newNode);
+    }
+
+    m_heap = buildFinish(slots);
+    m_array.clear();
+    rebuildIndex();
+}
+
+//treeToArray
+//every node is copied into the array then released, the array is not yet a heap
+void CQueue::treeToArray(){
+    m_array.reserve(m_size);
+    Node* curr = flatten(m_heap);
+
+    while (curr != nullptr){
+        Node* next = curr->m_right;
+        m_array.push_back(DaryEntry(curr->m_order, curr->m_priority));
+        m_pool.release(curr);
+        curr = next;
+    }
+    m_heap = nullptr;
+    m_index.clear(); //an array has no nodes to index
+}
+
+//preorderTraversal
+//prints out the items in the function by preorder traversal
+//an explicit stack replaces the recursion, so a skew heap of linear depth cannot overflow the call stack
+void CQueue::preorderTraversal(const Node* curr) const{
+    vector<const Node*> stack(1, curr);
+
+    //while loop runs until every node has been printed
+    while (!stack.empty()){
+        curr = stack.back();
+        stack.pop_back();
+
+        //if curr is a nullptr, that means that it will seg fault, so if statement checks for that
+        if (curr == nullptr){
+            continue;
+        }
+
+        //follows print parent first, then left child, then right child principle of preorde traversal
+        //the right child is pushed first so the left child comes off the stack first
+        cout << "[" << curr->m_priority << "] " << *curr << endl;
+        stack.push_back(curr->m_right);
+        stack.push_back(curr->m_left);
+    }
+}
+
+//arrayPreorderTraversal
+//prints out a DARY heap by preorder traversal, each entry then each of its children
+void CQueue::arrayPreorderTraversal(int index) const{
+    if (index < m_size){
+        cout << "[" << m_array[index].m_priority << "] " << m_array[index].m_order << endl;
+        for (int i = 1; i <= m_arity; i++){
+            arrayPreorderTraversal(m_arity * index + i);
+        }
+    }
+}
+
+//takeList
+//detaches every order of the structure as a list linked through m_right, with every m_left nullptr
+Node* CQueue::takeList(){
+    Node* list = nullptr;
+
+    //if statement checks for a DARY heap, a node is made for each entry from the back so the list keeps array order
+    if (m_structure == DARY){
+        for (int i = int(m_array.size()) - 1; i >= 0; i--){
+            Node* node = m_pool.acquire(m_array[i].m_order, m_array[i].m_priority);
+            indexNode(node);
+            node->m_right = list;
+            list = node;
+        }
+        m_array.clear();
+    }
+    else{
+        meldPending();
+        list = flatten(m_heap);
+        m_heap = nullptr;
+    }
+    return list;
+}
+
+//buildFromList
+//builds the structure from a list of keyed nodes, m_size must already count them
+void CQueue::buildFromList(Node* list){
+    //if statement checks for a DARY heap, every node is moved into the array then released
+    if (m_structure == DARY){
+        m_array.reserve(m_size);
+        while (list != nullptr){
+            Node* next = list->m_right;
+            m_array.push_back(DaryEntry(list->m_order, list->m_priority));
+            m_pool.release(list);
+            list = next;
+        }
+        m_index.clear(); //an array has no nodes to index
+        heapify();
+        return;
+    }
+
+    Node* slots[MAXBUILDSLOTS] = {nullptr}; //slot k holds a heap built from 2^k orders
+
+    //while loop detaches each node and adds it to the build
+    while (list != nullptr){
+        Node* next = list->m_right;
+        list->m_right = nullptr;
+        list->setNPL(1); //a lone node has a null path length of one
+        buildStep(slots, list);
+        list = next;
+    }
+
+    m_heap = merge(m_heap, buildFinish(slots));
+}
+
+//fillBuckets
+//moves a list of keyed nodes into the buckets, if a priority falls outside the range
+//the queue leaves bucket mode and every order is built into the structure instead
+void CQueue::fillBuckets(Node* list){
+    //while loop adds each node to the back of its bucket until one does not fit
+    while ((list != nullptr) && m_buckets.inRange(list->m_priority)){
+        Node* next = list->m_right;
+        m_buckets.push(list);
+        list = next;
+    }
+
+    //if statement checks if a node did not fit, if so the buckets are emptied onto the front of the list
+    if (list != nullptr){
+        Node* bucketed = m_buckets.takeAll();
+        if (bucketed != nullptr){
+            Node* tail = bucketed;
+            while (tail->m_right != nullptr){
+                tail = tail->m_right;
+            }
+            tail->m_right = list;
+            list = bucketed;
+        }
+        m_bucketMode = false;
+        buildFromList(list);
+    }
+}
+
+//leaveBucketMode
+//moves every order from the buckets back into the structure
+void CQueue::leaveBucketMode(){
+    Node* list = m_buckets.takeAll();
+    m_bucketMode = false;
+    buildFromList(list);
+}
+
+//hasPriority
+//returns true if node lhs belongs above node rhs, ties keep lhs on top
+bool CQueue::hasPriority(const Node* lhs, const Node* rhs) const{
+    return ((m_heapType == MINHEAP) ? HeapOrder<MINHEAP>::hasPriority(lhs, rhs) : HeapOrder<MAXHEAP>::hasPriority(lhs, rhs));
+}
+
+//meldBestPending
+//melds the pending heap with the best root into m_heap, one merge per removal pays down a lazy merge
+void CQueue::meldBestPending(){
+    int best = 0;
+    for (int i = 1; i < int(m_pending.size()); i++){
+        if (!hasPriority(m_pending[best], m_pending[i])){
+            best = i;
+        }
+    }
+    m_heap = merge(m_heap, m_pending[best]);
+    m_pending[best] = m_pending.back();
+    m_pending.pop_back();
+}
+
+//meldPending
+//melds every pending heap into m_heap
+void CQueue::meldPending(){
+    for (unsigned int i = 0; i < m_pending.size(); i++){
+        m_heap = merge(m_heap, m_pending[i]);
+    }
+    m_pending.clear();
+}
+
+//findNode
+//searches the tree, every pending heap and every bucket for a node holding the order ID,
+//and every other field of order if it is given, returns nullptr if there is none
+Node* CQueue::findNode(int orderID, const Order* order) const{
+    vector<Node*> stack(1, m_heap);
+    stack.insert(stack.end(), m_pending.begin(), m_pending.end());
+    if (m_bucketMode){
+        stack.insert(stack.end(), m_buckets.m_heads.begin(), m_buckets.m_heads.end());
+    }
+
+    //while loop visits every node once, a bucket is a list with no left links
+    while (!stack.empty()){
+        Node* curr = stack.back();
+        stack.pop_back();
+        if (curr == nullptr){
+            continue;
+        }
+        if ((curr->m_order.getOrderID() == orderID) && ((order == nullptr) || sameOrder(curr->m_order, *order))){
+            return curr;
+        }
+        stack.push_back(curr->m_left);
+        stack.push_back(curr->m_right);
+    }
+    return nullptr;
+}
+
+//findOrder
+//returns a node holding exactly order, found through the index if the queue keeps one, nullptr if there is none
+Node* CQueue::findOrder(const Order& order) const{
+    if (!m_indexed){
+        return findNode(order.getOrderID(), &order);
+    }
+    pair<unordered_multimap<int, Node*>::const_iterator, unordered_multimap<int, Node*>::const_iterator> found = m_index.equal_range(order.getOrderID());
+    for (unordered_multimap<int, Node*>::const_iterator curr = found.first; curr != found.second; ++curr){
+        if (sameOrder(curr->second->m_order, order)){
+            return curr->second;
+        }
+    }
+    return nullptr;
+}
+
+//sameOrder
+//returns true if every field of lhs matches rhs
+bool CQueue::sameOrder(const Order& lhs, const Order& rhs){
+    return (lhs.getItem() == rhs.getItem()) && (lhs.getCount() == rhs.getCount())
+        && (lhs.getMemebership() == rhs.getMemebership()) && (lhs.getPoints() == rhs.getPoints())
+        && (lhs.getCustomerID() == rhs.getCustomerID()) && (lhs.getOrderID() == rhs.getOrderID());
+}
+
+//indexNode
+//adds node to the index under its order ID, if the queue keeps an index
+void CQueue::indexNode(Node* node){
+    if (m_indexed){
+        m_index.insert(make_pair(node->m_order.getOrderID(), node));
+    }
+}
+
+//unindexNode
+//removes node from the index, other nodes with the same order ID are kept
+void CQueue::unindexNode(const Node* node){
+    if (!m_indexed){
+        return;
+    }
+
+    //for loop looks through the nodes filed under the order ID for this one
+    typedef unordered_multimap<int, Node*>::iterator IndexIt;
+    pair<IndexIt, IndexIt> range = m_index.equal_range(node->m_order.getOrderID());
+    for (IndexIt it = range.first; it != range.second; ++it){
+        if (it->second == node){
+            m_index.erase(it);
+            return;
+        }
+    }
+}
+
+//indexTree
+//adds every node of a tree, or of a list linked through m_right, to the index
+void CQueue::indexTree(Node* root){
+    if (!m_indexed){
+        return;
+    }
+
+    vector<Node*> stack(1, root);
+    while (!stack.empty()){
+        Node* curr = stack.back();
+        stack.pop_back();
+        if (curr != nullptr){
+            m_index.insert(make_pair(curr->m_order.getOrderID(), curr));
+            stack.push_back(curr->m_left);
+            stack.push_back(curr->m_right);
+        }
+    }
+}
+
+//indexQueue
+//adds every node of rhs to the index, copying the index of rhs if it has one instead of walking its nodes
+void CQueue::indexQueue(const CQueue& rhs){
+    if (!m_indexed){
+        return;
+    }
+    else if (rhs.m_indexed){
+        m_index.insert(rhs.m_index.begin(), rhs.m_index.end());
+        return;
+    }
+
+    //else every tree and bucket of rhs is walked
+    indexTree(rhs.m_heap);
+    for (unsigned int i = 0; i < rhs.m_pending.size(); i++){
+        indexTree(rhs.m_pending[i]);
+    }
+    if (rhs.m_bucketMode){
+        for (unsigned int i = 0; i < rhs.m_buckets.m_heads.size(); i++){
+            indexTree(rhs.m_buckets.m_heads[i]);
+        }
+    }
+}
+
+//rebuildIndex
+//empties the index and, if the queue keeps one, adds every node in the queue to it
+void CQueue::rebuildIndex(){
+    m_index.clear();
+    if (!m_indexed){
+        return;
+    }
+    m_index.reserve(m_size);
+
+    //the tree, every pending heap and every bucket are indexed
+    indexTree(m_heap);
+    for (unsigned int i = 0; i < m_pending.size(); i++){
+        indexTree(m_pending[i]);
+    }
+    if (m_bucketMode){
+        for (unsigned int i = 0; i < m_buckets.m_heads.size(); i++){
+            indexTree(m_buckets.m_heads[i]);
+        }
+    }
+}
+
+//logInserts
+//logs a bulk insertion as one record, if there is a log
+void CQueue::logInserts(const vector<Order>& orders){
+    if (m_log != nullptr){
+        m_log->logInserts(orders);
+    }
+}
+
+//logRemovals
+//logs count removals of the highest priority order as one record, if there is a log and count is positive
+void CQueue::logRemovals(int count){
+    if ((m_log != nullptr) && (count > 0)){
+        m_log->logNext(count);
+    }
+}
+
+//logSnapshot
+//logs every order and the layout as one record, if there is a log
+void CQueue::logSnapshot(){
+    if (m_log != nullptr){
+        m_log->logSnapshot(*this);
+    }
+}
+
+//loadRecords
+//replaces every order with the records of a snapshot, in one pass over them
+//returns false, leaving the queue empty, if the records do not fit the header
+bool CQueue::loadRecords(const SnapshotHeader& header, const SnapshotRecord records[]){
+    int64_t size = header.m_size;
+
+    //if statement checks the arity and the bucket range before anything is replaced
+    if (((header.m_arity != 2) && (header.m_arity != 4) && (header.m_arity != 8))
+            || ((header.m_bucketMode != 0) && ((header.m_maxPriority < header.m_minPriority)
+                || (static_cast<long long>(header.m_maxPriority) - header.m_minPriority >= MAXBUCKETS)))){
+        return false;
+    }
+
+    releaseAll();
+    m_arity = header.m_arity;
+    m_bucketMode = (header.m_bucketMode != 0);
+    m_size = static_cast<int>(size);
+    bool complete = true;
+
+    //if statements check where the orders were kept, each record is placed the same way
+    if (m_bucketMode){
+        m_buckets.setRange(header.m_minPriority, header.m_maxPriority);
+        for (int64_t i = 0; (i < size) && complete; i++){
+            complete = m_buckets.inRange(records[i].m_priority);
+            if (complete){
+                m_buckets.push(m_pool.acquire(records[i].m_order, records[i].m_priority));
+            }
+        }
+    }
+    else if (m_structure == DARY){
+        m_array.reserve(size);
+        for (int64_t i = 0; i < size; i++){
+            m_array.push_back(DaryEntry(records[i].m_order, records[i].m_priority));
+        }
+    }
+    else{
+        //the first tree is the heap, the rest are pending heaps
+        int64_t next = 0;
+        for (int i = 0; (i < header.m_numTrees) && complete; i++){
+            Node* root = loadTree(records, size, next);
+            complete = (root != nullptr);
+            if (i == 0){
+                m_heap = root;
+            }
+            else if (complete){
+                m_pending.push_back(root);
+            }
+        }
+        complete = complete && (next == size); //every record must belong to a tree
+    }
+
+    if (!complete){
+        releaseAll();
+        return false;
+    }
+    rebuildIndex();
+    return true;
+}
+
+//loadTree
+//rebuilds one tree from the records starting at next and moves next past it, in one pass with a stack
+//of the nodes whose right subtree is still to come, returns nullptr if the records run out first
+Node* CQueue::loadTree(const SnapshotRecord records[], int64_t size, int64_t& next){
+    Node* root = nullptr;
+    Node** hole = &root;       //where the next record is attached
+    Node* holeOwner = nullptr; //node the hole belongs to, the parent of whatever is attached
+    vector<Node*> stack;       //nodes with a right subtree that follows their left subtree
+
+    //while loop runs until the tree is complete or the records run out
+    while (next < size){
+        const SnapshotRecord& record = records[next++];
+        Node* node = m_pool.acquire(record.m_order, record.m_priority);
+        node->m_npl = record.m_npl;
+        node->m_parent = holeOwner;
+        *hole = node;
+
+        //if statements pick the next hole, the left subtree comes first, then the deepest right subtree still owed
+        if (record.m_links & SNAPLEFT){
+            if (record.m_links & SNAPRIGHT){
+                stack.push_back(node);
+            }
+            hole = &node->m_left;
+            holeOwner = node;
+        }
+        else if (record.m_links & SNAPRIGHT){
+            hole = &node->m_right;
+            holeOwner = node;
+        }
+        else if (!stack.empty()){
+            holeOwner = stack.back();
+            stack.pop_back();
+            hole = &holeOwner->m_right;
+        }
+        else{
+            return root;
+        }
+    }
+
+    //the records ran out with a subtree still owed, every link made so far is valid so the tree is released
+    m_pool.releaseTree(root);
+    return nullptr;
+}
+
+//bucketTraversal
+//prints every bucket from the highest priority down, each bucket front to back
+void CQueue::bucketTraversal(bool dumpFormat) const{
+    int numBuckets = int(m_buckets.m_heads.size());
+
+    //for loop visits the buckets in priority order, which depends on the heap type
+    for (int i = 0; i < numBuckets; i++){
+        int bucket = ((m_heapType == MINHEAP) ? i : numBuckets - 1 - i);
+        for (const Node* curr = m_buckets.m_heads[bucket]; curr != nullptr; curr = curr->m_right){
+            if (dumpFormat){
+                cout << "(" << curr->m_priority << ":" << curr->m_order.getPoints() << ")";
+            }
+            else{
+                cout << "[" << curr->m_priority << "] " << *curr << endl;
+            }
+        }
+    }
+}
+
+//NodePool constructor
+//creates an empty pool, the first slab is allocated on the first acquire
+NodePool::NodePool(){
+    m_freeList = nullptr;
+    m_freeTail = nullptr;
+    m_slabSize = MINSLABSIZE;
+    m_capacity = 0;
+    m_live = 0;
+    m_highWater = 0;
+    CQUEUE_STAT(m_acquired = 0;)
+    CQUEUE_STAT(m_grown = 0;)
+}
+
+//NodePool destructor
+//frees every slab, nodes handed out by the pool must not be used afterwards
+NodePool::~NodePool(){
+    for (unsigned int i = 0; i < m_slabs.size(); i++){
+        ::operator delete(m_slabs[i]);
+    }
+}
+
+//acquire
+//takes a node off the free list, growing the pool if the free list is empty
+Node* NodePool::acquire(const Order& order, int priority){
+    //if statement checks if the free list is empty, if so a new slab is allocated
+    if (m_freeList == nullptr){
+        grow();
+    }
+
+    Node* node = m_freeList;
+    m_freeList = m_freeList->m_right;
+    uint32_t serial = node->m_serial + 1; //the serial moves on, so handles to the last order it held are stale
+    new (node) Node(order, priority); //node rebuilt in place with the new order
+    node->m_serial = serial;
+
+    //live count and high water mark updated
+    CQUEUE_STAT(++m_acquired;)
+    ++m_live;
+    if (m_live > m_highWater){
+        m_highWater = m_live;
+    }
+    return node;
+}
+
+//release
+//puts a node back onto the free list
+void NodePool::release(Node* node){
+    //if statement checks if the free list is empty, if so node will stay at its end
+    if (m_freeList == nullptr){
+        m_freeTail = node;
+    }
+    node->m_left = nullptr;
+    node->m_right = m_freeList;
+    m_freeList = node;
+    ++node->m_serial; //handles to the order it held are stale from now on
+    --m_live;
+}
+
+//releaseChain
+//puts a chain of nodes linked through m_right back onto the free list in one step
+//each node's serial still moves on, a walk over the nodes the caller has just linked
+void NodePool::releaseChain(Node* head, Node* tail, int count){
+    for (Node* curr = head; curr != tail; curr = curr->m_right){
+        ++curr->m_serial;
+    }
+    ++tail->m_serial;
+    if (m_freeList == nullptr){
+        m_freeTail = tail;
+    }
+    tail->m_right = m_freeList;
+    m_freeList = head;
+    m_live -= count;
+}
+
+//adopt
+//takes over the slabs and free list of rhs, leaving rhs empty
+void NodePool::adopt(NodePool& rhs){
+    if (this == &rhs){
+        return;
+    }
+
+    //slabs moved over
+    m_slabs.insert(m_slabs.end(), rhs.m_slabs.begin(), rhs.m_slabs.end());
+    rhs.m_slabs.clear();
+
+    //free list of rhs is linked after the tail of this free list, so no list is walked
+    if (rhs.m_freeList != nullptr){
+        if (m_freeList == nullptr){
+            m_freeList = rhs.m_freeList;
+        }
+        else{
+            m_freeTail->m_right = rhs.m_freeList;
+        }
+        m_freeTail = rhs.m_freeTail;
+        rhs.m_freeList = nullptr;
+        rhs.m_freeTail = nullptr;
+    }
+
+    //counts combined, the high water mark includes the adopted nodes
+    m_capacity += rhs.m_capacity;
+    m_live += rhs.m_live;
+    if (m_live > m_highWater){
+        m_highWater = m_live;
+    }
+    rhs.m_capacity = 0;
+    rhs.m_live = 0;
+}
+
+//swap
+//exchanges every slab, free node and count with rhs in constant time
+void NodePool::swap(NodePool& rhs){
+    m_slabs.swap(rhs.m_slabs);
+    std::swap(m_freeList, rhs.m_freeList);
+    std::swap(m_freeTail, rhs.m_freeTail);
+    std::swap(m_slabSize, rhs.m_slabSize);
+    std::swap(m_capacity, rhs.m_capacity);
+    std::swap(m_live, rhs.m_live);
+    std::swap(m_highWater, rhs.m_highWater);
+}
+
+//releaseTree
+//returns every node of a tree to the pool without recursion or a stack
+//left children are rotated up like in flatten until curr has none, then curr is released
+//and the walk continues to its right, so every node is touched a constant number of times
+void NodePool::releaseTree(Node* curr){
+    //while loop runs until every node has been rotated onto the right spine and released
+    while (curr != nullptr){
+        if (curr->m_left != nullptr){
+            //the left child moves above curr, leaving curr on its right
+            Node* left = curr->m_left;
+            curr->m_left = left->m_right;
+            left->m_right = curr;
+            curr = left;
+        }
+        else{
+            Node* next = curr->m_right;
+            release(curr); //curr is returned to the pool
+            curr = next;
+        }
+    }
+}
+
+//copyTree
+//uses preorder traversal to copy a tree, the copy is made of nodes from this pool
+//each right spine is copied in a loop, and the left subtrees met on the way wait on an explicit
+//stack with the copied node they hang from, so a deep tree cannot overflow the call stack
+Node* NodePool::copyTree(const Node* rhsNode){
+    Node* newTree = nullptr; //root of the copy
+    vector<pair<const Node*, Node*> > stack; //left subtrees still to copy, with the copied node they hang from
+    if (rhsNode != nullptr){
+        stack.push_back(make_pair(rhsNode, static_cast<Node*>(nullptr)));
+    }
+
+    //while loop copies one right spine at a time until no left subtree is waiting
+    while (!stack.empty()){
+        rhsNode = stack.back().first;
+        Node* holeOwner = stack.back().second; //copied node the hole belongs to
+        Node** hole = ((holeOwner == nullptr) ? &newTree : &holeOwner->m_left); //where the next copied node is attached
+        stack.pop_back();
+
+        //while loop runs down the right spine of rhsNode until it runs out
+        while (rhsNode != nullptr){
+            //curr set to be a new node with the same info as rhsNode, NPL set to be the same
+            Node* curr = acquire(rhsNode->m_order, rhsNode->m_priority);
+            curr->m_npl = rhsNode->m_npl;
+
+            //curr is attached, and its left subtree waits to be copied under it
+            *hole = curr;
+            curr->m_parent = holeOwner;
+            if (rhsNode->m_left != nullptr){
+                stack.push_back(make_pair(rhsNode->m_left, curr));
+            }
+            hole = &curr->m_right;
+            holeOwner = curr;
+            rhsNode = rhsNode->m_right;
+        }
+        *hole = nullptr; //the last copied node ends the spine
+    }
+
+    return newTree; //newTree is returned
+}
+
+//numLive
+//returns the number of nodes currently handed out
+int NodePool::numLive() const{
+    return m_live;
+}
+
+//highWaterMark
+//returns the most nodes ever handed out at once
+int NodePool::highWaterMark() const{
+    return m_highWater;
+}
+
+//capacity
+//returns the number of nodes held in all slabs
+int NodePool::capacity() const{
+    return m_capacity;
+}
+
+//numAcquired
+//returns the number of nodes ever handed out by this pool, 0 unless built with CQUEUE_STATS
+long NodePool::numAcquired() const{
+#ifdef CQUEUE_STATS
+    return m_acquired;
+#else
+    return 0;
+#endif
+}
+
+//numSlabs
+//returns the number of slabs ever allocated by this pool, 0 unless built with CQUEUE_STATS
+long NodePool::numSlabs() const{
+#ifdef CQUEUE_STATS
+    return m_grown;
+#else
+    return 0;
+#endif
+}
+
+//grow
+//allocates a new slab, each slab doubles in size until MAXSLABSIZE
+void NodePool::grow(){
+    Node* slab = static_cast<Node*>(::operator new(sizeof(Node) * m_slabSize));
+    m_slabs.push_back(slab);
+    CQUEUE_STAT(++m_grown;)
+    if (m_freeList == nullptr){
+        m_freeTail = &slab[m_slabSize - 1]; //the last node of the slab ends up at the end of the list
+    }
+
+    //every node in the slab is constructed and linked onto the free list
+    for (int i = m_slabSize - 1; i >= 0; i--){
+        Node* node = new (&slab[i]) Node(Order());
+        node->m_right = m_freeList;
+        m_freeList = node;
+    }
+
+    m_capacity += m_slabSize;
+    if (m_slabSize < MAXSLABSIZE){
+        m_slabSize *= 2;
+    }
+}
+
+//BucketQueue constructor
+//creates a bucket queue with no range, setRange must be called before use
+BucketQueue::BucketQueue(){
+    m_minPriority = 0;
+    m_maxPriority = -1;
+}
+
+//setRange
+//allocates one empty bucket per priority in [minPriority, maxPriority]
+void BucketQueue::setRange(int minPriority, int maxPriority){
+    int numBuckets = maxPriority - minPriority + 1;
+    int numWords = (numBuckets + 63) / 64;
+
+    m_minPriority = minPriority;
+    m_maxPriority = maxPriority;
+    m_heads.assign(numBuckets, nullptr);
+    m_tails.assign(numBuckets, nullptr);
+    m_words.assign(numWords, 0);
+    m_summary.assign((numWords + 63) / 64, 0);
+}
+
+//inRange
+//returns true if priority has a bucket
+bool BucketQueue::inRange(int priority) const{
+    return (priority >= m_minPriority) && (priority <= m_maxPriority);
+}
+
+//push
+//adds node to the back of the bucket for its cached priority, which must be in range
+void BucketQueue::push(Node* node){
+    int bucket = node->m_priority - m_minPriority;
+    node->m_right = nullptr;
+    node->m_parent = m_tails[bucket]; //the old tail, nullptr if the bucket is empty
+
+    //if statement checks if the bucket is empty, if so node starts it, else node follows the tail
+    if (m_heads[bucket] == nullptr){
+        m_heads[bucket] = node;
+        markFull(bucket);
+    }
+    else{
+        m_tails[bucket]->m_right = node;
+    }
+    m_tails[bucket] = node;
+}
+
+//pop
+//detaches the front node of the lowest (MINHEAP) or highest (MAXHEAP) non-empty bucket
+Node* BucketQueue::pop(HEAPTYPE heapType){
+    int bucket = bestBucket(heapType);
+
+    //the front node is detached, and the bucket is marked empty if it was the last one
+    Node* node = m_heads[bucket];
+    m_heads[bucket] = node->m_right;
+    if (m_heads[bucket] == nullptr){
+        m_tails[bucket] = nullptr;
+        markEmpty(bucket);
+    }
+    else{
+        m_heads[bucket]->m_parent = nullptr;
+    }
+    node->m_right = nullptr;
+    return node;
+}
+
+//remove
+//detaches node from anywhere in the bucket for its cached priority, through its link back to the previous node
+void BucketQueue::remove(Node* node){
+    int bucket = node->m_priority - m_minPriority;
+    Node* prev = node->m_parent;
+    Node* next = node->m_right;
+
+    //the previous node, or the head, skips node, and the next node, or the tail, points back past it
+    if (prev == nullptr){
+        m_heads[bucket] = next;
+    }
+    else{
+        prev->m_right = next;
+    }
+    if (next == nullptr){
+        m_tails[bucket] = prev;
+    }
+    else{
+        next->m_parent = prev;
+    }
+
+    //if statement checks if node was the last one, if so the bucket is marked empty
+    if (m_heads[bucket] == nullptr){
+        markEmpty(bucket);
+    }
+    node->m_right = nullptr;
+    node->m_parent = nullptr;
+}
+
+//front
+//returns the front node of the lowest (MINHEAP) or highest (MAXHEAP) non-empty bucket
+const Node* BucketQueue::front(HEAPTYPE heapType) const{
+    return m_heads[bestBucket(heapType)];
+}
+
+//peek
+//appends the orders of up to k nodes to orders, lowest (MINHEAP) or highest (MAXHEAP) bucket first
+//the bitmap is walked a word at a time, so empty buckets are skipped without being visited
+void BucketQueue::peek(HEAPTYPE heapType, int k, vector<Order>& orders) const{
+    int numWords = int(m_words.size());
+    int numTaken = 0;
+
+    //for loop visits the words in priority order, then the set bits of each word in priority order
+    for (int i = 0; (i < numWords) && (numTaken < k); i++){
+        int word = ((heapType == MINHEAP) ? i : numWords - 1 - i);
+        uint64_t bits = m_words[word];
+        while ((bits != 0) && (numTaken < k)){
+            int bit = ((heapType == MINHEAP) ? __builtin_ctzll(bits) : 63 - __builtin_clzll(bits));
+            bits &= ~(uint64_t(1) << bit);
+            for (const Node* curr = m_heads[64 * word + bit]; (curr != nullptr) && (numTaken < k); curr = curr->m_right){
+                orders.push_back(curr->m_order);
+                ++numTaken;
+            }
+        }
+    }
+}
+
+//bestBucket
+//finds the lowest (MINHEAP) or highest (MAXHEAP) non-empty bucket, at least one must exist
+//the bitmap is searched a word at a time, so no empty bucket is ever visited
+int BucketQueue::bestBucket(HEAPTYPE heapType) const{
+    int numSummary = int(m_summary.size());
+    int word = 0;
+
+    //if statement checks for a MINHEAP, which takes the lowest set bit, else the highest set bit
+    if (heapType == MINHEAP){
+        int s = 0;
+        while (m_summary[s] == 0){
+            ++s;
+        }
+        word = 64 * s + __builtin_ctzll(m_summary[s]);
+    }
+    else{
+        int s = numSummary - 1;
+        while (m_summary[s] == 0){
+            --s;
+        }
+        word = 64 * s + 63 - __builtin_clzll(m_summary[s]);
+    }
+    return 64 * word + ((heapType == MINHEAP) ? __builtin_ctzll(m_words[word]) : 63 - __builtin_clzll(m_words[word]));
+}
+
+//append
+//moves every node of rhs, which must have the same range, onto the back of the matching bucket
+void BucketQueue::append(BucketQueue& rhs){
+    //for loop visits only the non-empty buckets of rhs through its bitmap
+    for (int w = 0; w < int(rhs.m_words.size()); w++){
+        uint64_t bits = rhs.m_words[w];
+        while (bits != 0){
+            int bucket = 64 * w + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            //the rhs list is linked after the tail of this bucket
+            if (m_heads[bucket] == nullptr){
+                m_heads[bucket] = rhs.m_heads[bucket];
+                markFull(bucket);
+            }
+            else{
+                m_tails[bucket]->m_right = rhs.m_heads[bucket];
+                rhs.m_heads[bucket]->m_parent = m_tails[bucket];
+            }
+            m_tails[bucket] = rhs.m_tails[bucket];
+            rhs.m_heads[bucket] = nullptr;
+            rhs.m_tails[bucket] = nullptr;
+        }
+        rhs.m_words[w] = 0;
+    }
+    rhs.m_summary.assign(rhs.m_summary.size(), 0);
+}
+
+//takeAll
+//detaches every node, lowest priority bucket first and each bucket front to back, and empties the buckets
+Node* BucketQueue::takeAll(){
+    Node* list = nullptr;
+    Node* tail = nullptr;
+
+    //for loop visits only the non-empty buckets through the bitmap
+    for (int w = 0; w < int(m_words.size()); w++){
+        uint64_t bits = m_words[w];
+        while (bits != 0){
+            int bucket = 64 * w + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            //the bucket is linked after the list built so far
+            if (list == nullptr){
+                list = m_heads[bucket];
+            }
+            else{
+                tail->m_right = m_heads[bucket];
+            }
+            tail = m_tails[bucket];
+            m_heads[bucket] = nullptr;
+            m_tails[bucket] = nullptr;
+        }
+        m_words[w] = 0;
+    }
+    m_summary.assign(m_summary.size(), 0);
+    return list;
+}
+
+//swap
+//exchanges every bucket and the range with rhs
+void BucketQueue::swap(BucketQueue& rhs){
+    m_heads.swap(rhs.m_heads);
+    m_tails.swap(rhs.m_tails);
+    m_words.swap(rhs.m_words);
+    m_summary.swap(rhs.m_summary);
+    std::swap(m_minPriority, rhs.m_minPriority);
+    std::swap(m_maxPriority, rhs.m_maxPriority);
+}
+
+//getMinPriority
+//returns the priority kept in the first bucket
+int BucketQueue::getMinPriority() const{
+    return m_minPriority;
+}
+
+//getMaxPriority
+//returns the priority kept in the last bucket
+int BucketQueue::getMaxPriority() const{
+    return m_maxPriority;
+}
+
+//markFull
+//sets the bit of a bucket that was empty, and the summary bit of its word
+void BucketQueue::markFull(int bucket){
+    int word = bucket / 64;
+    if (m_words[word] == 0){
+        m_summary[word / 64] |= (uint64_t(1) << (word % 64));
+    }
+    m_words[word] |= (uint64_t(1) << (bucket % 64));
+}
+
+//markEmpty
+//clears the bit of a bucket that is now empty, and the summary bit if its word is now zero
+void BucketQueue::markEmpty(int bucket){
+    int word = bucket / 64;
+    m_words[word] &= ~(uint64_t(1) << (bucket % 64));
+    if (m_words[word] == 0){
+        m_summary[word / 64] &= ~(uint64_t(1) << (word % 64));
+    }
+}
+
+//LatencyHistogram constructor
+//creates a histogram with every bucket empty
+LatencyHistogram::LatencyHistogram(){
+    for (int i = 0; i < LATENCYBUCKETS; i++){
+        m_counts[i] = 0;
+    }
+}
+
+//record
+//counts one operation in the bucket of the highest set bit of its latency, zero goes in the first
+void LatencyHistogram::record(long nanoseconds){
+    int bucket = ((nanoseconds > 1) ? 63 - __builtin_clzll(static_cast<unsigned long long>(nanoseconds)) : 0);
+    ++m_counts[(bucket < LATENCYBUCKETS) ? bucket : LATENCYBUCKETS - 1];
+}
+
+//count
+//returns the number of operations recorded in every bucket
+long LatencyHistogram::count() const{
+    long total = 0;
+    for (int i = 0; i < LATENCYBUCKETS; i++){
+        total += m_counts[i];
+    }
+    return total;
+}
+
+//bucketCount
+//returns the number of operations in one bucket, 0 for a bucket out of range
+long LatencyHistogram::bucketCount(int bucket) const{
+    return ((bucket >= 0) && (bucket < LATENCYBUCKETS)) ? m_counts[bucket] : 0;
+}
+
+//percentile
+//walks the buckets until the fraction of the operations is reached and returns that bucket's upper bound
+long LatencyHistogram::percentile(double fraction) const{
+    long total = count();
+    if (total == 0){
+        return 0;
+    }
+
+    //the rank of the operation wanted, at least the first
+    long rank = static_cast<long>(fraction * total + 0.5);
+    rank = ((rank < 1) ? 1 : ((rank > total) ? total : rank));
+    long seen = 0;
+    for (int i = 0; i < LATENCYBUCKETS; i++){
+        seen += m_counts[i];
+        if (seen >= rank){
+            return 2L << i;
+        }
+    }
+    return 2L << (LATENCYBUCKETS - 1);
+}
+
+//QueueStats constructor
+//creates counters that are all zero
+QueueStats::QueueStats()
+    : m_merges(0), m_spineNodes(0), m_maxSpine(0), m_spine(0), m_priorityCalls(0),
+      m_allocations(0), m_slabs(0), m_nplSwaps(0), m_rebuilds(0){
+}
+
+//enabled
+//returns true if this file was built with CQUEUE_STATS, every file must agree
+bool QueueStats::enabled(){
+#ifdef CQUEUE_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+//getMerges
+//returns the number of merges of two heaps
+long QueueStats::getMerges() const{
+    return m_merges;
+}
+
+//getSpineNodes
+//returns the number of nodes every merge took off the right spines
+long QueueStats::getSpineNodes() const{
+    return m_spineNodes;
+}
+
+//getMaxSpine
+//returns the most nodes one merge took off the right spines
+long QueueStats::getMaxSpine() const{
+    return m_maxSpine;
+}
+
+//getPriorityCalls
+//returns the number of calls to the priority function
+long QueueStats::getPriorityCalls() const{
+    return m_priorityCalls;
+}
+
+//getAllocations
+//returns the number of nodes the pool handed out
+long QueueStats::getAllocations() const{
+    return m_allocations;
+}
+
+//getSlabs
+//returns the number of slabs the pool allocated
+long QueueStats::getSlabs() const{
+    return m_slabs;
+}
+
+//getNPLSwaps
+//returns the number of child swaps that restored the leftist property
+long QueueStats::getNPLSwaps() const{
+    return m_nplSwaps;
+}
+
+//getRebuilds
+//returns the number of whole heap rebuilds and heapifies
+long QueueStats::getRebuilds() const{
+    return m_rebuilds;
+}
+
+//getInsertLatency
+//returns the latencies of insertOrder
+const LatencyHistogram& QueueStats::getInsertLatency() const{
+    return m_insertLatency;
+}
+
+//getNextLatency
+//returns the latencies of getNextOrder
+const LatencyHistogram& QueueStats::getNextLatency() const{
+    return m_nextLatency;
+}
+
+//getMergeLatency
+//returns the latencies of mergeWithQueue
+const LatencyHistogram& QueueStats::getMergeLatency() const{
+    return m_mergeLatency;
+}
+
+//exportCSV
+//writes one name,value line per counter, then for each histogram its count, median and 99th
+//percentile, and one line per non-empty bucket named by the bucket's upper bound
+void QueueStats::exportCSV(ostream& out) const{
+    out << "merges," << m_merges << "\n"
+        << "spine_nodes," << m_spineNodes << "\n"
+        << "max_spine," << m_maxSpine << "\n"
+        << "priority_calls," << m_priorityCalls << "\n"
+        << "allocations," << m_allocations << "\n"
+        << "slabs," << m_slabs << "\n"
+        << "npl_swaps," << m_nplSwaps << "\n"
+        << "rebuilds," << m_rebuilds << "\n";
+
+    const char* names[] = {"insertOrder", "getNextOrder", "mergeWithQueue"};
+    const LatencyHistogram* histograms[] = {&m_insertLatency, &m_nextLatency, &m_mergeLatency};
+    for (int h = 0; h < 3; h++){
+        out << names[h] << "_count," << histograms[h]->count() << "\n"
+            << names[h] << "_p50_ns," << histograms[h]->percentile(0.5) << "\n"
+            << names[h] << "_p99_ns," << histograms[h]->percentile(0.99) << "\n";
+        for (int i = 0; i < LATENCYBUCKETS; i++){
+            if (histograms[h]->bucketCount(i) > 0){
+                out << names[h] << "_le_" << (2L << i) << "_ns," << histograms[h]->bucketCount(i) << "\n";
+            }
+        }
+    }
+}
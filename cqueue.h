@@ -4,11 +4,23 @@
 #include <stdexcept>
 #include <iostream>
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include <cstdint>
+#ifdef CQUEUE_STATS
+#include <chrono>
+#endif
 using namespace std;
 class Grader;   // forward declaration (for grading purposes)
 class Tester;   // forward declaration
 class CQueue;   // forward declaration
 class Order;    // forward declaration
+class NodePool; // forward declaration
+class BucketQueue; // forward declaration
+class OrderHandle; // forward declaration
+class OrderLog; // forward declaration
+class QueueStats; // forward declaration
 #define EMPTY Order("",1,0)
 const int MINCUSTID = 100001;// minimum customer ID
 const int MAXCUSTID = 999999;// maximum customer ID
@@ -20,9 +32,35 @@ enum ITEM {COFFEE, LATTE, SOFTDRINK, MILK, WATER, ICEDTEA};// use with MinHeap
 enum COUNT {ONE, PAIR, HALFDOZEN, DOZEN};// use with MaxHeap
 const int MINPOINTS = 0; // the points colleted so far, use with MaxHeap
 const int MAXPOINTS = 5000; // the points colleted so far, use with MaxHeap
+const int MINSLABSIZE = 64; // nodes in the first slab of a NodePool
+const int MAXSLABSIZE = 4096; // slabs stop doubling at this many nodes
+const int MAXBUILDSLOTS = 32; // slot k holds a heap of 2^k orders during a bulk build
+const int DEFAULTARITY = 4; // children per node of a DARY heap, may be 2, 4 or 8
+const int MAXBUCKETS = 65536; // widest priority range a queue can keep in buckets
+const int IDBITS = 20; // bits for a customer or order ID in a packed Order, up to 1048575
+const int POINTSBITS = 13; // bits for the points in a packed Order, up to 8191
+const int MEMBERSHIPBITS = 3; // bits for the membership tier in a packed Order
+const int ITEMBITS = 3; // bits for the item in a packed Order
+const int COUNTBITS = 2; // bits for the count in a packed Order
+const int NPLBITS = 8; // bits for the null path length of a Node
+const int SERIALBITS = 24; // bits for the serial of a Node, checked by its OrderHandles
+const uint32_t SNAPSHOTMAGIC = 0x50414E53; // the bytes "SNAP" at the start of every snapshot file
+const uint32_t SNAPSHOTVERSION = 1; // raised whenever the snapshot layout changes
+const int SNAPSHOTBUFFER = 4096; // records written to a snapshot file at a time
+const int SNAPLEFT = 1;  // a snapshot record is followed by its left subtree
+const int SNAPRIGHT = 2; // a snapshot record is followed by its right subtree
+const int LATENCYBUCKETS = 40; // bucket b of a latency histogram counts operations of [2^b, 2^(b+1)) nanoseconds
+
+// building every file with -DCQUEUE_STATS makes each CQueue count its work and time its operations;
+// without it CQUEUE_STAT(...) expands to nothing, and a queue carries no counters at all
+#ifdef CQUEUE_STATS
+#define CQUEUE_STAT(statement) statement
+#else
+#define CQUEUE_STAT(statement)
+#endif
 
 enum HEAPTYPE {MINHEAP, MAXHEAP};
-enum STRUCTURE {SKEW, LEFTIST};
+enum STRUCTURE {SKEW, LEFTIST, DARY, PAIRING};
 // Priority function pointer type
 typedef int (*prifn_t)(const Order&);
 
@@ -32,40 +70,30 @@ class Order{
     friend class Grader; // for grading purposes
     friend class Tester; // for testing purposes
     friend class CQueue;
+    // An out of range error is thrown for a value that is negative or too wide for its field
     Order(ITEM item = COFFEE, COUNT count = ONE, 
             MEMBERSHIP membership = TIER5, int points = 0, 
             int customerID = 0, int orderID = 0)
     {
-        m_item = item; m_count = count; m_membership = membership;
-        m_points = points; m_customerID = customerID; m_orderID = orderID;
-    }
-    ITEM getItem() const {return m_item;}
-    int getOrderID() const {return m_orderID;}
-    COUNT getCount() const {return m_count;}
-    int getCustomerID() const {return m_customerID;}
-    MEMBERSHIP getMemebership() const {return m_membership;}
-    int getPoints() const {return m_points;}
-    void setItem(ITEM item){m_item=item;}
-    void setOrderID(int id){m_orderID=id;}
-    void setCount(COUNT count){m_count=count;}
-    void setCustomerID(int id){m_customerID=id;}
-    void setMembership(MEMBERSHIP membership){m_membership=membership;}
-    void setPoints(int points){m_points=points;}
-    // Overloaded assignment operator
-    const Order& operator=(const Order& rhs){
-        if (this != &rhs){
-            m_item = rhs.m_item;
-            m_count = rhs.m_count;
-            m_membership = rhs.m_membership;
-            m_points = rhs.m_points;
-            m_customerID = rhs.m_customerID;
-            m_orderID = rhs.m_orderID;
-        }
-        return *this;
+        m_item = field(item, ITEMBITS); m_count = field(count, COUNTBITS); m_membership = field(membership, MEMBERSHIPBITS);
+        m_points = field(points, POINTSBITS); m_customerID = field(customerID, IDBITS); m_orderID = field(orderID, IDBITS);
     }
+    ITEM getItem() const {return static_cast<ITEM>(m_item);}
+    int getOrderID() const {return static_cast<int>(m_orderID);}
+    COUNT getCount() const {return static_cast<COUNT>(m_count);}
+    int getCustomerID() const {return static_cast<int>(m_customerID);}
+    MEMBERSHIP getMemebership() const {return static_cast<MEMBERSHIP>(m_membership);}
+    int getPoints() const {return static_cast<int>(m_points);}
+    // Each setter throws out_of_range, leaving the order unchanged, for a value its field cannot hold
+    void setItem(ITEM item){m_item=field(item, ITEMBITS);}
+    void setOrderID(int id){m_orderID=field(id, IDBITS);}
+    void setCount(COUNT count){m_count=field(count, COUNTBITS);}
+    void setCustomerID(int id){m_customerID=field(id, IDBITS);}
+    void setMembership(MEMBERSHIP membership){m_membership=field(membership, MEMBERSHIPBITS);}
+    void setPoints(int points){m_points=field(points, POINTSBITS);}
     string getTierString() const {
         string result = "UNKNOWN";
-        switch (m_membership)
+        switch (getMemebership())
         {
         case TIER1: result = "Tier 1"; break;
         case TIER2: result = "Tier 2"; break;
@@ -79,7 +107,7 @@ class Order{
     }
     string getItemString() const {
         string result = "UNKNOWN";
-        switch (m_item)
+        switch (getItem())
         {
         case COFFEE: result = "Coffee"; break;
         case LATTE: result = "Latte"; break;
@@ -93,7 +121,7 @@ class Order{
     }
     string getCountString() const {
         string result = "UNKNOWN";
-        switch (m_count)
+        switch (getCount())
         {
         case ONE: result = "1"; break;
         case PAIR: result = "2"; break;
@@ -107,28 +135,55 @@ class Order{
     friend ostream& operator<<(ostream& sout, const Order &order );
     
     private:
-    int m_customerID;// a unique ID number identifying the customer
-    int m_orderID;   // a unique ID number identifying the order
+    // every field is packed into one 64-bit word, each only as wide as its range needs;
+    // a value too wide for its field is refused rather than cut to its low bits
+    uint64_t m_customerID : IDBITS;// a unique ID number identifying the customer
+    uint64_t m_orderID : IDBITS;   // a unique ID number identifying the order
     // data to be used for priority calculation
-    int m_points;   // points collected by customer
-    MEMBERSHIP m_membership; // the customer membership tier
-    ITEM m_item;    // the ordered item
-    COUNT m_count;  // the count of ordered item
-      
+    uint64_t m_points : POINTSBITS; // points collected by customer
+    uint64_t m_membership : MEMBERSHIPBITS; // the customer membership tier
+    uint64_t m_item : ITEMBITS;    // the ordered item
+    uint64_t m_count : COUNTBITS;  // the count of ordered item
+
+    //returns value if a field of bits bits holds it, otherwise throws out_of_range
+    static uint64_t field(int value, int bits){
+        if ((value < 0) || (value >= (1 << bits))){
+            throw out_of_range("Out of Range");
+        }
+        return static_cast<uint64_t>(value);
+    }
 };
+// orders are copied in and out of nodes on every operation, so they must stay plain data
+static_assert(is_trivially_copyable<Order>::value, "Order must be trivially copyable");
+// the packed fields must hold every valid value and still fit in one word
+static_assert((MAXORDERID < (1 << IDBITS)) && (MAXCUSTID < (1 << IDBITS)) && (MAXPOINTS < (1 << POINTSBITS)), "Order fields are too narrow");
+static_assert(sizeof(Order) == sizeof(uint64_t), "Order must pack into one 64-bit word");
 class Node{
-    // this is a node in the skew/leftist heap
+    // this is a node in the skew/leftist/pairing heap
+    // a pairing heap keeps its first child in m_left and its next sibling in m_right
+    // m_parent points back to whichever node links to this one, so a node can be cut out
     public:
     friend class Grader; // for grading purposes
     friend class Tester; // for testing purposes
     friend class CQueue;
-    Node(Order order) {  
+    friend class NodePool;
+    friend class BucketQueue;
+    template <HEAPTYPE heapType, STRUCTURE structure> friend class MergeEngine;
+    template <class Engine> friend class NodeHeap;
+    friend class NodeLinks;
+    friend class OrderHandle;
+    template <class PriorityFn, HEAPTYPE heapType, STRUCTURE structure> friend class BasicCQueue;
+    Node(Order order, int priority = 0) {  
         m_order = order;
         m_right = nullptr;
         m_left = nullptr;
+        m_parent = nullptr;
         m_npl = 0;
+        m_priority = priority;
+        m_serial = 0;
     }
     Order getOrder() const {return m_order;}
+    int getPriority() const {return m_priority;}
     void setNPL(int npl) {m_npl = npl;}
     int getNPL() const {return m_npl;}
     // Overloaded insertion operator
@@ -136,22 +191,653 @@ class Node{
 
     private:
     Order m_order;    // order information
-    Node * m_right;   // right child
-    Node * m_left;    // left child
-    int m_npl;        // null path length for leftist heap
+    Node * m_right;   // right child, or next sibling in a pairing heap
+    Node * m_left;    // left child, or first child in a pairing heap
+    Node * m_parent;  // parent, or previous sibling in a pairing heap or bucket, nullptr at a root or front
+    int m_priority;   // priority of m_order, computed once by the owning queue
+    // the NPL and the serial share a word so a node stays 40 bytes; an NPL is at most
+    // log2 of the size plus one, and a serial wraps only after 2^24 reuses of one node
+    uint32_t m_npl : NPLBITS;       // null path length for leftist heap
+    uint32_t m_serial : SERIALBITS; // moved on each time the pool hands the node out or takes it back, kept by its handles
+};
+class OrderHandle{
+    // refers to one queued order so updateOrder can find its node without a search;
+    // a handle stays valid until its order is removed or the queue is cleared, and
+    // follows its order through setPriorityFn, bucket mode and mergeWithQueue;
+    // an order kept in a DARY array has no node, so its handle is empty, and
+    // handles are lost when the orders move into the array; a handle keeps the
+    // serial its node had, so one whose order was removed is known to be stale
+    // while the queue lives
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class CQueue;
+    friend class OrderLog;
+    OrderHandle() : m_node(nullptr) {}
+    bool isEmpty() const {return m_node == nullptr;}
+    // Return true if the handle is not empty and its order is still queued
+    bool isValid() const {return (m_node != nullptr) && (m_node->m_serial == m_serial);}
+    // Return the order, throws invalid_argument if the handle is empty and domain_error if it is stale
+    Order getOrder() const {
+        if (m_node == nullptr){
+            throw invalid_argument("Invalid argument");
+        }
+        else if (m_node->m_serial != m_serial){
+            throw domain_error("Domain error");
+        }
+        return m_node->getOrder();
+    }
+
+    private:
+    explicit OrderHandle(Node* node) : m_node(node), m_serial(node->m_serial) {}
+    Node * m_node;     // node holding the order
+    uint32_t m_serial; // serial of m_node when the handle was made
+};
+class DaryEntry{
+    // this is an element stored directly in the array of a d-ary heap
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class CQueue;
+    DaryEntry(Order order = Order(), int priority = 0) {
+        m_order = order;
+        m_priority = priority;
+    }
+    Order getOrder() const {return m_order;}
+    int getPriority() const {return m_priority;}
+
+    private:
+    Order m_order;    // order information
+    int m_priority;   // priority of m_order, computed once by the owning queue
+};
+class SnapshotHeader{
+    // start of a snapshot file, describing the queue its records came from;
+    // the records follow directly and are mapped back without being parsed,
+    // so a file is only read on a machine with the same byte order
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class CQueue;
+    friend class OrderLog;
+
+    private:
+    uint32_t m_magic;      // SNAPSHOTMAGIC
+    uint32_t m_version;    // SNAPSHOTVERSION
+    uint32_t m_recordSize; // size of one SnapshotRecord when the file was written
+    int32_t m_heapType;    // heap type of the saved queue
+    int32_t m_structure;   // structure of the saved queue
+    int32_t m_arity;       // arity of the saved queue
+    int32_t m_bucketMode;  // nonzero if the records are buckets instead of trees
+    int32_t m_minPriority; // lowest priority with a bucket, only used in bucket mode
+    int32_t m_maxPriority; // highest priority with a bucket, only used in bucket mode
+    int32_t m_numTrees;    // trees stored one after another, m_heap first then each pending heap
+    int64_t m_size;        // number of records that follow
+};
+class SnapshotRecord{
+    // one order of a snapshot file; the trees are stored in preorder, and the
+    // links say which subtrees follow, so the shape is rebuilt without any search
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class CQueue;
+
+    private:
+    Order m_order;      // order information
+    int32_t m_priority; // cached priority, trusted when the file is loaded
+    uint8_t m_links;    // SNAPLEFT and SNAPRIGHT, the subtrees that follow in preorder
+    uint8_t m_npl;      // null path length for leftist heap
+    uint16_t m_unused;  // padding, written as zero
+};
+// snapshot files are mapped straight into memory, so their layout must be fixed
+static_assert(is_trivially_copyable<SnapshotRecord>::value && (sizeof(SnapshotRecord) == 16), "SnapshotRecord must be 16 bytes of plain data");
+static_assert(is_trivially_copyable<SnapshotHeader>::value && (sizeof(SnapshotHeader) == 48), "SnapshotHeader must be 48 bytes of plain data");
+class NodePool{
+    // hands out nodes carved from large slabs and recycles freed nodes
+    // through a free list, so steady-state churn never reaches the heap allocator
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+
+    NodePool();
+    ~NodePool();
+    NodePool(const NodePool& rhs) = delete;
+    NodePool& operator=(const NodePool& rhs) = delete;
+    Node* acquire(const Order& order, int priority); // Return a fresh node holding order
+    void release(Node* node); // Return node to the free list
+    // Return count nodes, linked from head to tail through m_right, to the free list
+    void releaseChain(Node* head, Node* tail, int count);
+    void adopt(NodePool& rhs); // Take over every slab and free node of rhs
+    void swap(NodePool& rhs); // Exchange every slab and free node with rhs
+    void releaseTree(Node* curr); // Return every node of the tree to the free list
+    Node* copyTree(const Node* rhsNode); // Return a copy of the tree made from this pool
+    int numLive() const; // Return number of nodes currently handed out
+    int highWaterMark() const; // Return the most nodes ever handed out at once
+    int capacity() const; // Return number of nodes held in slabs
+    long numAcquired() const; // Return number of nodes ever handed out, 0 unless built with CQUEUE_STATS
+    long numSlabs() const; // Return number of slabs ever allocated, 0 unless built with CQUEUE_STATS
+
+    private:
+    vector<Node*> m_slabs;  // every slab allocated by (or adopted into) the pool
+    Node * m_freeList;      // free nodes, linked through m_right
+    Node * m_freeTail;      // last node of m_freeList, only valid while the list is not empty
+    int m_slabSize;         // number of nodes in the next slab
+    int m_capacity;         // total number of nodes in all slabs
+    int m_live;             // number of nodes currently handed out
+    int m_highWater;        // the most nodes ever handed out at once
+    CQUEUE_STAT(long m_acquired;) // nodes ever handed out, never moved to another pool
+    CQUEUE_STAT(long m_grown;)    // slabs ever allocated, never moved to another pool
+
+    void grow(); // allocates a new slab and adds it to the free list
+};
+class BucketQueue{
+    // one FIFO list of nodes per priority in a small declared range, linked
+    // through m_right; a two-level bitmap of the non-empty lists finds the
+    // next priority with a couple of bit scans instead of a tree walk
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class CQueue;
+
+    BucketQueue();
+    void setRange(int minPriority, int maxPriority); // Set the range, the buckets must be empty
+    bool inRange(int priority) const; // Return true if priority has a bucket
+    void push(Node* node); // Add node to the back of the bucket for its priority
+    void remove(Node* node); // Detach node from anywhere in its bucket
+    Node* pop(HEAPTYPE heapType); // Detach the front node of the best non-empty bucket
+    const Node* front(HEAPTYPE heapType) const; // Return the front node of the best non-empty bucket
+    // Append the orders of up to k nodes to orders, best bucket first and each bucket front to back
+    void peek(HEAPTYPE heapType, int k, vector<Order>& orders) const;
+    void append(BucketQueue& rhs); // Move every node of rhs onto the back of the matching buckets
+    Node* takeAll(); // Detach every node as one list linked through m_right
+    void swap(BucketQueue& rhs); // Exchange every bucket with rhs
+    int getMinPriority() const; // Return the lowest priority with a bucket
+    int getMaxPriority() const; // Return the highest priority with a bucket
+
+    private:
+    vector<Node*> m_heads;      // front of each bucket, the next node to leave
+    vector<Node*> m_tails;      // back of each bucket, where new nodes are added
+    vector<uint64_t> m_words;   // bit b of word w is set if bucket 64*w+b is non-empty
+    vector<uint64_t> m_summary; // bit b of summary s is set if word 64*s+b is non-zero
+    int m_minPriority;          // priority kept in the first bucket
+    int m_maxPriority;          // priority kept in the last bucket
+
+    int bestBucket(HEAPTYPE heapType) const; // finds the best non-empty bucket through the bitmap
+    void markFull(int bucket); // sets the bits for a bucket that was empty
+    void markEmpty(int bucket); // clears the bits for a bucket that is now empty
+};
+class LatencyHistogram{
+    // operation latencies counted in power-of-two buckets of nanoseconds,
+    // so recording one is a bit scan and an increment
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+
+    LatencyHistogram();
+    void record(long nanoseconds); // Count one operation, the last bucket also takes anything longer
+    long count() const; // Return number of operations recorded
+    long bucketCount(int bucket) const; // Return number of operations in one bucket
+    // Return the upper bound in nanoseconds of the bucket holding that fraction of the operations, 0 if none
+    long percentile(double fraction) const;
+
+    private:
+    long m_counts[LATENCYBUCKETS]; // operations recorded in each bucket
+};
+class QueueStats{
+    // counters and latency histograms of one CQueue, copied out by stats();
+    // a queue only counts when built with CQUEUE_STATS, otherwise every count
+    // stays zero; the merge engines count through beginMerge, spineStep and nplSwap
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class CQueue;
+
+    QueueStats();
+    static bool enabled(); // Return true if the queues were built with CQUEUE_STATS
+    long getMerges() const; // Return number of merges of two heaps, including those inside removals and builds
+    long getSpineNodes() const; // Return number of nodes taken off the right spines by every merge
+    long getMaxSpine() const; // Return the most nodes taken off the spines by one merge
+    long getPriorityCalls() const; // Return number of calls to the priority function
+    long getAllocations() const; // Return number of nodes handed out by the pool
+    long getSlabs() const; // Return number of slabs the pool allocated
+    long getNPLSwaps() const; // Return number of child swaps that restored the leftist property
+    long getRebuilds() const; // Return number of whole heap rebuilds and heapifies
+    const LatencyHistogram& getInsertLatency() const; // insertOrder
+    const LatencyHistogram& getNextLatency() const; // getNextOrder
+    const LatencyHistogram& getMergeLatency() const; // mergeWithQueue
+    // Write each counter, and the count, median, 99th percentile and non-empty buckets of each histogram, as name,value lines
+    void exportCSV(ostream& out) const;
+
+    void beginMerge() {++m_merges; m_spine = 0;}
+    void spineStep() {++m_spineNodes; if (++m_spine > m_maxSpine) {m_maxSpine = m_spine;}}
+    void nplSwap() {++m_nplSwaps;}
+
+    private:
+    long m_merges;        // merges of two heaps
+    long m_spineNodes;    // nodes taken off the right spines by every merge, a pairing link counts one
+    long m_maxSpine;      // most nodes taken off the spines by one merge
+    long m_spine;         // nodes taken off the spines by the current merge
+    long m_priorityCalls; // calls to the priority function
+    long m_allocations;   // nodes handed out by the pool; held by a queue as the pool count at its last reset
+    long m_slabs;         // slabs allocated by the pool; held by a queue as the pool count at its last reset
+    long m_nplSwaps;      // child swaps that restored the leftist property
+    long m_rebuilds;      // whole heap rebuilds and heapifies
+    LatencyHistogram m_insertLatency; // insertOrder
+    LatencyHistogram m_nextLatency;   // getNextOrder
+    LatencyHistogram m_mergeLatency;  // mergeWithQueue
+};
+class NoMergeCount{
+    // stands in for a QueueStats when a merge is not counted, every call inlines away
+    public:
+    void beginMerge() {}
+    void spineStep() {}
+    void nplSwap() {}
+};
+#ifdef CQUEUE_STATS
+class LatencyTimer{
+    // records the time from its construction to its destruction, so every return path is timed
+    public:
+    explicit LatencyTimer(LatencyHistogram& histogram) : m_histogram(histogram), m_start(chrono::steady_clock::now()) {}
+    ~LatencyTimer() {
+        m_histogram.record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - m_start).count());
+    }
+    LatencyTimer(const LatencyTimer& rhs) = delete;
+    LatencyTimer& operator=(const LatencyTimer& rhs) = delete;
+
+    private:
+    LatencyHistogram& m_histogram;           // histogram the time goes to
+    chrono::steady_clock::time_point m_start; // when the operation started
+};
+#endif
+template <HEAPTYPE heapType, STRUCTURE structure> class MergeEngine;
+
+template <HEAPTYPE heapType> class HeapOrder{
+    // compile-time heap order, true if lhs belongs above rhs, ties keep lhs on top;
+    // any node that caches its priority is ordered the same way
+    public:
+    template <class NodeType> static bool hasPriority(const NodeType* lhs, const NodeType* rhs){
+        return (heapType == MINHEAP) ? (lhs->getPriority() <= rhs->getPriority()) : (lhs->getPriority() >= rhs->getPriority());
+    }
+};
+
+class NodeLinks{
+    // how a skew or leftist MergeEngine links the nodes of a CQueue: every node
+    // belongs to the queue merging it, so it is changed in place, and each node
+    // points back to its parent for cutNode and fixNPL
+    public:
+    typedef Node NodeType;
+    Node* own(Node* node) const {return node;}
+    void setParent(Node* child, Node* parent) const {child->m_parent = parent;}
+};
+
+template <HEAPTYPE heapType> class MergeEngine<heapType, SKEW>{
+    // top-down skew merge, each node taken off the right spine has its
+    // children swapped on the way down, so no stack is needed; links says
+    // whether a node may be changed in place and whether it keeps a parent
+    public:
+    template <class Counter, class Links> static typename Links::NodeType* merge(typename Links::NodeType* leftNode,
+            typename Links::NodeType* rightNode, Counter& counter, const Links& links){
+        typedef typename Links::NodeType NodeType;
+        counter.beginMerge();
+        NodeType* newSubtree = nullptr; //root of the merged heap
+        NodeType** hole = &newSubtree; //where the next winning node is attached
+        NodeType* holeOwner = nullptr; //node the hole belongs to, the parent of whatever is attached
+
+        //while loop runs until one of the spines runs out
+        while ((leftNode != nullptr) && (rightNode != nullptr)){
+            //the node with the higher priority is always kept in leftNode
+            if (!HeapOrder<heapType>::hasPriority(leftNode, rightNode)){
+                NodeType* temp = leftNode;
+                leftNode = rightNode;
+                rightNode = temp;
+            }
+
+            //the winner is owned and attached, and its right subtree continues to be merged
+            counter.spineStep();
+            leftNode = links.own(leftNode);
+            *hole = leftNode;
+            links.setParent(leftNode, holeOwner);
+            NodeType* rest = leftNode->m_right;
+
+            //left and right swapped as required in skew heaps, the merged result goes to the left
+            leftNode->m_right = leftNode->m_left;
+            hole = &leftNode->m_left;
+            holeOwner = leftNode;
+            leftNode = rest;
+        }
+
+        //whatever remains is attached at the bottom
+        *hole = ((leftNode != nullptr) ? leftNode : rightNode);
+        if (*hole != nullptr){
+            links.setParent(*hole, holeOwner);
+        }
+        return newSubtree;
+    }
+    template <class Counter> static Node* merge(Node* leftNode, Node* rightNode, Counter& counter){
+        return merge(leftNode, rightNode, counter, NodeLinks());
+    }
+    static Node* merge(Node* leftNode, Node* rightNode){
+        NoMergeCount none;
+        return merge(leftNode, rightNode, none);
+    }
+    //the heap left behind when root is removed
+    template <class Counter> static Node* removeRoot(Node* root, Counter& counter){
+        return merge(root->m_left, root->m_right, counter);
+    }
+    static Node* removeRoot(Node* root){
+        NoMergeCount none;
+        return removeRoot(root, none);
+    }
+};
+
+template <HEAPTYPE heapType> class MergeEngine<heapType, LEFTIST>{
+    // top-down pass down the right spines, then a bottom-up pass to fix the
+    // leftist property and NPL; the path is remembered by temporarily
+    // reversing the m_right links, so no stack is needed; links says whether
+    // a node may be changed in place and whether it keeps a parent
+    public:
+    template <class Counter, class Links> static typename Links::NodeType* merge(typename Links::NodeType* leftNode,
+            typename Links::NodeType* rightNode, Counter& counter, const Links& links){
+        typedef typename Links::NodeType NodeType;
+        counter.beginMerge();
+        NodeType* path = nullptr; //last node visited on the merged right spine
+
+        //top-down pass, each winner is owned and points back to the previous winner through m_right
+        while ((leftNode != nullptr) && (rightNode != nullptr)){
+            //the node with the higher priority is always kept in leftNode
+            if (!HeapOrder<heapType>::hasPriority(leftNode, rightNode)){
+                NodeType* temp = leftNode;
+                leftNode = rightNode;
+                rightNode = temp;
+            }
+
+            counter.spineStep();
+            leftNode = links.own(leftNode);
+            NodeType* rest = leftNode->m_right;
+            leftNode->m_right = path;
+            path = leftNode;
+            leftNode = rest;
+        }
+
+        //newSubtree starts as whatever remains at the bottom of the spine
+        NodeType* newSubtree = ((leftNode != nullptr) ? leftNode : rightNode);
+
+        //bottom-up pass, the links are restored and the leftist property is fixed on the way up
+        while (path != nullptr){
+            NodeType* parent = path->m_right;
+            path->m_right = newSubtree;
+            if (newSubtree != nullptr){
+                links.setParent(newSubtree, path);
+            }
+
+            //if the right NPL is greater than the left, or the left is empty, they are swapped
+            if ((path->m_left == nullptr) || (path->m_right->m_npl > path->m_left->m_npl)){
+                counter.nplSwap();
+                path->m_right = path->m_left;
+                path->m_left = newSubtree;
+            }
+
+            //NPL updated, one plus the lesser NPL of the children, which is always the right one
+            path->m_npl = 1 + ((path->m_right == nullptr) ? 0 : path->m_right->m_npl);
+
+            newSubtree = path;
+            path = parent;
+        }
+
+        //newSubtree is returned as a root
+        if (newSubtree != nullptr){
+            links.setParent(newSubtree, nullptr);
+        }
+        return newSubtree;
+    }
+    template <class Counter> static Node* merge(Node* leftNode, Node* rightNode, Counter& counter){
+        return merge(leftNode, rightNode, counter, NodeLinks());
+    }
+    static Node* merge(Node* leftNode, Node* rightNode){
+        NoMergeCount none;
+        return merge(leftNode, rightNode, none);
+    }
+    //the heap left behind when root is removed
+    template <class Counter> static Node* removeRoot(Node* root, Counter& counter){
+        return merge(root->m_left, root->m_right, counter);
+    }
+    static Node* removeRoot(Node* root){
+        NoMergeCount none;
+        return removeRoot(root, none);
+    }
+};
+
+template <HEAPTYPE heapType> class MergeEngine<heapType, PAIRING>{
+    // pairing heap stored as first child / next sibling; a merge links the
+    // losing root in as the first child of the winner, and removing the root
+    // combines its children with the two-pass pairing walk
+    public:
+    template <class Counter> static Node* merge(Node* leftNode, Node* rightNode, Counter& counter){
+        counter.beginMerge();
+        //if statements check if either heap is empty, the other is returned as a root
+        if ((leftNode == nullptr) || (rightNode == nullptr)){
+            Node* root = ((leftNode != nullptr) ? leftNode : rightNode);
+            if (root != nullptr){
+                root->m_parent = nullptr;
+            }
+            return root;
+        }
+
+        //the node with the higher priority is always kept in leftNode
+        if (!HeapOrder<heapType>::hasPriority(leftNode, rightNode)){
+            Node* temp = leftNode;
+            leftNode = rightNode;
+            rightNode = temp;
+        }
+
+        //the loser becomes the first child of the winner, ahead of the old first child
+        counter.spineStep();
+        rightNode->m_right = leftNode->m_left;
+        if (rightNode->m_right != nullptr){
+            rightNode->m_right->m_parent = rightNode;
+        }
+        leftNode->m_left = rightNode;
+        rightNode->m_parent = leftNode;
+        leftNode->m_parent = nullptr;
+        return leftNode;
+    }
+    static Node* merge(Node* leftNode, Node* rightNode){
+        NoMergeCount none;
+        return merge(leftNode, rightNode, none);
+    }
+    //the heap left behind when root is removed
+    template <class Counter> static Node* removeRoot(Node* root, Counter& counter){
+        Node* sibling = root->m_left; //next child waiting to be paired
+        Node* pairs = nullptr;        //merged pairs, last pair first
+
+        //first pass, children are merged in pairs from left to right
+        while (sibling != nullptr){
+            Node* first = sibling;
+            Node* second = first->m_right;
+            first->m_right = nullptr;
+            if (second != nullptr){
+                sibling = second->m_right;
+                second->m_right = nullptr;
+                first = merge(first, second, counter);
+            }
+            else{
+                sibling = nullptr;
+            }
+
+            //the pair is pushed onto the front of the list
+            first->m_right = pairs;
+            pairs = first;
+        }
+
+        //second pass, the pairs are merged from right to left into one heap, merge leaves it a root
+        Node* newHeap = nullptr;
+        while (pairs != nullptr){
+            Node* next = pairs->m_right;
+            pairs->m_right = nullptr;
+            newHeap = merge(newHeap, pairs, counter);
+            pairs = next;
+        }
+        return newHeap;
+    }
+    static Node* removeRoot(Node* root){
+        NoMergeCount none;
+        return removeRoot(root, none);
+    }
+};
+
+template <class Engine> class NodeHeap{
+    // insertion, removal and merging of a tree of nodes, shared by BasicCQueue and the
+    // node structures of CQueue so both run the same code; Engine supplies merge and
+    // removeRoot, a MergeEngine fixed at compile time or a CQueue choosing one at run time
+    public:
+    //merges a lone node into the tree
+    static void insertNode(Engine& engine, Node*& root, Node* node){
+        node->m_npl = 1; //a lone node has a null path length of one
+        root = engine.merge(root, node);
+    }
+    //detaches the root and rebuilds the tree from what was below it, the caller must release the node
+    static Node* removeNode(Engine& engine, Node*& root){
+        Node* returnedNode = root;
+        root = engine.removeRoot(returnedNode);
+        return returnedNode;
+    }
+    //merges the tree of rhs into this one, the slabs holding its nodes move over with them
+    static void meld(Engine& engine, Node*& root, NodePool& pool, Node*& rhsRoot, NodePool& rhsPool){
+        root = engine.merge(root, rhsRoot);
+        pool.adopt(rhsPool);
+        rhsRoot = nullptr;
+    }
+};
+
+template <class PriorityFn, HEAPTYPE heapType, STRUCTURE structure>
+class BasicCQueue{
+    // skew/leftist/pairing heap with the priority function, heap type and structure
+    // fixed at compile time; PriorityFn is any callable taking a const Order&,
+    // so a functor is inlined into insertOrder and merge never branches on policy;
+    // the tree is kept by NodeHeap, the same code CQueue runs with its policy chosen at run time
+    static_assert(structure != DARY, "BasicCQueue only supports node based structures");
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    typedef MergeEngine<heapType, structure> Engine;
+    typedef NodeHeap<Engine> Heap;
+
+    explicit BasicCQueue(PriorityFn priFn = PriorityFn()) : m_heap(nullptr), m_size(0), m_priorFunc(priFn) {}
+    ~BasicCQueue() {clear();}
+    BasicCQueue(const BasicCQueue& rhs) : m_heap(nullptr), m_size(0), m_priorFunc(rhs.m_priorFunc) {
+        *this = rhs;
+    }
+    BasicCQueue& operator=(const BasicCQueue& rhs){
+        if (this != &rhs){
+            clear();
+            m_priorFunc = rhs.m_priorFunc;
+            m_heap = m_pool.copyTree(rhs.m_heap);
+            m_size = rhs.m_size;
+        }
+        return *this;
+    }
+    BasicCQueue(BasicCQueue&& rhs) noexcept : m_heap(nullptr), m_size(0), m_priorFunc(rhs.m_priorFunc) {
+        *this = std::move(rhs);
+    }
+    BasicCQueue& operator=(BasicCQueue&& rhs) noexcept {
+        if (this != &rhs){
+            clear();
+            m_priorFunc = rhs.m_priorFunc;
+            m_heap = rhs.m_heap;
+            m_size = rhs.m_size;
+            m_pool.swap(rhs.m_pool);
+            rhs.m_heap = nullptr;
+            rhs.m_size = 0;
+        }
+        return *this;
+    }
+    void insertOrder(const Order& order){
+        Engine engine;
+        Heap::insertNode(engine, m_heap, m_pool.acquire(order, m_priorFunc(order)));
+        ++m_size;
+    }
+    Order getNextOrder(){ // Return the highest priority order
+        if (m_heap == nullptr){
+            throw out_of_range("Out of Range");
+        }
+        Engine engine;
+        Node* returnedNode = Heap::removeNode(engine, m_heap);
+        Order myOrder = returnedNode->m_order;
+        m_pool.release(returnedNode);
+        --m_size;
+        return myOrder;
+    }
+    void mergeWithQueue(BasicCQueue& rhs){
+        if (this != &rhs){
+            Engine engine;
+            Heap::meld(engine, m_heap, m_pool, rhs.m_heap, rhs.m_pool);
+            m_size += rhs.m_size;
+            rhs.m_size = 0;
+        }
+    }
+    void clear(){
+        m_pool.releaseTree(m_heap);
+        m_heap = nullptr;
+        m_size = 0;
+    }
+    int numOrders() const {return m_size;} // Return number of orders in queue
+    HEAPTYPE getHeapType() const {return heapType;}
+    STRUCTURE getStructure() const {return structure;}
+
+    private:
+    Node * m_heap;          // Pointer to the root of the heap
+    int m_size;             // Current size of the heap
+    PriorityFn m_priorFunc; // Function to compute priority
+    NodePool m_pool;        // allocator for every node in the heap
+};
+class LogPause{
+    // detaches the log of a queue for as long as it lives, for work that must not be
+    // logged as it happens, and attaches it again however the scope is left
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    explicit LogPause(OrderLog*& log) : m_log(log), m_saved(log) {log = nullptr;}
+    ~LogPause() {m_log = m_saved;}
+    LogPause(const LogPause& rhs) = delete;
+    LogPause& operator=(const LogPause& rhs) = delete;
+
+    private:
+    OrderLog*& m_log;   // the log member of the queue
+    OrderLog* m_saved;  // log attached when the pause began
 };
 class CQueue{
-    // stores the skew/leftist heap, minheap/maxheap
+    // stores the skew/leftist/d-ary/pairing heap, minheap/maxheap
     public:
     friend class Grader; // for grading purposes
     friend class Tester; // for testing purposes
+    friend class OrderLog;
+    friend class NodeHeap<CQueue>; // runs the node structures with this queue choosing the MergeEngine
     
-    CQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure);
+    CQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure, int arity = DEFAULTARITY);
     ~CQueue();
     CQueue(const CQueue& rhs);
     CQueue& operator=(const CQueue& rhs);
-    void insertOrder(const Order& order);
+    CQueue(CQueue&& rhs) noexcept; // Take over the heap and log of rhs, leaving rhs empty and unlogged
+    // Take over rhs the same way; throws, changing nothing, if the log of this queue cannot record the drop
+    CQueue& operator=(CQueue&& rhs);
+    OrderHandle insertOrder(const Order& order); // Insert order, return a handle to it
+    // Replace the order a handle refers to and move just that node to match its new priority;
+    // throws invalid_argument for an empty handle, domain_error for a stale one or a DARY heap
+    void updateOrder(OrderHandle handle, const Order& order);
+    // Remove an order with this ID from anywhere in the queue, return false if there is none;
+    // O(n) unless setOrderIndex(true) was called, then amortized O(log n) for a node structure,
+    // and always O(n) for a DARY heap, whose array is searched since it has no nodes to index
+    bool cancelOrder(int orderID);
+    // Insert every order in [first, last) with a linear-time bulk build
+    template <class InputIt> void insertOrders(InputIt first, InputIt last);
+    void insertOrders(const vector<Order>& orders);
     Order getNextOrder(); // Return the highest priority order
+    int getNextPriority() const; // Return the priority of the next order without removing it
+    int countAhead(int priority) const; // Return number of orders with a strictly higher priority
+    // Write up to k highest priority orders to out, return how many were written
+    template <class OutputIt> size_t getNextOrders(size_t k, OutputIt out);
+    // Return up to k highest priority orders, best first, without removing them, in O(k log k);
+    // a PAIRING heap also scans every child of each order returned, O(n) for a root after inserts alone
+    vector<Order> peekTopOrders(int k) const;
     void mergeWithQueue(CQueue& rhs);
     void clear();
     int numOrders() const; // Return number of orders in queue
@@ -161,16 +847,55 @@ class CQueue{
     void setPriorityFn(prifn_t priFn, HEAPTYPE heapType);
     HEAPTYPE getHeapType() const;
     STRUCTURE getStructure() const;
-    // Set a new data structure (skew/leftist). Must rebuild the heap!!!
+    // Set a new data structure (skew/leftist/dary/pairing). Must rebuild the heap!!!
     void setStructure(STRUCTURE structure);
+    int getArity() const; // Return the number of children per node of a DARY heap
+    // Set the number of children per node of a DARY heap (2, 4 or 8)
+    void setArity(int arity);
+    // Keep orders in FIFO buckets while every priority is in [minPriority, maxPriority]
+    void setPriorityRange(int minPriority, int maxPriority);
+    void clearPriorityRange(); // Leave bucket mode, the orders go back into the structure
+    bool isBucketMode() const; // Return true if the orders are kept in buckets
+    // Make mergeWithQueue record the incoming heap in O(1), to be melded by later removals
+    void setLazyMerge(bool lazy);
+    bool getLazyMerge() const; // Return true if mergeWithQueue is lazy
+    // Keep an index from order ID to node, so cancelOrder finds its order without a search; off by
+    // default, since it costs every insertion a hash insert; a DARY heap keeps no index while it is one
+    void setOrderIndex(bool indexed);
+    bool getOrderIndex() const; // Return true if the queue keeps an order ID index
+    // Write every order and the shape of the heap to a binary file, return false if it cannot be written
+    bool saveSnapshot(const string& path) const;
+    // Replace every order with those of a snapshot file, return false if it is not a valid snapshot;
+    // the file must come from a queue with the same heap type, structure and priority function
+    bool loadSnapshot(const string& path);
+    // Start logging to log, which is first checkpointed with every order; nullptr stops logging.
+    // Every change to the orders, the priority function or the layout is logged; only the order
+    // index and lazy merging are not, since they change no order
+    void attachLog(OrderLog* log);
+    OrderLog* getLog() const; // Return the attached log, nullptr if there is none
     void dump() const; // For debugging purposes
+    int getPoolHighWater() const; // Return the most nodes the queue has held at once
+    // Return a copy of the counters and latency histograms, all zero unless built with CQUEUE_STATS
+    QueueStats stats() const;
+    void resetStats(); // Start every counter and histogram again from zero
 
     private:
     Node * m_heap;          // Pointer to the root of skew heap
     int m_size;             // Current size of the heap
     prifn_t m_priorFunc;    // Function to compute priority
     HEAPTYPE m_heapType;    // either a MINHEAP or a MAXHEAP
-    STRUCTURE m_structure;  // skew heap or leftist heap
+    STRUCTURE m_structure;  // skew, leftist, d-ary or pairing heap
+    NodePool m_pool;        // allocator for every node in the heap
+    vector<DaryEntry> m_array; // contiguous storage of a DARY heap
+    int m_arity;            // children per node of a DARY heap
+    BucketQueue m_buckets;  // storage while the queue is in bucket mode
+    bool m_bucketMode;      // true if every order is kept in m_buckets instead of the structure
+    bool m_lazyMerge;       // true if mergeWithQueue only records the incoming heap
+    vector<Node*> m_pending; // roots of heaps recorded by a lazy mergeWithQueue, not yet melded into m_heap
+    bool m_indexed;         // true if every node is kept in m_index
+    unordered_multimap<int, Node*> m_index; // node holding each order ID, empty while orders are in a DARY array
+    OrderLog * m_log;       // log of the operations applied to the queue, nullptr if there is none
+    CQUEUE_STAT(QueueStats m_stats;) // work counted since the queue was made, never copied or moved
 
     void dump(Node *pos) const; // helper function for dump
 
@@ -178,14 +903,199 @@ class CQueue{
      * Private function declarations go here! *
      ******************************************/
 
-    void recursiveClear(Node* curr); //helper for clear and the destructor
-
-    Node* merge(Node* leftNode, Node* rightNode); //helper which helps with merging nodes in queues
-    void swap(Node*& leftNode, Node*& rightNode); //helper for merge
-    void updateNPL(Node* node); //helper for updating the NPL, specifically used in merge
+    int priorityOf(const Order& order); //calls the priority function, counting the call
+    Node* merge(Node* leftNode, Node* rightNode); //dispatches to the MergeEngine for this heap
+    Node* removeRoot(Node* root); //dispatches to the MergeEngine, returns the heap left without root
+    Node* popNode(); //detaches the highest priority node, which the caller must release
+    void cutNode(Node* node); //detaches the subtree rooted at node from its parent or from the root list
+    void fixNPL(Node* curr); //restores the leftist property and NPL from curr up to the root
+    void detachNode(Node* node); //removes one node from anywhere in the queue, which the caller must release
+    bool removeOrder(int orderID, const Order* order); //cancelOrder, matching the whole order if it is given
+    void releaseAll(); //returns every node to the pool and empties the queue without logging it
+    void takeOver(CQueue& rhs) noexcept; //the move, taking every node and the log of rhs without logging
+    void buildStep(Node* slots[], Node* node); //adds a node to a bulk build, merging equal sized heaps
+    Node* buildFinish(Node* slots[]); //merges every slot of a bulk build into one heap
     
     void preorderTraversal(const Node* curr) const; //helper for printOrdersQueue
-    Node* preOrderAssignment(const Node* rhsNode);
-    void priorityFuncHelper(const Node* curr, CQueue& newCQueue); //helper for setPriorityFunc and setStructure
+    void rebuild(); //helper for setPriorityFunc and setStructure, rebuilds the heap in place
+    Node* flatten(Node* curr); //turns a tree into a list linked through m_right without a stack
+
+    //helpers for the DARY structure
+    bool hasPriority(const DaryEntry& lhs, const DaryEntry& rhs) const; //true if lhs belongs above rhs
+    void siftUp(int index); //moves an entry up until its parent has priority over it
+    void siftDown(int index); //moves an entry down until it has priority over its children
+    void heapify(); //linear bottom-up construction of the whole array
+    DaryEntry popEntry(); //removes and returns the highest priority entry
+    void eraseEntry(int index); //removes the entry at index from anywhere in the array
+    void arrayToTree(); //moves every entry into nodes and builds the tree
+    void treeToArray(); //moves every node into the array and releases the nodes
+    void arrayPreorderTraversal(int index) const; //helper for printOrdersQueue
+    void dumpArray(int index) const; //helper for dump
+
+    //helpers for bucket mode
+    Node* takeList(); //detaches every order of the structure as a list of nodes linked through m_right
+    void buildFromList(Node* list); //builds the structure from a list of keyed nodes
+    void fillBuckets(Node* list); //moves a list of keyed nodes into the buckets, falling back if one does not fit
+    void leaveBucketMode(); //moves every order from the buckets back into the structure
+    void bucketTraversal(bool dumpFormat) const; //helper for printOrdersQueue and dump
+
+    //helpers for lazy merging
+    bool hasPriority(const Node* lhs, const Node* rhs) const; //true if lhs belongs above rhs
+    void meldBestPending(); //melds the pending heap with the best root into m_heap
+    void meldPending(); //melds every pending heap into m_heap
+
+    //helpers for the order ID index
+    Node* findNode(int orderID, const Order* order = nullptr) const; //searches every node for the order ID, or the whole order
+    Node* findOrder(const Order& order) const; //finds a node holding exactly order, through the index if there is one
+    static bool sameOrder(const Order& lhs, const Order& rhs); //true if every field of lhs and rhs matches
+    void indexNode(Node* node); //adds node to the index if the queue keeps one
+    void unindexNode(const Node* node); //removes node from the index if the queue keeps one
+    void indexTree(Node* root); //adds every node of a tree or list to the index
+    void indexQueue(const CQueue& rhs); //adds every node of rhs to the index, using the index of rhs if it has one
+    void rebuildIndex(); //rebuilds the index from every node in the queue
+
+    //helpers for snapshots
+    void writeSnapshot(ostream& out) const; //writes the header and every record to out
+    bool loadImage(const char* data, size_t length); //replaces every order with a snapshot held in memory
+    bool loadRecords(const SnapshotHeader& header, const SnapshotRecord records[]); //replaces every order with the records
+    Node* loadTree(const SnapshotRecord records[], int64_t size, int64_t& next); //rebuilds one tree from the records at next
+
+    //helpers for the log, so the templates need not see OrderLog
+    void logInserts(const vector<Order>& orders); //logs a bulk insertion
+    void logRemovals(int count); //logs count removals of the highest priority order
+    void logSnapshot(); //logs every order and the layout, after a change no smaller record describes
 };
+
+//priorityOf
+//every priority is computed through here, so the calls can be counted
+inline int CQueue::priorityOf(const Order& order){
+    CQUEUE_STAT(++m_stats.m_priorityCalls;)
+    return m_priorFunc(order);
+}
+
+//insertOrders
+//builds a heap from the new orders by pairwise merging, then melds it into the existing heap once
+//an order whose priority throws leaves the queue and its log as they were, except in bucket mode,
+//where the orders before it are already in
+template <class InputIt>
+void CQueue::insertOrders(InputIt first, InputIt last){
+    //if statement checks for a log, the orders are inserted with the log detached, so a replay of the batch
+    //takes this same path, then logged once as a batch now that they are in
+    if (m_log != nullptr){
+        vector<Order> orders(first, last);
+        {
+            LogPause pause(m_log);
+            insertOrders(orders.begin(), orders.end());
+        }
+        logInserts(orders);
+        return;
+    }
+
+    //if statement checks for bucket mode, each order is added in constant time
+    //until the orders run out or one falls outside the range and the queue falls back
+    if (m_bucketMode){
+        for (; (first != last) && m_bucketMode; ++first){
+            insertOrder(*first);
+        }
+        if (first == last){
+            return;
+        }
+    }
+
+    //if statement checks for a DARY heap, the orders are appended then the array is fixed
+    if (m_structure == DARY){
+        int oldSize = m_size;
+        try{
+            for (; first != last; ++first){
+                m_array.push_back(DaryEntry(*first, priorityOf(*first)));
+            }
+        }
+        catch (...){
+            m_array.resize(oldSize); //the entries appended so far are dropped, the heap was never touched
+            throw;
+        }
+        m_size = static_cast<int>(m_array.size());
+
+        //a linear heapify is cheaper unless only a few orders were added
+        if (m_size - oldSize >= oldSize){
+            heapify();
+        }
+        else{
+            for (int i = oldSize; i < m_size; i++){
+                siftUp(i);
+            }
+        }
+        return;
+    }
+
+    Node* slots[MAXBUILDSLOTS] = {nullptr}; //slot k holds a heap built from 2^k orders
+    int count = 0;
+
+    //for loop creates a lone node for each order, and adds it to the build
+    try{
+        for (; first != last; ++first){
+            int priority = priorityOf(*first);
+            Node* newNode = m_pool.acquire(*first, priority);
+            newNode->setNPL(1); //a lone node has a null path length of one
+            buildStep(slots, newNode);
+            ++count;
+        }
+    }
+    catch (...){
+        //the nodes built so far are returned, the queue was never touched
+        for (int k = 0; k < MAXBUILDSLOTS; k++){
+            m_pool.releaseTree(slots[k]);
+        }
+        throw;
+    }
+
+    //the built heap is indexed, merged into the existing heap and counted once it is whole
+    Node* built = buildFinish(slots);
+    indexTree(built);
+    m_heap = merge(m_heap, built);
+    m_size += count;
+}
+
+//getNextOrders
+//removes up to k orders in priority order, never throws when the queue runs out
+//the removed nodes are chained together and returned to the pool all at once
+template <class OutputIt>
+size_t CQueue::getNextOrders(size_t k, OutputIt out){
+    size_t numTaken = 0;
+    Node* taken = nullptr; //removed nodes, most recent first
+    Node* last = nullptr;  //first node removed, the tail of the chain
+
+    //if statement checks for a DARY heap, which has no nodes to release
+    if ((m_structure == DARY) && !m_bucketMode){
+        while ((numTaken < k) && (m_size > 0)){
+            *out = popEntry().m_order;
+            ++out;
+            ++numTaken;
+        }
+        logRemovals(static_cast<int>(numTaken));
+        return numTaken;
+    }
+
+    //while loop runs until k orders are removed or the queue is empty
+    while ((numTaken < k) && (m_size > 0)){
+        Node* returnedNode = popNode();
+        *out = returnedNode->m_order;
+        ++out;
+
+        //returnedNode added to the front of the chain
+        returnedNode->m_right = taken;
+        taken = returnedNode;
+        if (last == nullptr){
+            last = returnedNode;
+        }
+        ++numTaken;
+    }
+
+    //if statement checks if anything was removed, if so the chain is released
+    if (taken != nullptr){
+        m_pool.releaseChain(taken, last, static_cast<int>(numTaken));
+    }
+    logRemovals(static_cast<int>(numTaken));
+    return numTaken;
+}
 #endif
\ No newline at end of file
@@ -13,13 +13,39 @@
 *****************************/
 
 #include "cqueue.h"
+#include "ccqueue.h"
+#include "cqlog.h"
+#include "cqingest.h"
+#include "pcqueue.h"
 #include <random>
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <sys/stat.h>
 
 int priorityFn1(const Order &order);// works with a MAXHEAP
 int priorityFn2(const Order &order);// works with a MINHEAP
+int failingFn(const Order &order);// works with a MINHEAP, throws for some orders
+
+//functor version of priorityFn1, used to test the compile-time BasicCQueue
+struct PointsPriority{
+    int operator()(const Order &order) const {return priorityFn1(order);}
+};
 
 //global constants
 const int NORMAL_CASE = 600; //NORMAL_CASE is 600, as suggested by the website
+const int LARGE_CASE = 200000; //LARGE_CASE is used to stress the heaps with long spines
+const int DEEP_CASE = 1000000; //DEEP_CASE is the depth of the degenerate trees that are copied and cleared
+const char SNAPSHOT_FILE[] = "mytest.snapshot"; //SNAPSHOT_FILE is written and removed by the snapshot test
+const char LOG_FILE[] = "mytest.log"; //LOG_FILE is written and removed by the log test
+const char RHS_LOG_FILE[] = "mytest.rhs.log"; //RHS_LOG_FILE logs a second queue in the log test
+const char INGEST_FILE[] = "mytest.ingest"; //INGEST_FILE is written and removed by the ingest test
+const int NUM_THREADS = 8; //producer and consumer threads used to test the concurrent queue
+const int FAIL_EVERY = 7; //failingFn throws for every order ID that is a multiple of FAIL_EVERY
 
 //random class taken from driver and used for testing purposes
 enum RANDOM {UNIFORMINT, UNIFORMREAL, NORMAL};
@@ -140,6 +166,97 @@ class Tester{
         //thrown error tests
         bool errorDequeue(CQueue& cqueue);
         bool errorMerge(CQueue& cqueue);
+
+        //large merge test, ensures long right spines do not limit the queue
+        bool deepMergeTest(CQueue& cqueue, int num);
+
+        //node pool test, ensures nodes are recycled and survive mergeWithQueue
+        bool testNodePool(CQueue& cqueue);
+
+        //cached priority tests, ensures every node keeps the priority of the current function
+        bool testCachedPriority(CQueue& cqueue);
+        bool cachedPriorityTest(bool result, const Node* curr, prifn_t priorFn);
+
+        //compile-time BasicCQueue test, compared against a CQueue with the same policy
+        bool testBasicCQueue();
+
+        //bulk insertion test
+        bool testInsertOrders(CQueue& cqueue);
+
+        //in place rebuild test, ensures setPriorityFn and setStructure reuse the same nodes
+        bool testInPlaceRebuild(CQueue& cqueue);
+        void collectNodes(const Node* curr, vector<const Node*>& nodes);
+
+        //move constructor and move assignment tests
+        bool testMoveSemantics(CQueue& cqueue);
+
+        //batch removal test
+        bool testGetNextOrders(CQueue& cqueue);
+
+        //d-ary heap tests
+        bool testDaryHeap(CQueue& cqueue);
+        bool daryHeapTest(const CQueue& cqueue);
+
+        //pairing heap tests
+        bool testPairingHeap(CQueue& cqueue);
+        bool pairingHeapTest(bool result, const Node* curr, HEAPTYPE heapType);
+
+        //bucket mode tests
+        bool testBucketMode(CQueue& cqueue);
+        bool drainTest(CQueue& cqueue);
+
+        //concurrent queue test, producers and consumers run at the same time
+        bool testConcurrentQueue(ConcurrentCQueue& ccqueue);
+        bool testCombinerException();
+
+        //multiqueue test, every order must come out once and the measured rank error must be exact
+        bool testMultiQueue(MultiCQueue& mqueue);
+
+        //lazy merge test, the merged heaps are only recorded and paid down by removals
+        bool testLazyMerge(CQueue& cqueue);
+
+        //order handle tests, each update must move only its node and keep every link consistent
+        bool testUpdateOrder(CQueue& cqueue);
+        bool parentTest(bool result, const Node* curr, const Node* linker);
+        bool updateHeapTest(CQueue& cqueue);
+        bool bucketLinkTest(CQueue& cqueue);
+        bool staleHandleTest(CQueue& cqueue, OrderHandle handle);
+
+        //cancel test, orders are removed by ID from every part of the queue, with and without the index
+        bool testCancelOrder(CQueue& cqueue);
+        bool cancelSome(CQueue& cqueue, vector<bool>& present, int start, int step);
+
+        //compact order test, every field must keep its largest and smallest value
+        bool testCompactOrder();
+
+        //deep tree test, clearing, copying and printing a tree of linear depth must not recurse
+        bool testDeepTree(CQueue& cqueue);
+        void deepChain(CQueue& cqueue, int num);
+
+        //peek test, the top orders must match the orders a copy gives up, and the queue must not change
+        bool testPeekTopOrders(CQueue& cqueue);
+        bool peekTest(CQueue& cqueue, int k);
+
+        //snapshot tests, a loaded queue must print, dump and drain exactly like the saved one
+        bool testSnapshot(CQueue& cqueue);
+        bool snapshotTest(CQueue& cqueue);
+        string printed(const CQueue& cqueue);
+
+        //log tests, recovering from the log must give back exactly the queue that was logged
+        bool testOrderLog(CQueue& cqueue);
+        bool recoverTest(const CQueue& cqueue, const vector<prifn_t>& priFns, const char* path = LOG_FILE);
+
+        //ingest tests, an ingested file must add exactly its valid orders, whatever the chunk size
+        bool testIngest(CQueue& cqueue);
+        bool ingestTest(const CQueue& cqueue, OrderIngest& ingest, const vector<Order>& expected);
+
+        //stats test, the counters must match the work done exactly, or stay zero when they are compiled out
+        bool testStats(CQueue& cqueue);
+
+        //persistent tests, every version must keep exactly its own orders while the others change
+        bool testPersistentQueue(PersistentCQueue& pqueue);
+        bool versionTest(PersistentCQueue version, const vector<Order>& expected);
+        bool sameShape(const PersistentCQueue& pqueue, const CQueue& cqueue);
 };
 
 int main(){
@@ -774,493 +891,2200 @@ int main(){
         cout << "\n***END TEST BLOCK EIGHTEEN ***" << endl;        
     }
 
-    cout << "\n**********************" << endl;
-    cout << "***** END TEST *******" << endl;
-    cout << "**********************" << endl;
+    {
+        cout << "\n*** TEST BLOCK NINETEEN ***" << endl << endl;
+        cout << "This will test that merging large sorted and random inputs does not overflow the stack" << endl << endl;
 
-    return 0;
-}
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
 
-//priorityFunctions done
+        //deepMergeTest tested
+        cout << "deepMergeTest starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        bool testResult = tester.deepMergeTest(*newCQueue, LARGE_CASE);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-int priorityFn1(const Order &order) {
-    //this function works with a MAXHEAP
-    //priority value is determined based on some criteria
-    //priority value falls in the range [0-5003]
-    //the highest priority would be 3+5000 = 5003
-    //the lowest priority would be 0+0 = 0
-    //the larger value means the higher priority
-    int priority = static_cast<int>(order.getCount()) + order.getPoints();
-    return priority;
-}
+        //deepMergeTest tested again
+        cout << "deepMergeTest starting with priorFn1, MINHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MINHEAP, SKEW); //cqueue initialized
+        testResult = tester.deepMergeTest(*newCQueue, LARGE_CASE);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-int priorityFn2(const Order &order) {
-    //this funcction works with a MINHEAP
-    //priority value is determined based on some criteria
-    //priority value falls in the range [0-10]
-    //the highest priority would be 0+0 = 0
-    //the lowest priority would be 5+5 =10
-    //the smaller value means the higher priority
-    int priority = static_cast<int>(order.getItem()) + static_cast<int>(order.getMemebership());
-    return priority;
-}
+        //deepMergeTest tested again
+        cout << "deepMergeTest starting with priorFn1, MAXHEAP, LEFTIST: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, LEFTIST); //cqueue initialized
+        testResult = tester.deepMergeTest(*newCQueue, LARGE_CASE);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-//testCondition
-//displays the output of the test whether it passed or failed
-void Tester::testCondition(bool var){
-    if (var){
-        cout << "This test has passed" << endl << endl;
-    }
-    else{
-        cout << "This test has failed" << endl << endl;
-    }
-}
+        //deepMergeTest tested again
+        cout << "deepMergeTest starting with priorFn1, MINHEAP, LEFTIST: \n\t";
+        newCQueue = new CQueue(priorityFn1, MINHEAP, LEFTIST); //cqueue initialized
+        testResult = tester.deepMergeTest(*newCQueue, LARGE_CASE);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-//randomFill
-//fills the cQueue sent with random order
-void Tester::randomFill(CQueue& aqueue, int numToFill){
-    Random orderIdGen(MINORDERID,MAXORDERID);
-    Random customerIdGen(MINCUSTID,MAXCUSTID);
-    customerIdGen.setSeed(0);
-    Random membershipGen(0,5); // there are six tiers
-    Random pointsGen(MINPOINTS,MAXPOINTS);
-    Random itemGen(0,5); // there are six items
-    Random countGen(0,3); // there are three possible quantity values
-    for (int i = 0; i < numToFill; i++){
-        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
-                    static_cast<COUNT>(countGen.getRandNum()),
-                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
-                    pointsGen.getRandNum(),
-                    customerIdGen.getRandNum(),
-                    orderIdGen.getRandNum());
-        aqueue.insertOrder(anOrder);
+        cout << "\n***END TEST BLOCK NINETEEN ***" << endl;
     }
-}
 
-//minheapTest
-//checks to ensure the MINHEAP property upholds for every node
-bool Tester::minheapTest(bool result, const Node* curr, prifn_t priorFn){
-    if (curr == nullptr){
-        return result;
-    }
-    else{
-        //minheap test called using preorder traversal
-        result = result && minheapTest(result, curr->m_left, priorFn);
-        result = result && minheapTest(result, curr->m_right, priorFn);
-        
-        //curr, left and right priority are declared and initialized
-        //checks if nullptr, if so returns a value out of range so always tue
-        int currPriority = priorFn(curr->getOrder());
-        int leftPriority = ((curr->m_left == nullptr) ? 999999: priorFn(curr->m_left->getOrder()));
-        int rightPriority = ((curr->m_right == nullptr) ? 999999: priorFn(curr->m_right->getOrder()));
+    {
+        cout << "\n*** TEST BLOCK TWENTY ***" << endl << endl;
+        cout << "This will test that the node pool recycles nodes and keeps merged nodes alive" << endl << endl;
 
-        //if statement checks to make sure both are greater than curr, and if so true is returned
-        if ((currPriority <= leftPriority) && (currPriority <= rightPriority)){
-            return result && true;
-        }
-        else{
-            return result && false; //else, false is returned
-        }
-    }
-}
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
 
-//maxheapTest
-//recursive test which ensures maxheap property upholds
-bool Tester::maxheapTest(bool result, const Node* curr, prifn_t priorFn){
-    if (curr == nullptr){
-        return result;
-    }
-    else{
-        //maxheap test called using postorder traversal
-        result = result && maxheapTest(result, curr->m_left, priorFn);
-        result = result && maxheapTest(result, curr->m_right, priorFn);
-        
-        //curr, left and right priority are declared and initialized
-        //checks if nullptr, if so returns a value out of range so always true
-        int currPriority = priorFn(curr->getOrder());
-        int leftPriority = ((curr->m_left == nullptr) ? -1: priorFn(curr->m_left->getOrder()));
-        int rightPriority = ((curr->m_right == nullptr) ? -1: priorFn(curr->m_right->getOrder()));
-        
-        //if statement checks to make sure both are less than curr, and if so true is returned
-        if ((currPriority >= leftPriority) && (currPriority >= rightPriority)){
-            return result && true;
-        }
-        else{
-            return result && false; //else, false is returned
-        }
+        //testNodePool tested
+        cout << "testNodePool starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testNodePool(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testNodePool tested again
+        cout << "testNodePool starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testNodePool(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK TWENTY ***" << endl;
     }
-}
 
-//minheapInsertion
-//Checks to ensure that the minheap property is upheld for every item inserted
-bool Tester::minheapInsertion(CQueue& cqueue, int num){
-    bool result = true;
+    {
+        cout << "\n*** TEST BLOCK TWENTY-ONE ***" << endl << endl;
+        cout << "This will test that the priority cached in each node stays correct" << endl << endl;
 
-    //first checks to ensure the cqueue sent is in fact a minheap
-    result = result && (cqueue.m_heapType == MINHEAP);
+        newCQueue = new CQueue(priorityFn2, MINHEAP, SKEW); //cqueue initialized
 
-    //random variables created
-    Random orderIdGen(MINORDERID,MAXORDERID);
-    Random customerIdGen(MINCUSTID,MAXCUSTID);
-    customerIdGen.setSeed(0);
-    Random membershipGen(0,5); // there are six tiers
-    Random pointsGen(MINPOINTS,MAXPOINTS);
-    Random itemGen(0,5); // there are six items
-    Random countGen(0,3); // there are three possible quantity values
+        //testCachedPriority tested
+        cout << "testCachedPriority starting with priorFn2, MINHEAP, SKEW: \n\t";
+        bool testResult = tester.testCachedPriority(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-    //for loop goes through based on the number sent
-    //after each insertion, the minheap property is tested to ensure it upholds
-    for (int i = 0; i < num; i++){
-        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
-                    static_cast<COUNT>(countGen.getRandNum()),
-                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
-                    pointsGen.getRandNum(),
-                    customerIdGen.getRandNum(),
-                    orderIdGen.getRandNum());
-        cqueue.insertOrder(anOrder);
-        result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
-    }
+        //testCachedPriority tested again
+        cout << "testCachedPriority starting with priorFn1, MAXHEAP, LEFTIST: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, LEFTIST); //cqueue initialized
+        testResult = tester.testCachedPriority(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-    //checks to ensure size is equal to num
-    result = result && (cqueue.m_size == num);
+        cout << "\n***END TEST BLOCK TWENTY-ONE ***" << endl;
+    }
 
-    //after testing, the result is then returned
-    return result;
-}
+    {
+        cout << "\n*** TEST BLOCK TWENTY-TWO ***" << endl << endl;
+        cout << "This will test the compile-time BasicCQueue against the runtime CQueue" << endl << endl;
 
-//minheapRemoval
-//removes elements from a minheap to ensure that the property still upholds
-bool Tester::minheapRemoval(CQueue& cqueue, int num){
-    bool result = true;
+        //testBasicCQueue tested
+        cout << "testBasicCQueue with PointsPriority, MAXHEAP, LEFTIST and priorFn2, MINHEAP, SKEW: \n\t";
+        bool testResult = tester.testBasicCQueue();
+        tester.testCondition(testResult);
 
-    //first checks to ensure cqueue is a minheap
-    result = result && (cqueue.m_heapType == MINHEAP);
+        cout << "\n***END TEST BLOCK TWENTY-TWO ***" << endl;
+    }
 
-    //calls upon minheapInsertion to fill the cqueue
-    result = result && minheapInsertion(cqueue, num);
+    {
+        cout << "\n*** TEST BLOCK TWENTY-THREE ***" << endl << endl;
+        cout << "This will test the bulk insertion of orders" << endl << endl;
 
-    //array created for popped orders
-    Order poppedOrders[num];
-    try{
-        //first, half of the nodes are removed
-        //after each removal, checks to ensure leftist heap is still upheld
-        //every order popped off is then sent to an array
-        for (int i = 0; i < int(num/2); i++){
-            poppedOrders[i] = cqueue.getNextOrder(); //popped order added to array
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
-            
-            //if statement checks to see if the popped order has a greater than or equal to priority than the previous one popped
-            if (i > 0){
-                result = result && (cqueue.m_priorFunc(poppedOrders[i]) >= cqueue.m_priorFunc(poppedOrders[i -1]));
-            } 
-        }
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
 
-        //checks to ensure cqueue size is half of what it was previous
-        if (num % 2 == 0){
-            result = result && (cqueue.m_size == int(num/2));
-        }
-        else{
-            result = result && (cqueue.m_size == int(num/2) + 1);
-        }
+        //testInsertOrders tested
+        cout << "testInsertOrders starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testInsertOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-        //one final test to ensure property is upheld
-        result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+        //testInsertOrders tested again
+        cout << "testInsertOrders starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testInsertOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-        //the final half are then removed
-        for (int i = num/2; i < num; i++){
-            poppedOrders[i] = cqueue.getNextOrder(); //popped order added to array
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
-            
-            //array checks again to ensure property is upheld
-            result = result && (cqueue.m_priorFunc(poppedOrders[i]) >= cqueue.m_priorFunc(poppedOrders[i -1]));
-        }
+        //testInsertOrders tested again
+        cout << "testInsertOrders starting with priorFn1, MAXHEAP, LEFTIST: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, LEFTIST); //cqueue initialized
+        testResult = tester.testInsertOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
 
-        //checks if m_size is zero and if m_heap is a nullptr, which it should be
-        result = result && (cqueue.m_size == 0);
-        result = result && (cqueue.m_heap == nullptr);
+        cout << "\n***END TEST BLOCK TWENTY-THREE ***" << endl;
     }
-    //catches out of range and returns false
-    catch(const out_of_range &range){
-        result = false;
-    }
-    return result;
-}
 
-//maxheapInsertion
-//Checks to ensure that the maxheap property is upheld for every item inserted
+    {
+        cout << "\n*** TEST BLOCK TWENTY-FOUR ***" << endl << endl;
+        cout << "This will test that setPriorityFn and setStructure rebuild the heap in place" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, SKEW); //cqueue initialized
+
+        //testInPlaceRebuild tested
+        cout << "testInPlaceRebuild starting with priorFn2, MINHEAP, SKEW: \n\t";
+        bool testResult = tester.testInPlaceRebuild(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testInPlaceRebuild tested again
+        cout << "testInPlaceRebuild starting with priorFn1, MAXHEAP, LEFTIST: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, LEFTIST); //cqueue initialized
+        testResult = tester.testInPlaceRebuild(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK TWENTY-FOUR ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK TWENTY-FIVE ***" << endl << endl;
+        cout << "This will test the move constructor and move assignment operator" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testMoveSemantics tested
+        cout << "testMoveSemantics starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testMoveSemantics(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testMoveSemantics tested again
+        cout << "testMoveSemantics starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testMoveSemantics(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK TWENTY-FIVE ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK TWENTY-SIX ***" << endl << endl;
+        cout << "This will test removing orders in batches" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, SKEW); //cqueue initialized
+
+        //testGetNextOrders tested
+        cout << "testGetNextOrders starting with priorFn2, MINHEAP, SKEW: \n\t";
+        bool testResult = tester.testGetNextOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testGetNextOrders tested again
+        cout << "testGetNextOrders starting with priorFn1, MAXHEAP, LEFTIST: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, LEFTIST); //cqueue initialized
+        testResult = tester.testGetNextOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK TWENTY-SIX ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK TWENTY-SEVEN ***" << endl << endl;
+        cout << "This will test the array based DARY structure" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, DARY); //cqueue initialized
+
+        //testDaryHeap tested
+        cout << "testDaryHeap starting with priorFn2, MINHEAP, DARY, arity 4: \n\t";
+        bool testResult = tester.testDaryHeap(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testDaryHeap tested again
+        cout << "testDaryHeap starting with priorFn1, MAXHEAP, DARY, arity 2: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, DARY, 2); //cqueue initialized
+        testResult = tester.testDaryHeap(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testDaryHeap tested again
+        cout << "testDaryHeap starting with priorFn1, MAXHEAP, DARY, arity 8: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, DARY, 8); //cqueue initialized
+        testResult = tester.testDaryHeap(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK TWENTY-SEVEN ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK TWENTY-EIGHT ***" << endl << endl;
+        cout << "This will test the PAIRING structure" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, PAIRING); //cqueue initialized
+
+        //testPairingHeap tested
+        cout << "testPairingHeap starting with priorFn2, MINHEAP, PAIRING: \n\t";
+        bool testResult = tester.testPairingHeap(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testPairingHeap tested again
+        cout << "testPairingHeap starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testPairingHeap(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //a pairing heap with one long sibling list tested
+        cout << "deepMergeTest with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.deepMergeTest(*newCQueue, LARGE_CASE);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK TWENTY-EIGHT ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK TWENTY-NINE ***" << endl << endl;
+        cout << "This will test bucket mode for small priority ranges" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testBucketMode tested
+        cout << "testBucketMode starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testBucketMode(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testBucketMode tested again
+        cout << "testBucketMode starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testBucketMode(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testBucketMode tested again
+        cout << "testBucketMode starting with priorFn2, MINHEAP, DARY: \n\t";
+        newCQueue = new CQueue(priorityFn2, MINHEAP, DARY); //cqueue initialized
+        testResult = tester.testBucketMode(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testBucketMode tested again
+        cout << "testBucketMode starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testBucketMode(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK TWENTY-NINE ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK THIRTY ***" << endl << endl;
+        cout << "This will test the thread-safe ConcurrentCQueue" << endl << endl;
+
+        //testConcurrentQueue tested
+        cout << "testConcurrentQueue with priorFn2, MINHEAP, LEFTIST: \n\t";
+        ConcurrentCQueue* ccqueue = new ConcurrentCQueue(priorityFn2, MINHEAP, LEFTIST); //ccqueue initialized
+        bool testResult = tester.testConcurrentQueue(*ccqueue);
+        tester.testCondition(testResult);
+        delete ccqueue;
+
+        //testConcurrentQueue tested again
+        cout << "testConcurrentQueue with priorFn1, MAXHEAP, DARY: \n\t";
+        ccqueue = new ConcurrentCQueue(priorityFn1, MAXHEAP, DARY); //ccqueue initialized
+        testResult = tester.testConcurrentQueue(*ccqueue);
+        tester.testCondition(testResult);
+        delete ccqueue;
+
+        //testCombinerException tested
+        cout << "testCombinerException, inserts that throw reach their own thread and the queue keeps working: \n\t";
+        testResult = tester.testCombinerException();
+        tester.testCondition(testResult);
+
+        cout << "\n***END TEST BLOCK THIRTY ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK THIRTY-ONE ***" << endl << endl;
+        cout << "This will test the relaxed MultiCQueue" << endl << endl;
+
+        //testMultiQueue tested
+        cout << "testMultiQueue with priorFn2, MINHEAP, SKEW: \n\t";
+        MultiCQueue* mqueue = new MultiCQueue(priorityFn2, MINHEAP, SKEW, NUM_THREADS); //mqueue initialized
+        bool testResult = tester.testMultiQueue(*mqueue);
+        tester.testCondition(testResult);
+        delete mqueue;
+
+        //testMultiQueue tested again
+        cout << "testMultiQueue with priorFn1, MAXHEAP, PAIRING: \n\t";
+        mqueue = new MultiCQueue(priorityFn1, MAXHEAP, PAIRING, NUM_THREADS); //mqueue initialized
+        testResult = tester.testMultiQueue(*mqueue);
+        tester.testCondition(testResult);
+        delete mqueue;
+
+        cout << "\n***END TEST BLOCK THIRTY-ONE ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK THIRTY-TWO ***" << endl << endl;
+        cout << "This will test lazy mergeWithQueue" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testLazyMerge tested
+        cout << "testLazyMerge starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testLazyMerge(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testLazyMerge tested again
+        cout << "testLazyMerge starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testLazyMerge(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testLazyMerge tested again
+        cout << "testLazyMerge starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testLazyMerge(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK THIRTY-TWO ***" << endl;
+    }
+    {
+        CQueue* newCQueue;
+        Tester tester;
+        cout << "\n*** TEST BLOCK THIRTY-THREE ***" << endl << endl;
+        cout << "This will test order handles and updateOrder" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testUpdateOrder tested
+        cout << "testUpdateOrder starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testUpdateOrder(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testUpdateOrder tested again
+        cout << "testUpdateOrder starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testUpdateOrder(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testUpdateOrder tested again
+        cout << "testUpdateOrder starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testUpdateOrder(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testUpdateOrder tested again
+        cout << "testUpdateOrder starting with priorFn2, MINHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn2, MINHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testUpdateOrder(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK THIRTY-THREE ***" << endl;
+    }
+    {
+        CQueue* newCQueue;
+        Tester tester;
+        cout << "\n*** TEST BLOCK THIRTY-FOUR ***" << endl << endl;
+        cout << "This will test cancelOrder with and without the order ID index" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testCancelOrder tested
+        cout << "testCancelOrder starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testCancelOrder(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testCancelOrder tested again
+        cout << "testCancelOrder starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testCancelOrder(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testCancelOrder tested again
+        cout << "testCancelOrder starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testCancelOrder(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK THIRTY-FOUR ***" << endl;
+    }
+    {
+        Tester tester;
+        cout << "\n*** TEST BLOCK THIRTY-FIVE ***" << endl << endl;
+        cout << "This will test the packed Order layout" << endl << endl;
+
+        //testCompactOrder tested
+        cout << "testCompactOrder: \n\t";
+        bool testResult = tester.testCompactOrder();
+        tester.testCondition(testResult);
+
+        cout << "\n***END TEST BLOCK THIRTY-FIVE ***" << endl;
+    }
+    {
+        CQueue* newCQueue;
+        Tester tester;
+        cout << "\n*** TEST BLOCK THIRTY-SIX ***" << endl << endl;
+        cout << "This will test clearing, copying and printing a tree of linear depth" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, SKEW); //cqueue initialized
+
+        //testDeepTree tested
+        cout << "testDeepTree starting with priorFn2, MINHEAP, SKEW: \n\t";
+        bool testResult = tester.testDeepTree(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testDeepTree tested again
+        cout << "testDeepTree starting with priorFn1, MAXHEAP, LEFTIST: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, LEFTIST); //cqueue initialized
+        testResult = tester.testDeepTree(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK THIRTY-SIX ***" << endl;
+    }
+    {
+        CQueue* newCQueue;
+        Tester tester;
+        cout << "\n*** TEST BLOCK THIRTY-SEVEN ***" << endl << endl;
+        cout << "This will test peekTopOrders" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testPeekTopOrders tested
+        cout << "testPeekTopOrders starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testPeekTopOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testPeekTopOrders tested again
+        cout << "testPeekTopOrders starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testPeekTopOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testPeekTopOrders tested again
+        cout << "testPeekTopOrders starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testPeekTopOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testPeekTopOrders tested again
+        cout << "testPeekTopOrders starting with priorFn1, MINHEAP, DARY: \n\t";
+        newCQueue = new CQueue(priorityFn1, MINHEAP, DARY); //cqueue initialized
+        testResult = tester.testPeekTopOrders(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK THIRTY-SEVEN ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK THIRTY-EIGHT ***" << endl << endl;
+        cout << "This will test saveSnapshot and loadSnapshot" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testSnapshot tested
+        cout << "testSnapshot starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testSnapshot(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testSnapshot tested again
+        cout << "testSnapshot starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testSnapshot(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testSnapshot tested again
+        cout << "testSnapshot starting with priorFn2, MINHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn2, MINHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testSnapshot(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testSnapshot tested again
+        cout << "testSnapshot starting with priorFn1, MAXHEAP, DARY: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, DARY, 8); //cqueue initialized
+        testResult = tester.testSnapshot(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK THIRTY-EIGHT ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK THIRTY-NINE ***" << endl << endl;
+        cout << "This will test the write-ahead log" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testOrderLog tested
+        cout << "testOrderLog starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testOrderLog(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testOrderLog tested again
+        cout << "testOrderLog starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testOrderLog(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testOrderLog tested again
+        cout << "testOrderLog starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testOrderLog(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testOrderLog tested again
+        cout << "testOrderLog starting with priorFn2, MINHEAP, DARY: \n\t";
+        newCQueue = new CQueue(priorityFn2, MINHEAP, DARY); //cqueue initialized
+        testResult = tester.testOrderLog(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK THIRTY-NINE ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK FORTY ***" << endl << endl;
+        cout << "This will test ingesting orders from CSV and binary files" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testIngest tested
+        cout << "testIngest starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testIngest(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testIngest tested again
+        cout << "testIngest starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testIngest(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testIngest tested again
+        cout << "testIngest starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testIngest(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testIngest tested again
+        cout << "testIngest starting with priorFn2, MINHEAP, DARY: \n\t";
+        newCQueue = new CQueue(priorityFn2, MINHEAP, DARY); //cqueue initialized
+        testResult = tester.testIngest(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK FORTY ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK FORTY-ONE ***" << endl << endl;
+        cout << "This will test the operation counters and latency histograms" << endl << endl;
+
+        newCQueue = new CQueue(priorityFn2, MINHEAP, LEFTIST); //cqueue initialized
+
+        //testStats tested
+        cout << "testStats starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testStats(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testStats tested again
+        cout << "testStats starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, SKEW); //cqueue initialized
+        testResult = tester.testStats(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testStats tested again
+        cout << "testStats starting with priorFn1, MAXHEAP, PAIRING: \n\t";
+        newCQueue = new CQueue(priorityFn1, MAXHEAP, PAIRING); //cqueue initialized
+        testResult = tester.testStats(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        //testStats tested again
+        cout << "testStats starting with priorFn2, MINHEAP, DARY: \n\t";
+        newCQueue = new CQueue(priorityFn2, MINHEAP, DARY); //cqueue initialized
+        testResult = tester.testStats(*newCQueue);
+        tester.testCondition(testResult);
+        delete newCQueue;
+
+        cout << "\n***END TEST BLOCK FORTY-ONE ***" << endl;
+    }
+
+    {
+        cout << "\n*** TEST BLOCK FORTY-TWO ***" << endl << endl;
+        cout << "This will test the persistent queue and its snapshots" << endl << endl;
+
+        PersistentCQueue* pqueue = new PersistentCQueue(priorityFn2, MINHEAP, LEFTIST); //pqueue initialized
+
+        //testPersistentQueue tested
+        cout << "testPersistentQueue starting with priorFn2, MINHEAP, LEFTIST: \n\t";
+        bool testResult = tester.testPersistentQueue(*pqueue);
+        tester.testCondition(testResult);
+        delete pqueue;
+
+        //testPersistentQueue tested again
+        cout << "testPersistentQueue starting with priorFn1, MAXHEAP, SKEW: \n\t";
+        pqueue = new PersistentCQueue(priorityFn1, MAXHEAP, SKEW); //pqueue initialized
+        testResult = tester.testPersistentQueue(*pqueue);
+        tester.testCondition(testResult);
+        delete pqueue;
+
+        //a structure that cannot path-copy its merges is refused
+        cout << "PersistentCQueue with DARY and PAIRING throws domain_error: \n\t";
+        int numThrown = 0;
+        for (STRUCTURE structure : {DARY, PAIRING}){
+            try{
+                PersistentCQueue refused(priorityFn1, MAXHEAP, structure);
+            }
+            catch (const domain_error& e){
+                ++numThrown;
+            }
+        }
+        tester.testCondition(numThrown == 2);
+
+        cout << "\n***END TEST BLOCK FORTY-TWO ***" << endl;
+    }
+
+    cout << "\n**********************" << endl;
+    cout << "***** END TEST *******" << endl;
+    cout << "**********************" << endl;
+
+    return 0;
+}
+
+//priorityFunctions done
+
+int priorityFn1(const Order &order) {
+    //this function works with a MAXHEAP
+    //priority value is determined based on some criteria
+    //priority value falls in the range [0-5003]
+    //the highest priority would be 3+5000 = 5003
+    //the lowest priority would be 0+0 = 0
+    //the larger value means the higher priority
+    int priority = static_cast<int>(order.getCount()) + order.getPoints();
+    return priority;
+}
+
+int priorityFn2(const Order &order) {
+    //this funcction works with a MINHEAP
+    //priority value is determined based on some criteria
+    //priority value falls in the range [0-10]
+    //the highest priority would be 0+0 = 0
+    //the lowest priority would be 5+5 =10
+    //the smaller value means the higher priority
+    int priority = static_cast<int>(order.getItem()) + static_cast<int>(order.getMemebership());
+    return priority;
+}
+
+int failingFn(const Order &order) {
+    //this function works with a MINHEAP
+    //it gives the priority of priorityFn2, but throws bad_alloc for every order ID that is a multiple of
+    //FAIL_EVERY, so a request can fail partway through an insertion the way an allocation would
+    if (order.getOrderID() % FAIL_EVERY == 0){
+        throw bad_alloc();
+    }
+    return priorityFn2(order);
+}
+
+//testCondition
+//displays the output of the test whether it passed or failed
+void Tester::testCondition(bool var){
+    if (var){
+        cout << "This test has passed" << endl << endl;
+    }
+    else{
+        cout << "This test has failed" << endl << endl;
+    }
+}
+
+//randomFill
+//fills the cQueue sent with random order
+void Tester::randomFill(CQueue& aqueue, int numToFill){
+    Random orderIdGen(MINORDERID,MAXORDERID);
+    Random customerIdGen(MINCUSTID,MAXCUSTID);
+    customerIdGen.setSeed(0);
+    Random membershipGen(0,5); // there are six tiers
+    Random pointsGen(MINPOINTS,MAXPOINTS);
+    Random itemGen(0,5); // there are six items
+    Random countGen(0,3); // there are three possible quantity values
+    for (int i = 0; i < numToFill; i++){
+        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
+                    static_cast<COUNT>(countGen.getRandNum()),
+                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
+                    pointsGen.getRandNum(),
+                    customerIdGen.getRandNum(),
+                    orderIdGen.getRandNum());
+        aqueue.insertOrder(anOrder);
+    }
+}
+
+//minheapTest
+//checks to ensure the MINHEAP property upholds for every node
+bool Tester::minheapTest(bool result, const Node* curr, prifn_t priorFn){
+    if (curr == nullptr){
+        return result;
+    }
+    else{
+        //minheap test called using preorder traversal
+        result = result && minheapTest(result, curr->m_left, priorFn);
+        result = result && minheapTest(result, curr->m_right, priorFn);
+        
+        //curr, left and right priority are declared and initialized
+        //checks if nullptr, if so returns a value out of range so always tue
+        int currPriority = priorFn(curr->getOrder());
+        int leftPriority = ((curr->m_left == nullptr) ? 999999: priorFn(curr->m_left->getOrder()));
+        int rightPriority = ((curr->m_right == nullptr) ? 999999: priorFn(curr->m_right->getOrder()));
+
+        //if statement checks to make sure both are greater than curr, and if so true is returned
+        if ((currPriority <= leftPriority) && (currPriority <= rightPriority)){
+            return result && true;
+        }
+        else{
+            return result && false; //else, false is returned
+        }
+    }
+}
+
+//maxheapTest
+//recursive test which ensures maxheap property upholds
+bool Tester::maxheapTest(bool result, const Node* curr, prifn_t priorFn){
+    if (curr == nullptr){
+        return result;
+    }
+    else{
+        //maxheap test called using postorder traversal
+        result = result && maxheapTest(result, curr->m_left, priorFn);
+        result = result && maxheapTest(result, curr->m_right, priorFn);
+        
+        //curr, left and right priority are declared and initialized
+        //checks if nullptr, if so returns a value out of range so always true
+        int currPriority = priorFn(curr->getOrder());
+        int leftPriority = ((curr->m_left == nullptr) ? -1: priorFn(curr->m_left->getOrder()));
+        int rightPriority = ((curr->m_right == nullptr) ? -1: priorFn(curr->m_right->getOrder()));
+        
+        //if statement checks to make sure both are less than curr, and if so true is returned
+        if ((currPriority >= leftPriority) && (currPriority >= rightPriority)){
+            return result && true;
+        }
+        else{
+            return result && false; //else, false is returned
+        }
+    }
+}
+
+//minheapInsertion
+//Checks to ensure that the minheap property is upheld for every item inserted
+bool Tester::minheapInsertion(CQueue& cqueue, int num){
+    bool result = true;
+
+    //first checks to ensure the cqueue sent is in fact a minheap
+    result = result && (cqueue.m_heapType == MINHEAP);
+
+    //random variables created
+    Random orderIdGen(MINORDERID,MAXORDERID);
+    Random customerIdGen(MINCUSTID,MAXCUSTID);
+    customerIdGen.setSeed(0);
+    Random membershipGen(0,5); // there are six tiers
+    Random pointsGen(MINPOINTS,MAXPOINTS);
+    Random itemGen(0,5); // there are six items
+    Random countGen(0,3); // there are three possible quantity values
+
+    //for loop goes through based on the number sent
+    //after each insertion, the minheap property is tested to ensure it upholds
+    for (int i = 0; i < num; i++){
+        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
+                    static_cast<COUNT>(countGen.getRandNum()),
+                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
+                    pointsGen.getRandNum(),
+                    customerIdGen.getRandNum(),
+                    orderIdGen.getRandNum());
+        cqueue.insertOrder(anOrder);
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    }
+
+    //checks to ensure size is equal to num
+    result = result && (cqueue.m_size == num);
+
+    //after testing, the result is then returned
+    return result;
+}
+
+//minheapRemoval
+//removes elements from a minheap to ensure that the property still upholds
+bool Tester::minheapRemoval(CQueue& cqueue, int num){
+    bool result = true;
+
+    //first checks to ensure cqueue is a minheap
+    result = result && (cqueue.m_heapType == MINHEAP);
+
+    //calls upon minheapInsertion to fill the cqueue
+    result = result && minheapInsertion(cqueue, num);
+
+    //array created for popped orders
+    Order poppedOrders[num];
+    try{
+        //first, half of the nodes are removed
+        //after each removal, checks to ensure leftist heap is still upheld
+        //every order popped off is then sent to an array
+        for (int i = 0; i < int(num/2); i++){
+            poppedOrders[i] = cqueue.getNextOrder(); //popped order added to array
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+            
+            //if statement checks to see if the popped order has a greater than or equal to priority than the previous one popped
+            if (i > 0){
+                result = result && (cqueue.m_priorFunc(poppedOrders[i]) >= cqueue.m_priorFunc(poppedOrders[i -1]));
+            } 
+        }
+
+        //checks to ensure cqueue size is half of what it was previous
+        if (num % 2 == 0){
+            result = result && (cqueue.m_size == int(num/2));
+        }
+        else{
+            result = result && (cqueue.m_size == int(num/2) + 1);
+        }
+
+        //one final test to ensure property is upheld
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+
+        //the final half are then removed
+        for (int i = num/2; i < num; i++){
+            poppedOrders[i] = cqueue.getNextOrder(); //popped order added to array
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+            
+            //array checks again to ensure property is upheld
+            result = result && (cqueue.m_priorFunc(poppedOrders[i]) >= cqueue.m_priorFunc(poppedOrders[i -1]));
+        }
+
+        //checks if m_size is zero and if m_heap is a nullptr, which it should be
+        result = result && (cqueue.m_size == 0);
+        result = result && (cqueue.m_heap == nullptr);
+    }
+    //catches out of range and returns false
+    catch(const out_of_range &range){
+        result = false;
+    }
+    return result;
+}
+
+//maxheapInsertion
+//Checks to ensure that the maxheap property is upheld for every item inserted
 bool Tester::maxheapInsertion(CQueue& cqueue, int num){
     bool result = true;
 
-    //first checks to ensure the cqueue sent is in fact a maxheap
-    result = result && (cqueue.m_heapType == MAXHEAP);
+    //first checks to ensure the cqueue sent is in fact a maxheap
+    result = result && (cqueue.m_heapType == MAXHEAP);
+
+    //random variables created
+    Random orderIdGen(MINORDERID,MAXORDERID);
+    Random customerIdGen(MINCUSTID,MAXCUSTID);
+    customerIdGen.setSeed(0);
+    Random membershipGen(0,5); // there are six tiers
+    Random pointsGen(MINPOINTS,MAXPOINTS);
+    Random itemGen(0,5); // there are six items
+    Random countGen(0,3); // there are three possible quantity values
+
+    //for loop goes through based on the number sent
+    //after each insertion, the maxheap property is tested to ensure it upholds
+    for (int i = 0; i < num; i++){
+        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
+                    static_cast<COUNT>(countGen.getRandNum()),
+                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
+                    pointsGen.getRandNum(),
+                    customerIdGen.getRandNum(),
+                    orderIdGen.getRandNum());
+        cqueue.insertOrder(anOrder);
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    }
+
+    //checks to ensure size is equal to num
+    result = result && (cqueue.m_size == num);
+
+    //after testing, the result is then returned
+    return result;
+}
+
+//maxheapRemoval
+//removes elements from a maxheap to ensure that the property still upholds
+bool Tester::maxheapRemoval(CQueue& cqueue, int num){
+    bool result = true;
+
+    //first checks to ensure cqueue is a maxheap
+    result = result && (cqueue.m_heapType == MAXHEAP);
+
+    //calls upon maxheapInsertion to fill the cqueue
+    result = result && maxheapInsertion(cqueue, num);
+
+    //array created for popped orders
+    Order poppedOrders[num];
+    
+    //try catch block used to ensure no errors occur
+    try{
+        //for loop goes through and removes half of the nodes
+        //each removal is popped onto the array, which is then checked to ensure as the index becomes greater, the numbers are lower
+        for (int i = 0; i < int(num/2); i++){
+            poppedOrders[i] = cqueue.getNextOrder(); //popped order added to array
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc); //tested each time to ensure maxheap property upholds
+            
+            //if statement checks to see if the popped order has a less than or equal to priority than the previous one popped
+            //i > 0 to prevent seg faults
+            if (i > 0){
+                result = result && (cqueue.m_priorFunc(poppedOrders[i]) <= cqueue.m_priorFunc(poppedOrders[i -1]));
+            } 
+        }
+
+        //checks to ensure cqueue size is half of what it was previous
+        if (num % 2 == 0){
+            result = result && (cqueue.m_size == int(num/2));
+        }
+        else{
+            result = result && (cqueue.m_size == int(num/2) + 1);
+        }
+
+        //one final test to ensure property is upheld
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+
+        //the final half are then removed, maxheap property once again tested
+        for (int i = num/2; i < num; i++){
+            poppedOrders[i] = cqueue.getNextOrder(); //popped order added to array
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+            
+            //array checks again to ensure property is upheld
+            result = result && (cqueue.m_priorFunc(poppedOrders[i]) <= cqueue.m_priorFunc(poppedOrders[i -1]));
+        }
+
+        //checks if m_size is zero and if m_heap is a nullptr, which it should be
+        result = result && (cqueue.m_size == 0);
+        result = result && (cqueue.m_heap == nullptr);
+    }
+    //catches out of range and returns false
+    catch(const out_of_range &range){
+        result = false;
+    }
+    return result;
+}
+
+//leftistNPLProperty
+//Tests to ensure that the leftist heap stays consistent after insertions
+bool Tester::leftistNPLProperty(CQueue& cqueue, int num){
+    bool result = true;
+
+    //first checks to ensure that the cqueue is in fact leftist
+    result = result && (cqueue.m_structure == LEFTIST);
+
+    //random variables created
+    Random orderIdGen(MINORDERID,MAXORDERID);
+    Random customerIdGen(MINCUSTID,MAXCUSTID);
+    customerIdGen.setSeed(0);
+    Random membershipGen(0,5); // there are six tiers
+    Random pointsGen(MINPOINTS,MAXPOINTS);
+    Random itemGen(0,5); // there are six items
+    Random countGen(0,3); // there are three possible quantity values
+
+    //for loop inserts as many nodes as the user would like, and the NPL property is checked each time
+    for (int i = 0; i < num; i++){
+        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
+                    static_cast<COUNT>(countGen.getRandNum()),
+                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
+                    pointsGen.getRandNum(),
+                    customerIdGen.getRandNum(),
+                    orderIdGen.getRandNum());
+        cqueue.insertOrder(anOrder);
+        result = result && NPLTest(result, cqueue.m_heap);
+    }
+
+    //checks to ensure size is equal to num
+    result = result && (cqueue.m_size == num);
+
+    //if statement determines which type of heap it is, and checks to ensure the heapType property is upheld
+    if (cqueue.m_heapType == MINHEAP){
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    }
+    else{
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    }
+
+    //all nodes are then removed, and NPL test is run again to ensure it upholds
+    for (int i = 0; i < num; i++){
+        cqueue.getNextOrder();
+        result = result && NPLTest(result, cqueue.m_heap);
+    }
+
+    //checks to ensure m_size is zero
+    result = result && (cqueue.m_size == 0);
+
+    return result; //result returned
+}
+
+//leftistHeapTest
+//Checks to ensure that the leftist node upholds for every insertion
+bool Tester::leftistHeapTest(CQueue& cqueue, int num){
+    bool result = true;
+
+    //first checks to ensure that the cqueue is in fact leftist
+    result = result && (cqueue.m_structure == LEFTIST);
+
+    //random variables created
+    Random orderIdGen(MINORDERID,MAXORDERID);
+    Random customerIdGen(MINCUSTID,MAXCUSTID);
+    customerIdGen.setSeed(0);
+    Random membershipGen(0,5); // there are six tiers
+    Random pointsGen(MINPOINTS,MAXPOINTS);
+    Random itemGen(0,5); // there are six items
+    Random countGen(0,3); // there are three possible quantity values
+
+    //for loop inserts as many nodes as the user would like, and the leftist test is run each time
+    for (int i = 0; i < num; i++){
+        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
+                    static_cast<COUNT>(countGen.getRandNum()),
+                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
+                    pointsGen.getRandNum(),
+                    customerIdGen.getRandNum(),
+                    orderIdGen.getRandNum());
+        cqueue.insertOrder(anOrder);
+        result = result && leftistTest(result, cqueue.m_heap);
+    }
+
+    //checks to ensure size is equal to num, and the NPL property is also checked
+    result = result && (cqueue.m_size == num);
+    result = result && NPLTest(result, cqueue.m_heap);
+
+    //if statement determines which type of heap it is, and checks to ensure the heapType property is upheld
+    if (cqueue.m_heapType == MINHEAP){
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    }
+    else{
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    }
+
+    //all nodes are then removed, and leftist test is run again to ensure it upholds
+    for (int i = 0; i < num; i++){
+        cqueue.getNextOrder();
+        result = result && leftistTest(result, cqueue.m_heap);
+    }
+
+    //checks to ensure m_size is zero
+    result = result && (cqueue.m_size == 0);
+
+    return result; //result returned
+}
+
+//NPLTest
+//Checks the node of every node to ensure that the updateNPL function works properly
+bool Tester::NPLTest(bool result, const Node* curr){
+    if (curr == nullptr){
+        return result;
+    }
+    else{
+        //result called for left and right nodes for postorder traversal
+        result = result && NPLTest(result, curr->m_left);
+        result = result && NPLTest(result, curr->m_right);
+        
+        //two if statements used to check the NPL of both left and right
+        //ternary operator used to prevent seg faults
+        int leftNPL = ((curr->m_left == nullptr) ? 0 : curr->m_left->getNPL());
+        int rightNPL = ((curr->m_right == nullptr) ? 0 : curr->m_right->getNPL());
+
+        //correctNPL is created based on which NPL is lower, as it should have the lower value
+        int correctNPL = 1 + ((leftNPL < rightNPL) ? leftNPL : rightNPL);
+
+        //if statement checks to ensure the NPL of curr is equal to the NPL it should be, and the children passed
+        if (curr->getNPL() == correctNPL){
+            return result;
+        }
+        else{
+            return false;
+        }
+    }
+}
+
+//leftistTest
+//Checks to ensure that the leftist property of the left node having a greater NPL than the right is upheld
+bool Tester::leftistTest(bool result, const Node* curr){
+    if (curr == nullptr){
+        return result;
+    }
+    else{
+        //result called for left and right nodes for postorder traversal
+        result = result && leftistTest(result, curr->m_left);
+        result = result && leftistTest(result, curr->m_right);
+        
+        //two if statements used to check the NPL of both left and right
+        //ternary operator used to prevent seg faults
+        int leftNPL = ((curr->m_left == nullptr) ? 0 : curr->m_left->getNPL());
+        int rightNPL = ((curr->m_right == nullptr) ? 0 : curr->m_right->getNPL());
+
+        //if statement checks to ensure the NPL of the left node is greater than the right one, and the children passed
+        if (leftNPL >= rightNPL){
+            return result;
+        }
+        //else, false is returned, since the right node should not be greater
+        else{
+            return false;
+        }
+    }
+}
+
+//testPriorityFunction
+//tests the setter for priority function to ensure it works properly
+bool Tester::testPriorityFunction(CQueue& cqueue){
+    bool result = true;
+    
+    //current values of the heap are saved for later use
+    prifn_t currFn = cqueue.m_priorFunc;
+    HEAPTYPE currHeap = cqueue.m_heapType;
+    //opposite values determines which values are opposite, and assigns the opposite
+    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
+    prifn_t oppFn = ((cqueue.m_priorFunc == priorityFn2) ? priorityFn1 : priorityFn2);
+
+
+    //cqueue randomly filled, however an array keeps track of all of the order IDs as being inserted
+    //array created
+    int orderIDs[NORMAL_CASE];
+    
+    //random variables created
+    Random orderIdGen(MINORDERID,MAXORDERID);
+    Random customerIdGen(MINCUSTID,MAXCUSTID);
+    customerIdGen.setSeed(0);
+    Random membershipGen(0,5); // there are six tiers
+    Random pointsGen(MINPOINTS,MAXPOINTS);
+    Random itemGen(0,5); // there are six items
+    Random countGen(0,3); // there are three possible quantity values
+
+    //for loop inserts a normal case amount of nodes, and list of order IDs added to array
+    for (int i = 0; i < NORMAL_CASE; i++){
+        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
+                    static_cast<COUNT>(countGen.getRandNum()),
+                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
+                    pointsGen.getRandNum(),
+                    customerIdGen.getRandNum(),
+                    orderIdGen.getRandNum());
+        cqueue.insertOrder(anOrder);
+        orderIDs[i] = anOrder.getOrderID();
+    }
+
+    int tempint = cqueue.m_size; //m_size saved for later check
+
+    //for loop is done so that the item switches to the opposite heap, then back
+    for (int i = 0; i < 2; i++){
+        
+        //if statement changes depending on which iteration it is
+        if (i % 2 == 0){
+            //first test done is changing the heap from a MINHEAP to MAXHEAP, or vice versa, with the same priority function
+            cqueue.setPriorityFn(cqueue.m_priorFunc, oppHeap); 
+            result = result && (cqueue.m_heapType == oppHeap);         
+        }
+        else{
+            //set back to original state and compared to previous node
+            cqueue.setPriorityFn(cqueue.m_priorFunc, currHeap);
+            //first checks to ensure that the heap type actually changed, and that m_size is the same
+            result = result && (cqueue.m_heapType == currHeap);
+        }
+
+        result = result && (cqueue.m_size == tempint);
+
+        //for loop goes through and ensures each orderID is found
+        for (int i = 0; i < NORMAL_CASE; i++){
+            result = result && find(false, cqueue.m_heap, orderIDs[i]);
+        }
+
+        //then if statement checks to ensure properties hold up
+        if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && leftistTest(result, cqueue.m_heap);
+        }
+        else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && leftistTest(result, cqueue.m_heap);
+        }
+        else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        }
+        else{
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        }
+    }
+
+    //next test is done is to test changing the priority function to the opposite to see if changes occur
+    //heap type is also changed
+    //for loop goes three times to test the changes to see if they uphold
+    for (int i = 0; i < 3; i++){
+        switch (i){
+            case 0:
+                cqueue.setPriorityFn(oppFn, currHeap);  
+                //checks to ensure the member variables check
+                result = result && (cqueue.m_heapType == currHeap);
+                result = result && (cqueue.m_priorFunc == oppFn);
+                break;
+            case 1:
+                cqueue.setPriorityFn(oppFn, oppHeap);
+                //checks to ensure the member variables check
+                result = result && (cqueue.m_heapType == oppHeap);
+                result = result && (cqueue.m_priorFunc == oppFn);
+                break;
+            //case 2 returns the function back to start, and checks to see if it remains the same as check
+            case 2:
+                cqueue.setPriorityFn(currFn, currHeap);
+                //checks to ensure the member variables check
+                result = result && (cqueue.m_heapType == currHeap);
+                result = result && (cqueue.m_priorFunc == currFn);
+                break;
+            //default is just set to basic change
+            default:
+                cqueue.setPriorityFn(oppFn, oppHeap);
+                //checks to ensure the member variables check
+                result = result && (cqueue.m_heapType == oppHeap);
+                result = result && (cqueue.m_priorFunc == oppFn);
+        }
+
+        //size checked each time to ensure it didn't change
+        result = result && (cqueue.m_size == tempint);
+
+        //for loop goes through and ensures each orderID is found
+        for (int i = 0; i < NORMAL_CASE; i++){
+            result = result && find(false, cqueue.m_heap, orderIDs[i]);
+        }
+
+        //then if statement checks to ensure properties hold up
+        if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && leftistTest(result, cqueue.m_heap);
+        }
+        else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && leftistTest(result, cqueue.m_heap);
+        }
+        else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        }
+        else{
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        }
+    }
+
+    CQueue* check = new CQueue(cqueue);
+
+    //final checks that if the heap and priorfn is the same as it currently is, nothing changes
+    cqueue.setPriorityFn(currFn, currHeap);
+    result = result && assignmentHelper(result, cqueue.m_heap, check->m_heap);
+    
+    delete check; //check deleted
+    return result; //result returned
+}
+
+//testSetStructure
+//checks to ensure that the structure changes
+bool Tester::testSetStructure(CQueue& cqueue){
+    bool result = true;
+    
+    //current and opposite of each value kept track of
+    STRUCTURE currStruct = cqueue.m_structure;
+    STRUCTURE oppStruct = ((cqueue.m_structure == LEFTIST) ? SKEW: LEFTIST);
+
+    prifn_t currFn = cqueue.m_priorFunc;
+    prifn_t oppFn = ((cqueue.m_priorFunc == priorityFn2) ? priorityFn1 : priorityFn2);
+
+    HEAPTYPE currHeap = cqueue.m_heapType;
+    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
+    
+    
+    //cqueue randomly filled, however an array keeps track of all of the order IDs as being inserted
+    //array created
+    int orderIDs[NORMAL_CASE];
+    
+    //random variables created
+    Random orderIdGen(MINORDERID,MAXORDERID);
+    Random customerIdGen(MINCUSTID,MAXCUSTID);
+    customerIdGen.setSeed(0);
+    Random membershipGen(0,5); // there are six tiers
+    Random pointsGen(MINPOINTS,MAXPOINTS);
+    Random itemGen(0,5); // there are six items
+    Random countGen(0,3); // there are three possible quantity values
+
+    //for loop inserts a normal case amount of nodes, and list of order IDs added to array
+    for (int i = 0; i < NORMAL_CASE; i++){
+        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
+                    static_cast<COUNT>(countGen.getRandNum()),
+                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
+                    pointsGen.getRandNum(),
+                    customerIdGen.getRandNum(),
+                    orderIdGen.getRandNum());
+        cqueue.insertOrder(anOrder);
+        orderIDs[i] = anOrder.getOrderID();
+    }
+
+    int tempint = cqueue.m_size; //m_size saved for later check
+    
+    //for loop goes through and changes 
+    for (int i = 0; i < 5; i++){
+        //switch statement changes depending on the scenario
+        switch(i){
+            //case 0 changes it to the opposite struct
+            case 0:
+                cqueue.setStructure(oppStruct); //setStructure called
+                
+                //checks to ensure the member variables changed or remained the same
+                result = result && (cqueue.m_structure == oppStruct);
+                result = result && (cqueue.m_heapType == currHeap);
+                result = result && (cqueue.m_priorFunc == currFn);
+                break;
+            //case 1 changes the structure back to the original
+            case 1:
+                cqueue.setStructure(currStruct); //setStructure called and back to original struct
+                
+                //checks to ensure the member variables changed or remained the same
+                result = result && (cqueue.m_structure == currStruct);
+                result = result && (cqueue.m_heapType == currHeap);
+                result = result && (cqueue.m_priorFunc == currFn);
+                break;
+            //in case 2, everything is changed to the opposite
+            case 2:
+                cqueue.setStructure(oppStruct);
+                cqueue.setPriorityFn(oppFn, oppHeap);
+
+                //checks to ensure the member variables changed or remained the same
+                result = result && (cqueue.m_structure == oppStruct);
+                result = result && (cqueue.m_heapType == oppHeap);
+                result = result && (cqueue.m_priorFunc == oppFn);
+
+                break;
+            //case 3 is that the structure is set back to the original, but the heapType are still the opposite
+            case 3:
+                cqueue.setStructure(currStruct);
+
+                //checks to ensure the member variables changed or remained the same
+                result = result && (cqueue.m_structure == currStruct);
+                result = result && (cqueue.m_heapType == oppHeap);
+                result = result && (cqueue.m_priorFunc == oppFn);
+
+                break;
+            //default is that it is changed to the original variables, reached when i = 4
+            default:
+                cqueue.setStructure(currStruct);
+                cqueue.setPriorityFn(currFn, currHeap);
+
+                //checks to ensure the member variables changed or remained the same
+                result = result && (cqueue.m_structure == currStruct);
+                result = result && (cqueue.m_heapType == currHeap);
+                result = result && (cqueue.m_priorFunc == currFn);
+        }
+
+        //size checked each time to ensure it didn't change
+        result = result && (cqueue.m_size == tempint);
+
+        //for loop goes through and ensures each orderID is found
+        for (int i = 0; i < NORMAL_CASE; i++){
+            result = result && find(false, cqueue.m_heap, orderIDs[i]);
+        }
+
+        //then if statement checks to ensure properties hold up
+        if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && leftistTest(result, cqueue.m_heap);
+        }
+        else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && leftistTest(result, cqueue.m_heap);
+        }
+        else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        }
+        else{
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        }
+    }
+
+    CQueue* check = new CQueue(cqueue);
+
+    //final checks that if the structure is the same as it currently is, nothing changes
+    cqueue.setStructure(currStruct);
+    result = result && assignmentHelper(result, cqueue.m_heap, check->m_heap);
+    
+    delete check; //check deleted
+    return result;
+}
+
+//find
+//helper function which finds IDs within the a CQueue
+bool Tester::find(bool result, const Node* curr, int orderID){
+    if (curr == nullptr){
+        return false;
+    }
+    else{
+        //postorder traversal of the object
+        result = result || find(result, curr->m_left, orderID);
+        result = result || find(result, curr->m_right, orderID);
+        
+        //if order ID is found, true is returned
+        if (curr->getOrder().getOrderID() == orderID){
+            return true;
+        }
+        else{
+            return result || false; //else, false is returned
+        }
+    }
+}
+
+//edgeMergeWithQueue
+//tests edge cases of mergeWithQueue
+bool Tester::edgeMergeWithQueue(CQueue& cqueue){
+    bool result = true;
+    
+    //try block ensures that no domain errors occur
+    try{
+
+        //testCQueue created with the cqueue sent
+        CQueue* testCQueue = new CQueue(cqueue);
+
+        //cqueue is then randomly filled
+        randomFill(cqueue, NORMAL_CASE);
+
+        //once it is filled, it is attempted to be merged with the other queue
+        cqueue.mergeWithQueue(*testCQueue);
+
+        //checks to ensure that testCQueue remains empty
+        result = result && (testCQueue->m_heap == nullptr);
+        result = result && (testCQueue->m_size == 0);
+
+        //cqueue cleared, testCQueue filled, and tested again
+        cqueue.clear();
+        randomFill(*testCQueue, NORMAL_CASE);
+
+        //mergeWithQueue called for this edge case
+        cqueue.mergeWithQueue(*testCQueue);
+
+        //checks to ensure that testCQueue became empty
+        result = result && (testCQueue->m_heap == nullptr);
+        result = result && (testCQueue->m_size == 0);        
+
+        //checks and sees if the size changed
+        result = result && (cqueue.m_size == NORMAL_CASE);
+
+        delete testCQueue; //testCQueue deleted
+    }
+    //catch exists to catch any potential domain_errors, and changes result to false
+    catch(const domain_error &domain){
+        result = false;
+    }
+
+    return result;
+}
+
+//testMergeWithQueue
+//tests the mergeWithQueue function to ensure that it merges properly
+bool Tester::testMergeWithQueue(CQueue& cqueue){
+    bool result = true;
+    
+    //current and opposite heaps and priorityFunctions kept track up
+    prifn_t currFn = cqueue.m_priorFunc;
+    HEAPTYPE currHeap = cqueue.m_heapType;
+    
+    //function takes place in the try catch block in case of any potential exceptions thrown
+    try{
+        //testCQueue declared
+        CQueue* testCQueue = new CQueue(currFn, currHeap, cqueue.m_structure);
+        
+        randomFill(cqueue, NORMAL_CASE); //cqueue randomly filled
+        //testCQueue randomly filled then merged with original queue
+        randomFill(*testCQueue, NORMAL_CASE);
+        cqueue.mergeWithQueue(*testCQueue);
+
+        //checks to ensure that testCQueue became empty
+        result = result && (testCQueue->m_heap == nullptr);
+        result = result && (testCQueue->m_size == 0);
+
+        //testCQueue deleted
+        delete testCQueue;
+
+        //checks to see if m_size multipled by 2
+        result = result && (cqueue.m_size == NORMAL_CASE *2);
+
+        //checks to ensure nothing changed
+        result = result && (cqueue.m_heapType == currHeap);
+        result = result && (cqueue.m_priorFunc == currFn);
+
+        //then if statement checks to ensure properties hold up
+        if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && leftistTest(result, cqueue.m_heap);
+        }
+        else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && leftistTest(result, cqueue.m_heap);
+        }
+        else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        }
+        else{
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        }
+    }
+    //catch exists to catch any potential domain_errors, and changes result to false
+    catch(const domain_error &domain){
+        result = false;
+    }
+
+    return result; //result returned
+}
+
+//normalAssignment
+//tests the assignment operator in normal cases
+bool Tester::normalAssignment(CQueue& cqueue){
+    bool result = true;
+
+    //randomFill called
+    randomFill(cqueue, NORMAL_CASE);
+
+    //opposite values determines which values are opposite, and creates the opposite
+    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
+    STRUCTURE oppStruct = ((cqueue.m_structure == LEFTIST) ? SKEW: LEFTIST);
+
+    //three queues created, one with the copy constructor, one with the same as the sent queue and the other with opposite
+    CQueue* sameQueue = new CQueue(cqueue); 
+    CQueue* newQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    CQueue* oppQueue = new CQueue(cqueue.m_priorFunc, oppHeap, oppStruct);
+
+    //first checked is sameQueue to ensure it is exactly the same as cqueue, but in different locations
+    result = result && (cqueue.m_heap != sameQueue->m_heap);
+    result = result && assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap);
+    
+    //newQueue and oppQueue are both filled, newQueue plus one to prevent potential repeats
+    randomFill(*newQueue, NORMAL_CASE + 1);
+    randomFill(*oppQueue, NORMAL_CASE);
+
+    //first assignment is to the newQueue, to see if everything changed properly
+    cqueue = *newQueue;
+    //member variables are checked
+    result = result && (cqueue.m_size == newQueue->m_size);
+    result = result && (cqueue.m_heapType == newQueue->m_heapType);
+    result = result && (cqueue.m_structure == newQueue->m_structure);
+    result = result && (cqueue.m_priorFunc == newQueue->m_priorFunc);
+    result = result && (cqueue.m_heap != newQueue->m_heap);
+
+    //assignment helper called for final check, and also checked to ensure not equal to same heap
+    result = result && assignmentHelper(result, cqueue.m_heap, newQueue->m_heap);
+    result = result && !(assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap));
+
+    //tests then run to ensure properties hold up
+    if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        result = result && leftistTest(result, cqueue.m_heap);
+    }
+    else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        result = result && leftistTest(result, cqueue.m_heap);
+    }
+    else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+    }
+    else{
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+    }
+
+    //the second one is then on oppHeap, assignment performed
+    cqueue = *oppQueue;
+    //member variables are checked   
+    result = result && (cqueue.m_size == oppQueue->m_size);
+    result = result && (cqueue.m_heapType == oppQueue->m_heapType);
+    result = result && (cqueue.m_structure == oppQueue->m_structure);
+    result = result && (cqueue.m_priorFunc == oppQueue->m_priorFunc);
+    result = result && (cqueue.m_heap != oppQueue->m_heap);
+
+    //assignment helper called for final check, and also checked to ensure not equal to same heap
+    result = result && assignmentHelper(result, cqueue.m_heap, oppQueue->m_heap);
+    result = result && !(assignmentHelper(result, cqueue.m_heap, newQueue->m_heap));
+
+    //tests then run to ensure properties hold up
+    if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        result = result && leftistTest(result, cqueue.m_heap);
+    }
+    else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        result = result && leftistTest(result, cqueue.m_heap);
+    }
+    else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+    }
+    else{
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+    }
+
+    //all three temporary CQueues deleted
+    delete sameQueue;
+    delete newQueue; 
+    delete oppQueue;
+    return result;
+}
+
+//edgeAssignment
+//Tests the assignment operator in edge cases
+bool Tester::edgeAssignment(CQueue& cqueue){
+    bool result = true;
+
+    //CQueue declared and initialized
+    CQueue* newQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+
+    //assignment used with cQueue and newQueue
+    cqueue = *newQueue;
+    //all member variables checked, and ensured it is a nullptr
+    result = result && (cqueue.m_size == 0);
+    result = result && (cqueue.m_heapType == newQueue->m_heapType);
+    result = result && (cqueue.m_structure == newQueue->m_structure);
+    result = result && (cqueue.m_priorFunc == newQueue->m_priorFunc);
+    result = result && (cqueue.m_heap == nullptr);
+
+    //newQueue deleted, then one object inserted
+    delete newQueue;
+    newQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    randomFill(*newQueue, 1);
+
+    //assignment used with cQueue and newQueue
+    cqueue = *newQueue;
+    //all member variables checked, and ensured it is a nullptr
+    result = result && (cqueue.m_size == 1);
+    result = result && (cqueue.m_heapType == newQueue->m_heapType);
+    result = result && (cqueue.m_structure == newQueue->m_structure);
+    result = result && (cqueue.m_priorFunc == newQueue->m_priorFunc);
+    result = result && (cqueue.m_heap != nullptr);
+    result = result && (cqueue.m_heap->getOrder().getOrderID() == newQueue->m_heap->getOrder().getOrderID());
+
+    delete newQueue;
+    //result returned
+    return result;
+}
+
+//assignmentHelper
+//Helps to ensure that both heaps are equal to each other data wise, but not memory wise
+bool Tester::assignmentHelper(bool result, const Node* lhsPtr, const Node* rhsPtr){
+    if ((lhsPtr == nullptr) && (rhsPtr == nullptr)){
+        return result && true;
+    }
+    else if ((lhsPtr != nullptr) && (rhsPtr != nullptr)){
+        bool result = true;
+
+        //m_left and m_right are both checked
+        result = result && assignmentHelper(result, lhsPtr->m_left, rhsPtr->m_left);
+        result = result && assignmentHelper(result, lhsPtr->m_right, rhsPtr->m_right);
+        
+        //if statement checks to ensure all orders are exactly the same by checking the ID, which was established to be unique
+        if ((lhsPtr->getOrder().getOrderID() == rhsPtr->getOrder().getOrderID())){
+            //second if statement checks to ensure the ptrs do not equal each other, and also checks some other variables to ensure also the same
+            if ((lhsPtr != rhsPtr) && (lhsPtr->m_npl == rhsPtr->m_npl)){
+                return result && true;
+            }
+            else{
+                return result && false; //else, false is returned
+            }
+        }
+        else{
+            return result && false; //else, false is returned
+        }
+    }
+    else{
+        return result && false; //else, result and false is returned
+    }  
+}
+
+//normalCopyConstructor
+//tests copy constructor for normal cases
+bool Tester::normalCopyConstructor(CQueue& cqueue){
+    bool result = true;
+
+    //randomFill called
+    randomFill(cqueue, NORMAL_CASE);
+
+    //first testQueue created to test if equal
+    CQueue* sameQueue = new CQueue(cqueue); 
+
+    //first checked is sameQueue to ensure it is exactly the same as cqueue, but in different locations
+    result = result && assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap);
+
+    //then all member variables are checked
+    result = result && (cqueue.m_size == sameQueue->m_size);
+    result = result && (cqueue.m_heapType == sameQueue->m_heapType);
+    result = result && (cqueue.m_structure == sameQueue->m_structure);
+    result = result && (cqueue.m_priorFunc == sameQueue->m_priorFunc);
+    result = result && (cqueue.m_heap != sameQueue->m_heap);
+
+    //tests then run to ensure properties hold up
+    if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == LEFTIST)){
+        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+        result = result && leftistTest(result, sameQueue->m_heap);
+    }
+    else if ((sameQueue->m_heapType == MAXHEAP) && (sameQueue->m_structure == LEFTIST)){
+        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+        result = result && leftistTest(result, sameQueue->m_heap);
+    }
+    else if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == SKEW)){
+        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    }
+    else{
+        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    }
+
+    //cqueue cleared, then refilled
+    cqueue.clear();
+
+    randomFill(cqueue, NORMAL_CASE + 25);
+
+    delete sameQueue; //sameQueue deleted
+    //double copy constructor done, to show that when copied twice, it'll still equal the same as the original
+    CQueue* tempQueue = new CQueue(cqueue);
+    sameQueue = new CQueue(*tempQueue);
+
+    //first checked is sameQueue to ensure it is exactly the same as cqueue, but in different locations
+    result = result && assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap);
+
+    //then all member variables are checked
+    result = result && (cqueue.m_size == sameQueue->m_size);
+    result = result && (cqueue.m_heapType == sameQueue->m_heapType);
+    result = result && (cqueue.m_structure == sameQueue->m_structure);
+    result = result && (cqueue.m_priorFunc == sameQueue->m_priorFunc);
+    result = result && (cqueue.m_heap != sameQueue->m_heap);
+
+    //tests then run to ensure properties hold up
+    if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == LEFTIST)){
+        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+        result = result && leftistTest(result, sameQueue->m_heap);
+    }
+    else if ((sameQueue->m_heapType == MAXHEAP) && (sameQueue->m_structure == LEFTIST)){
+        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+        result = result && leftistTest(result, sameQueue->m_heap);
+    }
+    else if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == SKEW)){
+        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    }
+    else{
+        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    }
+
+    //everything is then emptied
+    cqueue.clear();
+    delete sameQueue;
+    delete tempQueue;
+
+    //final test is done with assignment operator, then copied over using copy constructor
+    randomFill(cqueue, NORMAL_CASE + 50); //size slightly changed
+    tempQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    *tempQueue = cqueue;
+    sameQueue = new CQueue(*tempQueue);
+
+    //first checked is sameQueue to ensure it is exactly the same as cqueue, but in different locations
+    result = result && assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap);
+
+    //then all member variables are checked
+    result = result && (cqueue.m_size == sameQueue->m_size);
+    result = result && (cqueue.m_heapType == sameQueue->m_heapType);
+    result = result && (cqueue.m_structure == sameQueue->m_structure);
+    result = result && (cqueue.m_priorFunc == sameQueue->m_priorFunc);
+    result = result && (cqueue.m_heap != sameQueue->m_heap);
+
+    //tests then run to ensure properties hold up
+    if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == LEFTIST)){
+        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+        result = result && leftistTest(result, sameQueue->m_heap);
+    }
+    else if ((sameQueue->m_heapType == MAXHEAP) && (sameQueue->m_structure == LEFTIST)){
+        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+        result = result && leftistTest(result, sameQueue->m_heap);
+    }
+    else if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == SKEW)){
+        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    }
+    else{
+        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    }
+
+
+    //all two temporary CQueues deleted
+    delete sameQueue;
+    delete tempQueue; 
+
+    return result;
+}
+
+//edgeCopyConstructor
+//tests copy constructor for edge cases
+bool Tester::edgeCopyConstructor(CQueue& cqueue){
+    bool result = true;
+
+    randomFill(cqueue, 1);//cqueue filled with one object
 
-    //random variables created
-    Random orderIdGen(MINORDERID,MAXORDERID);
-    Random customerIdGen(MINCUSTID,MAXCUSTID);
-    customerIdGen.setSeed(0);
-    Random membershipGen(0,5); // there are six tiers
-    Random pointsGen(MINPOINTS,MAXPOINTS);
-    Random itemGen(0,5); // there are six items
-    Random countGen(0,3); // there are three possible quantity values
+    //first edge case is a copy construtor with an object with only one node
+    CQueue* testCQueue = new CQueue(cqueue);
 
-    //for loop goes through based on the number sent
-    //after each insertion, the maxheap property is tested to ensure it upholds
-    for (int i = 0; i < num; i++){
-        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
-                    static_cast<COUNT>(countGen.getRandNum()),
-                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
-                    pointsGen.getRandNum(),
-                    customerIdGen.getRandNum(),
-                    orderIdGen.getRandNum());
-        cqueue.insertOrder(anOrder);
-        result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    result = result && (testCQueue->m_size == 1);
+    result = result && (testCQueue->m_heapType == cqueue.m_heapType);
+    result = result && (testCQueue->m_structure == cqueue.m_structure);
+    result = result && (testCQueue->m_priorFunc == cqueue.m_priorFunc);
+    result = result && (testCQueue->m_heap != nullptr);
+
+    //assignment helper called to double check
+    result = result && assignmentHelper(result, testCQueue->m_heap, cqueue.m_heap);
+
+    cqueue.clear(); //cqueue set to an empty object
+
+    //two copy constructors are used
+    //the reason this is done is to prove that since the members variables are not initialized until...
+    //the assignment operator is called, the assignment operator still works correctly 
+    CQueue* tempCQueue = new CQueue(cqueue);
+    CQueue* emptyCQueue = new CQueue(*tempCQueue);
+
+    //all member variables are checked between cqueue and emptyCQueue to ensure they match
+    result = result && (emptyCQueue->m_size == 0);
+    result = result && (emptyCQueue->m_heapType == cqueue.m_heapType);
+    result = result && (emptyCQueue->m_structure == cqueue.m_structure);
+    result = result && (emptyCQueue->m_priorFunc == cqueue.m_priorFunc);
+    result = result && (emptyCQueue->m_heap == nullptr);
+
+    //all dynamically allocated objects are deleted
+    delete testCQueue;
+    delete tempCQueue;
+    delete emptyCQueue;
+
+    return result;
+}
+
+//errorDequeue
+//tests to see if an out of range error is caught
+bool Tester::errorDequeue(CQueue& cqueue){
+    bool result = true;
+
+    //all are booleans used to ensure that the test is done correctly
+    bool pureEmpty = false;
+    bool emptyClear = false;
+    bool fullEmpty = false;
+    bool assignEmpty = false;
+
+    //first checks to ensure that the object is empty
+    result = result && (cqueue.m_heap == nullptr);
+    
+    //pure empty tested
+    try{
+        cqueue.getNextOrder();
+    }
+    catch(const out_of_range &range){
+        pureEmpty = true;
     }
 
-    //checks to ensure size is equal to num
-    result = result && (cqueue.m_size == num);
+    //next, the cqueue is cleared
+    randomFill(cqueue, NORMAL_CASE);
+    result = result && (cqueue.m_size == NORMAL_CASE);
+
+    //next, clear is called, then again tested to see if it actually clears
+    cqueue.clear();
+    
+    //empty clear tested
+    try{
+        cqueue.getNextOrder();
+    }
+    catch(const out_of_range &range){
+        emptyClear = true;
+    }
+
+    //next, randomly filled again, and each order is then removed
+    randomFill(cqueue, NORMAL_CASE);
+    try{
+        for (int i = 0; i <= NORMAL_CASE; i++){
+            cqueue.getNextOrder();
+        }
+    }
+    catch(const out_of_range &range){
+        fullEmpty = true;
+    }
+
+    //finally, is the assignment operator
+    CQueue* newQueue = new CQueue(cqueue);
+    
+    //tries to catch the assignment error
+    try{
+        newQueue->getNextOrder();
+    }
+    catch(const out_of_range &range){
+        assignEmpty = true;
+    }
+
+    //results of everything combined
+    result = result && pureEmpty && emptyClear && fullEmpty && assignEmpty;
+
+    delete newQueue;
+    return result;
+}
+
+//errorMerge
+//attempts to get the errors for merge cases
+bool Tester::errorMerge(CQueue& cqueue){
+    bool result = true;
+
+    //all are booleans used to ensure that the test is done correctly
+    bool pureEmpty = false;
+    bool fullAttempt = false;
+    bool heapAttempts = false;
+    bool heapFullAttempt = false;
+    bool goodTest = true;
+
+    //first checks to ensure that the object is empty
+    result = result && (cqueue.m_heap == nullptr);
+    
+    //testCQueue used to attempt to merge
+    CQueue* testCQueue = new CQueue(cqueue);
+
+    //opposite structure recorded
+    STRUCTURE oppStruct = ((cqueue.m_structure == LEFTIST) ? SKEW: LEFTIST);
+    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
+
+
+    testCQueue->setStructure(oppStruct);
+
+    //pure empty tested
+    try{
+        cqueue.mergeWithQueue(*testCQueue);
+    }
+    catch(const domain_error &domain){
+        pureEmpty = true;
+    }
+
+    //next, both are filled, then they are attempted to be merged
+    randomFill(cqueue, NORMAL_CASE);
+    randomFill(*testCQueue, NORMAL_CASE);
+    result = result && (cqueue.m_size == NORMAL_CASE);
+    result = result && (testCQueue->m_size == NORMAL_CASE);
+
+    //next, they are attemped to be merge
+    try{
+        cqueue.mergeWithQueue(*testCQueue);
+    }
+    catch(const domain_error &domain){
+        fullAttempt = true;
+    }
 
-    //after testing, the result is then returned
-    return result;
-}
+    //next, clear is called for both
+    cqueue.clear();
+    testCQueue->clear();
 
-//maxheapRemoval
-//removes elements from a maxheap to ensure that the property still upholds
-bool Tester::maxheapRemoval(CQueue& cqueue, int num){
-    bool result = true;
+    //then, the structures are the same, but the heaptypes are swapped
+    testCQueue->setStructure(cqueue.m_structure);
+    testCQueue->setPriorityFn(cqueue.m_priorFunc, oppHeap);
 
-    //first checks to ensure cqueue is a maxheap
-    result = result && (cqueue.m_heapType == MAXHEAP);
+    //tries again this time with different heap types
+    try{
+        cqueue.mergeWithQueue(*testCQueue);
+    }
+    catch(const domain_error &domain){
+        heapAttempts = true;
+    }
 
-    //calls upon maxheapInsertion to fill the cqueue
-    result = result && maxheapInsertion(cqueue, num);
+    //next, randomly filled
+    randomFill(cqueue, NORMAL_CASE);
+    randomFill(*testCQueue, NORMAL_CASE);
+    result = result && (cqueue.m_size == NORMAL_CASE);
+    result = result && (testCQueue->m_size == NORMAL_CASE);
 
-    //array created for popped orders
-    Order poppedOrders[num];
-    
-    //try catch block used to ensure no errors occur
+    //finally, tested again with full but different heap types
     try{
-        //for loop goes through and removes half of the nodes
-        //each removal is popped onto the array, which is then checked to ensure as the index becomes greater, the numbers are lower
-        for (int i = 0; i < int(num/2); i++){
-            poppedOrders[i] = cqueue.getNextOrder(); //popped order added to array
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc); //tested each time to ensure maxheap property upholds
-            
-            //if statement checks to see if the popped order has a less than or equal to priority than the previous one popped
-            //i > 0 to prevent seg faults
-            if (i > 0){
-                result = result && (cqueue.m_priorFunc(poppedOrders[i]) <= cqueue.m_priorFunc(poppedOrders[i -1]));
-            } 
-        }
-
-        //checks to ensure cqueue size is half of what it was previous
-        if (num % 2 == 0){
-            result = result && (cqueue.m_size == int(num/2));
-        }
-        else{
-            result = result && (cqueue.m_size == int(num/2) + 1);
-        }
+        cqueue.mergeWithQueue(*testCQueue);
+    }
+    catch(const domain_error &domain){
+        heapFullAttempt = true;
+    }
 
-        //one final test to ensure property is upheld
-        result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    //finally, heap type as the same, to prove that the try remains the same
+    cqueue.clear();
+    testCQueue->clear();
 
-        //the final half are then removed, maxheap property once again tested
-        for (int i = num/2; i < num; i++){
-            poppedOrders[i] = cqueue.getNextOrder(); //popped order added to array
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
-            
-            //array checks again to ensure property is upheld
-            result = result && (cqueue.m_priorFunc(poppedOrders[i]) <= cqueue.m_priorFunc(poppedOrders[i -1]));
-        }
+    //finally, changed to be the same structure
+    testCQueue->setStructure(cqueue.m_structure);
+    testCQueue->setPriorityFn(cqueue.m_priorFunc, cqueue.m_heapType);
 
-        //checks if m_size is zero and if m_heap is a nullptr, which it should be
-        result = result && (cqueue.m_size == 0);
-        result = result && (cqueue.m_heap == nullptr);
+    //tested, so that goodTest remains true
+    try{
+        cqueue.mergeWithQueue(*testCQueue);
     }
-    //catches out of range and returns false
-    catch(const out_of_range &range){
-        result = false;
+    catch(const domain_error &domain){
+        goodTest = false;
     }
+
+    //result then combined with the results of the other tests
+    result = result && pureEmpty && fullAttempt && heapAttempts && heapFullAttempt && goodTest;
+
+    delete testCQueue; //testCQueue deleted
     return result;
 }
 
-//leftistNPLProperty
-//Tests to ensure that the leftist heap stays consistent after insertions
-bool Tester::leftistNPLProperty(CQueue& cqueue, int num){
+//deepMergeTest
+//inserts sorted and random orders, merges them, and removes all of them to ensure the order is correct
+bool Tester::deepMergeTest(CQueue& cqueue, int num){
     bool result = true;
 
-    //first checks to ensure that the cqueue is in fact leftist
-    result = result && (cqueue.m_structure == LEFTIST);
-
-    //random variables created
-    Random orderIdGen(MINORDERID,MAXORDERID);
-    Random customerIdGen(MINCUSTID,MAXCUSTID);
-    customerIdGen.setSeed(0);
-    Random membershipGen(0,5); // there are six tiers
-    Random pointsGen(MINPOINTS,MAXPOINTS);
-    Random itemGen(0,5); // there are six items
-    Random countGen(0,3); // there are three possible quantity values
-
-    //for loop inserts as many nodes as the user would like, and the NPL property is checked each time
-    for (int i = 0; i < num; i++){
-        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
-                    static_cast<COUNT>(countGen.getRandNum()),
-                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
-                    pointsGen.getRandNum(),
-                    customerIdGen.getRandNum(),
-                    orderIdGen.getRandNum());
+    //first half is inserted with ascending points, which builds long spines
+    for (int i = 0; i < num / 2; i++){
+        Order anOrder(COFFEE, ONE, TIER1, i % (MAXPOINTS + 1), MINCUSTID, MINORDERID + (i % (MAXORDERID - MINORDERID)));
         cqueue.insertOrder(anOrder);
-        result = result && NPLTest(result, cqueue.m_heap);
     }
 
-    //checks to ensure size is equal to num
+    //second half is randomly filled into a different queue, then merged
+    CQueue* testCQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    randomFill(*testCQueue, num - (num / 2));
+    cqueue.mergeWithQueue(*testCQueue);
+    delete testCQueue;
+
     result = result && (cqueue.m_size == num);
 
-    //if statement determines which type of heap it is, and checks to ensure the heapType property is upheld
-    if (cqueue.m_heapType == MINHEAP){
-        result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
-    }
-    else{
-        result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    //every order is removed, and the priority must never get better than the previous one
+    try{
+        int prevPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+        for (int i = 1; i < num; i++){
+            int currPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+            if (cqueue.m_heapType == MINHEAP){
+                result = result && (currPriority >= prevPriority);
+            }
+            else{
+                result = result && (currPriority <= prevPriority);
+            }
+            prevPriority = currPriority;
+        }
     }
-
-    //all nodes are then removed, and NPL test is run again to ensure it upholds
-    for (int i = 0; i < num; i++){
-        cqueue.getNextOrder();
-        result = result && NPLTest(result, cqueue.m_heap);
+    //catches out of range and returns false
+    catch(const out_of_range &range){
+        result = false;
     }
 
-    //checks to ensure m_size is zero
+    //checks to ensure the queue is empty
     result = result && (cqueue.m_size == 0);
+    result = result && (cqueue.m_heap == nullptr);
 
-    return result; //result returned
+    return result;
 }
 
-//leftistHeapTest
-//Checks to ensure that the leftist node upholds for every insertion
-bool Tester::leftistHeapTest(CQueue& cqueue, int num){
+//testNodePool
+//checks that the pool reports its high water mark, reuses freed nodes, and adopts merged nodes
+bool Tester::testNodePool(CQueue& cqueue){
     bool result = true;
 
-    //first checks to ensure that the cqueue is in fact leftist
-    result = result && (cqueue.m_structure == LEFTIST);
-
-    //random variables created
-    Random orderIdGen(MINORDERID,MAXORDERID);
-    Random customerIdGen(MINCUSTID,MAXCUSTID);
-    customerIdGen.setSeed(0);
-    Random membershipGen(0,5); // there are six tiers
-    Random pointsGen(MINPOINTS,MAXPOINTS);
-    Random itemGen(0,5); // there are six items
-    Random countGen(0,3); // there are three possible quantity values
+    //cqueue filled, the high water mark should match
+    randomFill(cqueue, NORMAL_CASE);
+    result = result && (cqueue.getPoolHighWater() == NORMAL_CASE);
+    result = result && (cqueue.m_pool.numLive() == NORMAL_CASE);
 
-    //for loop inserts as many nodes as the user would like, and the leftist test is run each time
-    for (int i = 0; i < num; i++){
-        Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
-                    static_cast<COUNT>(countGen.getRandNum()),
-                    static_cast<MEMBERSHIP>(membershipGen.getRandNum()),
-                    pointsGen.getRandNum(),
-                    customerIdGen.getRandNum(),
-                    orderIdGen.getRandNum());
-        cqueue.insertOrder(anOrder);
-        result = result && leftistTest(result, cqueue.m_heap);
+    //every order removed, nodes go back to the pool but the high water mark stays
+    for (int i = 0; i < NORMAL_CASE; i++){
+        cqueue.getNextOrder();
     }
+    result = result && (cqueue.m_pool.numLive() == 0);
+    result = result && (cqueue.getPoolHighWater() == NORMAL_CASE);
 
-    //checks to ensure size is equal to num, and the NPL property is also checked
-    result = result && (cqueue.m_size == num);
-    result = result && NPLTest(result, cqueue.m_heap);
+    //refilled, no new slabs should be needed since the nodes are recycled
+    int capacity = cqueue.m_pool.capacity();
+    unsigned int numSlabs = cqueue.m_pool.m_slabs.size();
+    randomFill(cqueue, NORMAL_CASE);
+    result = result && (cqueue.m_pool.capacity() == capacity);
+    result = result && (cqueue.m_pool.m_slabs.size() == numSlabs);
 
-    //if statement determines which type of heap it is, and checks to ensure the heapType property is upheld
+    //a second queue is filled and merged, then deleted while its nodes are still in use
+    CQueue* testCQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    randomFill(*testCQueue, NORMAL_CASE);
+    cqueue.mergeWithQueue(*testCQueue);
+    result = result && (testCQueue->m_pool.capacity() == 0);
+    result = result && (testCQueue->m_pool.numLive() == 0);
+    delete testCQueue;
+
+    result = result && (cqueue.m_pool.numLive() == NORMAL_CASE * 2);
+    result = result && (cqueue.getPoolHighWater() == NORMAL_CASE * 2);
+
+    //heap property checked, then every order removed from the merged heap
     if (cqueue.m_heapType == MINHEAP){
         result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
     }
     else{
         result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
     }
-
-    //all nodes are then removed, and leftist test is run again to ensure it upholds
-    for (int i = 0; i < num; i++){
+    for (int i = 0; i < NORMAL_CASE * 2; i++){
         cqueue.getNextOrder();
-        result = result && leftistTest(result, cqueue.m_heap);
     }
+    result = result && (cqueue.m_pool.numLive() == 0);
+    result = result && (cqueue.m_heap == nullptr);
 
-    //checks to ensure m_size is zero
-    result = result && (cqueue.m_size == 0);
-
-    return result; //result returned
+    return result;
 }
 
-//NPLTest
-//Checks the node of every node to ensure that the updateNPL function works properly
-bool Tester::NPLTest(bool result, const Node* curr){
-    if (curr == nullptr){
-        return result;
-    }
-    else{
-        //result called for left and right nodes for postorder traversal
-        result = result && NPLTest(result, curr->m_left);
-        result = result && NPLTest(result, curr->m_right);
-        
-        //two if statements used to check the NPL of both left and right
-        //ternary operator used to prevent seg faults
-        int leftNPL = ((curr->m_left == nullptr) ? 0 : curr->m_left->getNPL());
-        int rightNPL = ((curr->m_right == nullptr) ? 0 : curr->m_right->getNPL());
+//testCachedPriority
+//checks the cached priorities after inserting, copying, and changing the priority function
+bool Tester::testCachedPriority(CQueue& cqueue){
+    bool result = true;
 
-        //correctNPL is created based on which NPL is lower, as it should have the lower value
-        int correctNPL = 1 + ((leftNPL < rightNPL) ? leftNPL : rightNPL);
+    //opposite values determined to change the priority function
+    prifn_t currFn = cqueue.m_priorFunc;
+    prifn_t oppFn = ((cqueue.m_priorFunc == priorityFn2) ? priorityFn1 : priorityFn2);
+    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
 
-        //if statement checks to ensure the NPL of curr is equal to the NPL it should be
-        if (curr->getNPL() == correctNPL){
-            return true;
-        }
-        else{
-            return false;
-        }
-    }
+    //cqueue filled and checked
+    randomFill(cqueue, NORMAL_CASE);
+    result = result && cachedPriorityTest(result, cqueue.m_heap, currFn);
+
+    //copies keep the same cached priorities
+    CQueue* sameQueue = new CQueue(cqueue);
+    result = result && cachedPriorityTest(result, sameQueue->m_heap, currFn);
+    delete sameQueue;
+
+    //priority function changed, every cached priority must be recomputed
+    cqueue.setPriorityFn(oppFn, oppHeap);
+    result = result && cachedPriorityTest(result, cqueue.m_heap, oppFn);
+
+    //structure changed, cached priorities stay with the current function
+    cqueue.setStructure(((cqueue.m_structure == LEFTIST) ? SKEW: LEFTIST));
+    result = result && cachedPriorityTest(result, cqueue.m_heap, oppFn);
+
+    return result;
 }
 
-//leftistTest
-//Checks to ensure that the leftist property of the left node having a greater NPL than the right is upheld
-bool Tester::leftistTest(bool result, const Node* curr){
+//cachedPriorityTest
+//recursive test which ensures every node's cached priority matches the priority function
+bool Tester::cachedPriorityTest(bool result, const Node* curr, prifn_t priorFn){
     if (curr == nullptr){
         return result;
     }
     else{
-        //result called for left and right nodes for postorder traversal
-        result = result && leftistTest(result, curr->m_left);
-        result = result && leftistTest(result, curr->m_right);
-        
-        //two if statements used to check the NPL of both left and right
-        //ternary operator used to prevent seg faults
-        int leftNPL = ((curr->m_left == nullptr) ? 0 : curr->m_left->getNPL());
-        int rightNPL = ((curr->m_right == nullptr) ? 0 : curr->m_right->getNPL());
+        //cachedPriorityTest called using postorder traversal
+        result = result && cachedPriorityTest(result, curr->m_left, priorFn);
+        result = result && cachedPriorityTest(result, curr->m_right, priorFn);
 
-        //if statement checks to ensure the NPL of the left node is greater than the right one
-        if (leftNPL >= rightNPL){
-            return true;
-        }
-        //else, false is returned, since the right node should not be greater
-        else{
-            return false;
-        }
+        return result && (curr->getPriority() == priorFn(curr->getOrder()));
     }
 }
 
-//testPriorityFunction
-//tests the setter for priority function to ensure it works properly
-bool Tester::testPriorityFunction(CQueue& cqueue){
+//testBasicCQueue
+//fills BasicCQueues and CQueues with the same orders, the heaps must match and remove orders in the same order
+bool Tester::testBasicCQueue(){
     bool result = true;
-    
-    //current values of the heap are saved for later use
-    prifn_t currFn = cqueue.m_priorFunc;
-    HEAPTYPE currHeap = cqueue.m_heapType;
-    //opposite values determines which values are opposite, and assigns the opposite
-    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
-    prifn_t oppFn = ((cqueue.m_priorFunc == priorityFn2) ? priorityFn1 : priorityFn2);
-
 
-    //cqueue randomly filled, however an array keeps track of all of the order IDs as being inserted
-    //array created
-    int orderIDs[NORMAL_CASE];
-    
+    //one queue with an inlined functor, one with a function pointer
+    BasicCQueue<PointsPriority, MAXHEAP, LEFTIST> maxQueue;
+    BasicCQueue<prifn_t, MINHEAP, SKEW> minQueue(priorityFn2);
+    CQueue maxCheck(priorityFn1, MAXHEAP, LEFTIST);
+    CQueue minCheck(priorityFn2, MINHEAP, SKEW);
+
     //random variables created
     Random orderIdGen(MINORDERID,MAXORDERID);
     Random customerIdGen(MINCUSTID,MAXCUSTID);
@@ -1270,7 +3094,7 @@ bool Tester::testPriorityFunction(CQueue& cqueue){
     Random itemGen(0,5); // there are six items
     Random countGen(0,3); // there are three possible quantity values
 
-    //for loop inserts a normal case amount of nodes, and list of order IDs added to array
+    //every order is inserted into all four queues
     for (int i = 0; i < NORMAL_CASE; i++){
         Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
                     static_cast<COUNT>(countGen.getRandNum()),
@@ -1278,149 +3102,65 @@ bool Tester::testPriorityFunction(CQueue& cqueue){
                     pointsGen.getRandNum(),
                     customerIdGen.getRandNum(),
                     orderIdGen.getRandNum());
-        cqueue.insertOrder(anOrder);
-        orderIDs[i] = anOrder.getOrderID();
+        maxQueue.insertOrder(anOrder);
+        minQueue.insertOrder(anOrder);
+        maxCheck.insertOrder(anOrder);
+        minCheck.insertOrder(anOrder);
     }
 
-    int tempint = cqueue.m_size; //m_size saved for later check
-
-    //for loop is done so that the item switches to the opposite heap, then back
-    for (int i = 0; i < 2; i++){
-        
-        //if statement changes depending on which iteration it is
-        if (i % 2 == 0){
-            //first test done is changing the heap from a MINHEAP to MAXHEAP, or vice versa, with the same priority function
-            cqueue.setPriorityFn(cqueue.m_priorFunc, oppHeap); 
-            result = result && (cqueue.m_heapType == oppHeap);         
-        }
-        else{
-            //set back to original state and compared to previous node
-            cqueue.setPriorityFn(cqueue.m_priorFunc, currHeap);
-            //first checks to ensure that the heap type actually changed, and that m_size is the same
-            result = result && (cqueue.m_heapType == currHeap);
-        }
+    //properties checked, and the heaps must be built exactly the same as the runtime queues
+    result = result && (maxQueue.numOrders() == NORMAL_CASE) && (minQueue.numOrders() == NORMAL_CASE);
+    result = result && maxheapTest(result, maxQueue.m_heap, priorityFn1);
+    result = result && leftistTest(result, maxQueue.m_heap);
+    result = result && NPLTest(result, maxQueue.m_heap);
+    result = result && minheapTest(result, minQueue.m_heap, priorityFn2);
+    result = result && assignmentHelper(result, maxQueue.m_heap, maxCheck.m_heap);
+    result = result && assignmentHelper(result, minQueue.m_heap, minCheck.m_heap);
 
-        result = result && (cqueue.m_size == tempint);
+    //copy constructor checked
+    BasicCQueue<PointsPriority, MAXHEAP, LEFTIST> maxCopy(maxQueue);
+    result = result && assignmentHelper(result, maxQueue.m_heap, maxCopy.m_heap);
 
-        //for loop goes through and ensures each orderID is found
+    //every order removed, the same order IDs must come out of each pair of queues
+    try{
         for (int i = 0; i < NORMAL_CASE; i++){
-            result = result && find(false, cqueue.m_heap, orderIDs[i]);
-        }
-
-        //then if statement checks to ensure properties hold up
-        if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-            result = result && leftistTest(result, cqueue.m_heap);
-        }
-        else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-            result = result && leftistTest(result, cqueue.m_heap);
-        }
-        else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-        }
-        else{
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && (maxQueue.getNextOrder().getOrderID() == maxCheck.getNextOrder().getOrderID());
+            result = result && (minQueue.getNextOrder().getOrderID() == minCheck.getNextOrder().getOrderID());
         }
     }
-
-    //next test is done is to test changing the priority function to the opposite to see if changes occur
-    //heap type is also changed
-    //for loop goes three times to test the changes to see if they uphold
-    for (int i = 0; i < 3; i++){
-        switch (i){
-            case 0:
-                cqueue.setPriorityFn(oppFn, currHeap);  
-                //checks to ensure the member variables check
-                result = result && (cqueue.m_heapType == currHeap);
-                result = result && (cqueue.m_priorFunc == oppFn);
-                break;
-            case 1:
-                cqueue.setPriorityFn(oppFn, oppHeap);
-                //checks to ensure the member variables check
-                result = result && (cqueue.m_heapType == oppHeap);
-                result = result && (cqueue.m_priorFunc == oppFn);
-                break;
-            //case 2 returns the function back to start, and checks to see if it remains the same as check
-            case 2:
-                cqueue.setPriorityFn(currFn, currHeap);
-                //checks to ensure the member variables check
-                result = result && (cqueue.m_heapType == currHeap);
-                result = result && (cqueue.m_priorFunc == currFn);
-                break;
-            //default is just set to basic change
-            default:
-                cqueue.setPriorityFn(oppFn, oppHeap);
-                //checks to ensure the member variables check
-                result = result && (cqueue.m_heapType == oppHeap);
-                result = result && (cqueue.m_priorFunc == oppFn);
-        }
-
-        //size checked each time to ensure it didn't change
-        result = result && (cqueue.m_size == tempint);
-
-        //for loop goes through and ensures each orderID is found
-        for (int i = 0; i < NORMAL_CASE; i++){
-            result = result && find(false, cqueue.m_heap, orderIDs[i]);
-        }
-
-        //then if statement checks to ensure properties hold up
-        if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-            result = result && leftistTest(result, cqueue.m_heap);
-        }
-        else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-            result = result && leftistTest(result, cqueue.m_heap);
-        }
-        else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-        }
-        else{
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-        }
+    //catches out of range and returns false
+    catch(const out_of_range &range){
+        result = false;
     }
 
-    CQueue* check = new CQueue(cqueue);
+    result = result && (maxQueue.m_heap == nullptr) && (minQueue.m_heap == nullptr);
+    result = result && (maxCopy.numOrders() == NORMAL_CASE);
 
-    //final checks that if the heap and priorfn is the same as it currently is, nothing changes
-    cqueue.setPriorityFn(currFn, currHeap);
-    result = result && assignmentHelper(result, cqueue.m_heap, check->m_heap);
-    
-    delete check; //check deleted
-    return result; //result returned
+    return result;
 }
 
-//testSetStructure
-//checks to ensure that the structure changes
-bool Tester::testSetStructure(CQueue& cqueue){
+//testInsertOrders
+//inserts a vector of orders into a filled queue, and checks that every order is in the heap
+bool Tester::testInsertOrders(CQueue& cqueue){
     bool result = true;
-    
-    //current and opposite of each value kept track of
-    STRUCTURE currStruct = cqueue.m_structure;
-    STRUCTURE oppStruct = ((cqueue.m_structure == LEFTIST) ? SKEW: LEFTIST);
 
-    prifn_t currFn = cqueue.m_priorFunc;
-    prifn_t oppFn = ((cqueue.m_priorFunc == priorityFn2) ? priorityFn1 : priorityFn2);
+    //cqueue starts with some orders, and an empty insert must not change anything
+    randomFill(cqueue, NORMAL_CASE / 2);
+    vector<Order> orders;
+    cqueue.insertOrders(orders);
+    result = result && (cqueue.m_size == NORMAL_CASE / 2);
 
-    HEAPTYPE currHeap = cqueue.m_heapType;
-    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
-    
-    
-    //cqueue randomly filled, however an array keeps track of all of the order IDs as being inserted
-    //array created
-    int orderIDs[NORMAL_CASE];
-    
-    //random variables created
+    //random variables created, different seeds so the order IDs differ from randomFill
     Random orderIdGen(MINORDERID,MAXORDERID);
+    orderIdGen.setSeed(1);
     Random customerIdGen(MINCUSTID,MAXCUSTID);
-    customerIdGen.setSeed(0);
     Random membershipGen(0,5); // there are six tiers
     Random pointsGen(MINPOINTS,MAXPOINTS);
+    pointsGen.setSeed(1);
     Random itemGen(0,5); // there are six items
     Random countGen(0,3); // there are three possible quantity values
 
-    //for loop inserts a normal case amount of nodes, and list of order IDs added to array
+    //vector filled with a normal case amount of orders
     for (int i = 0; i < NORMAL_CASE; i++){
         Order anOrder(static_cast<ITEM>(itemGen.getRandNum()),
                     static_cast<COUNT>(countGen.getRandNum()),
@@ -1428,705 +3168,2176 @@ bool Tester::testSetStructure(CQueue& cqueue){
                     pointsGen.getRandNum(),
                     customerIdGen.getRandNum(),
                     orderIdGen.getRandNum());
-        cqueue.insertOrder(anOrder);
-        orderIDs[i] = anOrder.getOrderID();
+        orders.push_back(anOrder);
     }
+    cqueue.insertOrders(orders);
 
-    int tempint = cqueue.m_size; //m_size saved for later check
-    
-    //for loop goes through and changes 
-    for (int i = 0; i < 5; i++){
-        //switch statement changes depending on the scenario
-        switch(i){
-            //case 0 changes it to the opposite struct
-            case 0:
-                cqueue.setStructure(oppStruct); //setStructure called
-                
-                //checks to ensure the member variables changed or remained the same
-                result = result && (cqueue.m_structure == oppStruct);
-                result = result && (cqueue.m_heapType == currHeap);
-                result = result && (cqueue.m_priorFunc == currFn);
-                break;
-            //case 1 changes the structure back to the original
-            case 1:
-                cqueue.setStructure(currStruct); //setStructure called and back to original struct
-                
-                //checks to ensure the member variables changed or remained the same
-                result = result && (cqueue.m_structure == currStruct);
-                result = result && (cqueue.m_heapType == currHeap);
-                result = result && (cqueue.m_priorFunc == currFn);
-                break;
-            //in case 2, everything is changed to the opposite
-            case 2:
-                cqueue.setStructure(oppStruct);
-                cqueue.setPriorityFn(oppFn, oppHeap);
+    //size checked, and each order ID must be found
+    result = result && (cqueue.m_size == NORMAL_CASE / 2 + NORMAL_CASE);
+    for (int i = 0; i < NORMAL_CASE; i++){
+        result = result && find(false, cqueue.m_heap, orders[i].getOrderID());
+    }
 
-                //checks to ensure the member variables changed or remained the same
-                result = result && (cqueue.m_structure == oppStruct);
-                result = result && (cqueue.m_heapType == oppHeap);
-                result = result && (cqueue.m_priorFunc == oppFn);
+    //then if statement checks to ensure properties hold up
+    if (cqueue.m_structure == LEFTIST){
+        result = result && leftistTest(result, cqueue.m_heap);
+        result = result && NPLTest(result, cqueue.m_heap);
+    }
+    if (cqueue.m_heapType == MINHEAP){
+        result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    }
+    else{
+        result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
+    }
 
-                break;
-            //case 3 is that the structure is set back to the original, but the heapType are still the opposite
-            case 3:
-                cqueue.setStructure(currStruct);
+    //every order removed, the priority must never get better than the previous one
+    int prevPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+    for (int i = 1; i < NORMAL_CASE / 2 + NORMAL_CASE; i++){
+        int currPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+        if (cqueue.m_heapType == MINHEAP){
+            result = result && (currPriority >= prevPriority);
+        }
+        else{
+            result = result && (currPriority <= prevPriority);
+        }
+        prevPriority = currPriority;
+    }
+    result = result && (cqueue.m_heap == nullptr);
 
-                //checks to ensure the member variables changed or remained the same
-                result = result && (cqueue.m_structure == currStruct);
-                result = result && (cqueue.m_heapType == oppHeap);
-                result = result && (cqueue.m_priorFunc == oppFn);
+    return result;
+}
 
-                break;
-            //default is that it is changed to the original variables, reached when i = 4
-            default:
-                cqueue.setStructure(currStruct);
-                cqueue.setPriorityFn(currFn, currHeap);
+//testInPlaceRebuild
+//changes the priority function and structure, the heap must be made of exactly the same nodes
+bool Tester::testInPlaceRebuild(CQueue& cqueue){
+    bool result = true;
 
-                //checks to ensure the member variables changed or remained the same
-                result = result && (cqueue.m_structure == currStruct);
-                result = result && (cqueue.m_heapType == currHeap);
-                result = result && (cqueue.m_priorFunc == currFn);
-        }
+    //opposite values determined
+    prifn_t oppFn = ((cqueue.m_priorFunc == priorityFn2) ? priorityFn1 : priorityFn2);
+    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
+    STRUCTURE oppStruct = ((cqueue.m_structure == LEFTIST) ? SKEW: LEFTIST);
 
-        //size checked each time to ensure it didn't change
-        result = result && (cqueue.m_size == tempint);
+    //cqueue filled, then the nodes and pool are recorded
+    randomFill(cqueue, NORMAL_CASE);
+    vector<const Node*> before;
+    collectNodes(cqueue.m_heap, before);
+    sort(before.begin(), before.end());
+    int capacity = cqueue.m_pool.capacity();
+    int highWater = cqueue.getPoolHighWater();
 
-        //for loop goes through and ensures each orderID is found
-        for (int i = 0; i < NORMAL_CASE; i++){
-            result = result && find(false, cqueue.m_heap, orderIDs[i]);
+    //priority function changed, then the structure
+    for (int i = 0; i < 2; i++){
+        if (i == 0){
+            cqueue.setPriorityFn(oppFn, oppHeap);
+        }
+        else{
+            cqueue.setStructure(oppStruct);
         }
 
+        //the same nodes must make up the heap, and the pool must not have grown
+        vector<const Node*> after;
+        collectNodes(cqueue.m_heap, after);
+        sort(after.begin(), after.end());
+        result = result && (after == before);
+        result = result && (cqueue.m_pool.capacity() == capacity);
+        result = result && (cqueue.getPoolHighWater() == highWater);
+        result = result && (cqueue.m_size == NORMAL_CASE);
+
         //then if statement checks to ensure properties hold up
-        if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-            result = result && leftistTest(result, cqueue.m_heap);
-        }
-        else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        if (cqueue.m_structure == LEFTIST){
             result = result && leftistTest(result, cqueue.m_heap);
+            result = result && NPLTest(result, cqueue.m_heap);
         }
-        else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        if (cqueue.m_heapType == MINHEAP){
+            result = result && minheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
         }
         else{
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && maxheapTest(result, cqueue.m_heap, cqueue.m_priorFunc);
         }
     }
 
-    CQueue* check = new CQueue(cqueue);
-
-    //final checks that if the structure is the same as it currently is, nothing changes
-    cqueue.setStructure(currStruct);
-    result = result && assignmentHelper(result, cqueue.m_heap, check->m_heap);
-    
-    delete check; //check deleted
     return result;
 }
 
-//find
-//helper function which finds IDs within the a CQueue
-bool Tester::find(bool result, const Node* curr, int orderID){
-    if (curr == nullptr){
-        return false;
+//collectNodes
+//adds every node of the heap to the vector using preorder traversal
+void Tester::collectNodes(const Node* curr, vector<const Node*>& nodes){
+    if (curr != nullptr){
+        nodes.push_back(curr);
+        collectNodes(curr->m_left, nodes);
+        collectNodes(curr->m_right, nodes);
     }
-    else{
-        //postorder traversal of the object
-        result = result || find(result, curr->m_left, orderID);
-        result = result || find(result, curr->m_right, orderID);
-        
-        //if order ID is found, true is returned
-        if (curr->getOrder().getOrderID() == orderID){
-            return true;
-        }
-        else{
-            return result || false; //else, false is returned
-        }
+}
+
+//testMoveSemantics
+//moves a filled queue around, the nodes themselves must never be copied
+bool Tester::testMoveSemantics(CQueue& cqueue){
+    bool result = true;
+
+    //orders must be trivially copyable
+    result = result && is_trivially_copyable<Order>::value;
+
+    //cqueue filled and its root recorded
+    randomFill(cqueue, NORMAL_CASE);
+    const Node* root = cqueue.m_heap;
+
+    //move constructor takes over the heap, cqueue is left empty but usable
+    CQueue movedQueue(std::move(cqueue));
+    result = result && (movedQueue.m_heap == root);
+    result = result && (movedQueue.m_size == NORMAL_CASE);
+    result = result && (movedQueue.m_heapType == cqueue.m_heapType);
+    result = result && (movedQueue.m_structure == cqueue.m_structure);
+    result = result && (movedQueue.m_priorFunc == cqueue.m_priorFunc);
+    result = result && (cqueue.m_heap == nullptr);
+    result = result && (cqueue.m_size == 0);
+    randomFill(cqueue, 1);
+    result = result && (cqueue.m_size == 1);
+
+    //queue moved into a vector, then move assigned into another queue
+    vector<CQueue> queues;
+    queues.push_back(std::move(movedQueue));
+    result = result && (queues[0].m_heap == root);
+
+    CQueue otherQueue(priorityFn1, MAXHEAP, SKEW);
+    randomFill(otherQueue, NORMAL_CASE);
+    otherQueue = std::move(queues[0]);
+    result = result && (otherQueue.m_heap == root);
+    result = result && (otherQueue.m_size == NORMAL_CASE);
+    result = result && (otherQueue.m_heapType == cqueue.m_heapType);
+    result = result && (otherQueue.m_structure == cqueue.m_structure);
+    result = result && (queues[0].m_heap == nullptr);
+
+    //the moved heap must still hold up
+    if (otherQueue.m_heapType == MINHEAP){
+        result = result && minheapTest(result, otherQueue.m_heap, otherQueue.m_priorFunc);
+    }
+    else{
+        result = result && maxheapTest(result, otherQueue.m_heap, otherQueue.m_priorFunc);
     }
+    for (int i = 0; i < NORMAL_CASE; i++){
+        otherQueue.getNextOrder();
+    }
+    result = result && (otherQueue.m_heap == nullptr);
+
+    return result;
 }
 
-//edgeMergeWithQueue
-//tests edge cases of mergeWithQueue
-bool Tester::edgeMergeWithQueue(CQueue& cqueue){
+//testGetNextOrders
+//removes orders in batches, they must come out the same as removing them one at a time
+bool Tester::testGetNextOrders(CQueue& cqueue){
     bool result = true;
-    
-    //try block ensures that no domain errors occur
+    const int BATCH = 12; //largest batch a barista station pulls
+
+    //an empty queue gives back nothing, and does not throw
+    Order batch[BATCH];
     try{
+        result = result && (cqueue.getNextOrders(BATCH, batch) == 0);
+    }
+    catch(const out_of_range &range){
+        result = false;
+    }
 
-        //testCQueue created with the cqueue sent
-        CQueue* testCQueue = new CQueue(cqueue);
+    //cqueue filled, and a copy is used to check the order of removal
+    randomFill(cqueue, NORMAL_CASE);
+    CQueue checkQueue(cqueue);
+
+    //batches of increasing size are removed, until the queue runs out
+    int numRemoved = 0;
+    int batchSize = 4;
+    while (numRemoved < NORMAL_CASE){
+        size_t numTaken = cqueue.getNextOrders(batchSize, batch);
+        int expected = ((NORMAL_CASE - numRemoved < batchSize) ? NORMAL_CASE - numRemoved : batchSize);
+        result = result && (int(numTaken) == expected);
+
+        //each order must match the order removed from the copy
+        for (size_t i = 0; i < numTaken; i++){
+            result = result && (batch[i].getOrderID() == checkQueue.getNextOrder().getOrderID());
+        }
+        numRemoved += numTaken;
+        batchSize = ((batchSize == BATCH) ? 4 : batchSize + 1);
+    }
 
-        //cqueue is then randomly filled
-        randomFill(cqueue, NORMAL_CASE);
+    //queue must be empty, with every node back in the pool
+    result = result && (cqueue.m_size == 0);
+    result = result && (cqueue.m_heap == nullptr);
+    result = result && (cqueue.m_pool.numLive() == 0);
+    result = result && (cqueue.getNextOrders(BATCH, batch) == 0);
 
-        //once it is filled, it is attempted to be merged with the other queue
-        cqueue.mergeWithQueue(*testCQueue);
+    //any output iterator can be used, such as a back_inserter
+    randomFill(cqueue, NORMAL_CASE);
+    vector<Order> orders;
+    result = result && (cqueue.getNextOrders(NORMAL_CASE * 2, back_inserter(orders)) == size_t(NORMAL_CASE));
+    result = result && (int(orders.size()) == NORMAL_CASE);
+    result = result && (cqueue.m_heap == nullptr);
 
-        //checks to ensure that testCQueue remains empty
-        result = result && (testCQueue->m_heap == nullptr);
-        result = result && (testCQueue->m_size == 0);
+    return result;
+}
 
-        //cqueue cleared, testCQueue filled, and tested again
-        cqueue.clear();
-        randomFill(*testCQueue, NORMAL_CASE);
+//testDaryHeap
+//fills a DARY queue, then copies, re-keys, converts and merges it, checking the heap property each time
+bool Tester::testDaryHeap(CQueue& cqueue){
+    bool result = true;
 
-        //mergeWithQueue called for this edge case
-        cqueue.mergeWithQueue(*testCQueue);
+    //cqueue checked to be DARY, then filled
+    result = result && (cqueue.m_structure == DARY) && (cqueue.m_heap == nullptr);
+    randomFill(cqueue, NORMAL_CASE);
+    result = result && (cqueue.m_size == NORMAL_CASE) && (int(cqueue.m_array.size()) == NORMAL_CASE);
+    result = result && daryHeapTest(cqueue);
 
-        //checks to ensure that testCQueue became empty
-        result = result && (testCQueue->m_heap == nullptr);
-        result = result && (testCQueue->m_size == 0);        
+    //copy constructor checked, the arrays must match entry for entry
+    CQueue sameQueue(cqueue);
+    result = result && (sameQueue.m_arity == cqueue.m_arity);
+    for (int i = 0; i < NORMAL_CASE; i++){
+        result = result && (sameQueue.m_array[i].getOrder().getOrderID() == cqueue.m_array[i].getOrder().getOrderID());
+    }
 
-        //checks and sees if the size changed
-        result = result && (cqueue.m_size == NORMAL_CASE);
+    //arity changed, then the priority function changed
+    int currArity = cqueue.m_arity;
+    cqueue.setArity((currArity == 8) ? 2 : 8);
+    result = result && (cqueue.m_arity != currArity) && daryHeapTest(cqueue);
+    cqueue.setArity(3); //invalid arity is ignored
+    result = result && (cqueue.m_arity != 3);
+    cqueue.setArity(currArity);
 
-        delete testCQueue; //testCQueue deleted
+    prifn_t currFn = cqueue.m_priorFunc;
+    HEAPTYPE currHeap = cqueue.m_heapType;
+    cqueue.setPriorityFn(((currFn == priorityFn2) ? priorityFn1 : priorityFn2), ((currHeap == MINHEAP) ? MAXHEAP : MINHEAP));
+    result = result && daryHeapTest(cqueue);
+    cqueue.setPriorityFn(currFn, currHeap);
+    result = result && daryHeapTest(cqueue);
+
+    //structure changed to a leftist heap and back, every order must be found
+    cqueue.setStructure(LEFTIST);
+    result = result && (cqueue.m_array.empty()) && (cqueue.m_size == NORMAL_CASE);
+    result = result && leftistTest(result, cqueue.m_heap) && NPLTest(result, cqueue.m_heap);
+    for (int i = 0; i < NORMAL_CASE; i++){
+        result = result && find(false, cqueue.m_heap, sameQueue.m_array[i].getOrder().getOrderID());
+    }
+    cqueue.setStructure(DARY);
+    result = result && (cqueue.m_heap == nullptr) && (cqueue.m_pool.numLive() == 0);
+    result = result && daryHeapTest(cqueue);
+
+    //merging with a different structure is a domain error
+    CQueue skewQueue(cqueue.m_priorFunc, cqueue.m_heapType, SKEW);
+    bool domainError = false;
+    try{
+        cqueue.mergeWithQueue(skewQueue);
     }
-    //catch exists to catch any potential domain_errors, and changes result to false
     catch(const domain_error &domain){
-        result = false;
+        domainError = true;
+    }
+    result = result && domainError;
+
+    //merged with the copy, then every order removed in priority order
+    cqueue.mergeWithQueue(sameQueue);
+    result = result && (cqueue.m_size == NORMAL_CASE * 2) && (sameQueue.m_size == 0);
+    result = result && daryHeapTest(cqueue);
+
+    int prevPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+    for (int i = 1; i < NORMAL_CASE * 2; i++){
+        int currPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+        if (cqueue.m_heapType == MINHEAP){
+            result = result && (currPriority >= prevPriority);
+        }
+        else{
+            result = result && (currPriority <= prevPriority);
+        }
+        prevPriority = currPriority;
+    }
+    result = result && (cqueue.m_size == 0) && (cqueue.m_array.empty());
+
+    //an empty DARY heap still throws when a removal is attempted
+    bool outOfRange = false;
+    try{
+        cqueue.getNextOrder();
+    }
+    catch(const out_of_range &range){
+        outOfRange = true;
     }
+    result = result && outOfRange;
 
     return result;
 }
 
-//testMergeWithQueue
-//tests the mergeWithQueue function to ensure that it merges properly
-bool Tester::testMergeWithQueue(CQueue& cqueue){
-    bool result = true;
-    
-    //current and opposite heaps and priorityFunctions kept track up
-    prifn_t currFn = cqueue.m_priorFunc;
-    HEAPTYPE currHeap = cqueue.m_heapType;
-    
-    //function takes place in the try catch block in case of any potential exceptions thrown
-    try{
-        //testCQueue declared
-        CQueue* testCQueue = new CQueue(currFn, currHeap, cqueue.m_structure);
-        
-        randomFill(cqueue, NORMAL_CASE); //cqueue randomly filled
-        //testCQueue randomly filled then merged with original queue
-        randomFill(*testCQueue, NORMAL_CASE);
-        cqueue.mergeWithQueue(*testCQueue);
+//daryHeapTest
+//checks that every entry of a DARY heap has priority over its children, with the cached priorities correct
+bool Tester::daryHeapTest(const CQueue& cqueue){
+    bool result = (int(cqueue.m_array.size()) == cqueue.m_size);
+
+    for (int i = 1; i < cqueue.m_size; i++){
+        int parent = (i - 1) / cqueue.m_arity;
+        int parentPriority = cqueue.m_array[parent].getPriority();
+        int childPriority = cqueue.m_array[i].getPriority();
+        if (cqueue.m_heapType == MINHEAP){
+            result = result && (parentPriority <= childPriority);
+        }
+        else{
+            result = result && (parentPriority >= childPriority);
+        }
+        result = result && (childPriority == cqueue.m_priorFunc(cqueue.m_array[i].getOrder()));
+    }
+    return result;
+}
 
-        //checks to ensure that testCQueue became empty
-        result = result && (testCQueue->m_heap == nullptr);
-        result = result && (testCQueue->m_size == 0);
+//testPairingHeap
+//fills a PAIRING queue, then copies, converts and merges it, checking the heap property each time
+bool Tester::testPairingHeap(CQueue& cqueue){
+    bool result = true;
 
-        //testCQueue deleted
-        delete testCQueue;
+    //cqueue checked to be PAIRING, then filled
+    result = result && (cqueue.m_structure == PAIRING);
+    randomFill(cqueue, NORMAL_CASE);
+    result = result && (cqueue.m_size == NORMAL_CASE) && (cqueue.m_heap->m_right == nullptr);
+    result = result && pairingHeapTest(result, cqueue.m_heap, cqueue.m_heapType);
 
-        //checks to see if m_size multipled by 2
-        result = result && (cqueue.m_size == NORMAL_CASE *2);
+    //copy constructor checked, the copy must have the same shape
+    CQueue sameQueue(cqueue);
+    result = result && assignmentHelper(result, sameQueue.m_heap, cqueue.m_heap);
 
-        //checks to ensure nothing changed
-        result = result && (cqueue.m_heapType == currHeap);
-        result = result && (cqueue.m_priorFunc == currFn);
+    //a few orders removed so the children are paired up, the property must still hold
+    for (int i = 0; i < NORMAL_CASE / 4; i++){
+        cqueue.getNextOrder();
+    }
+    result = result && pairingHeapTest(result, cqueue.m_heap, cqueue.m_heapType);
 
-        //then if statement checks to ensure properties hold up
-        if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-            result = result && leftistTest(result, cqueue.m_heap);
-        }
-        else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-            result = result && leftistTest(result, cqueue.m_heap);
-        }
-        else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
-            result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+    //priority function changed and back, the heap is rebuilt each time
+    prifn_t currFn = cqueue.m_priorFunc;
+    HEAPTYPE currHeap = cqueue.m_heapType;
+    cqueue.setPriorityFn(((currFn == priorityFn2) ? priorityFn1 : priorityFn2), ((currHeap == MINHEAP) ? MAXHEAP : MINHEAP));
+    result = result && pairingHeapTest(result, cqueue.m_heap, cqueue.m_heapType);
+    cqueue.setPriorityFn(currFn, currHeap);
+    result = result && pairingHeapTest(result, cqueue.m_heap, cqueue.m_heapType);
+
+    //structure changed to a leftist heap, a DARY heap, and back to a pairing heap
+    cqueue.setStructure(LEFTIST);
+    result = result && leftistTest(result, cqueue.m_heap) && NPLTest(result, cqueue.m_heap);
+    cqueue.setStructure(DARY);
+    result = result && daryHeapTest(cqueue);
+    cqueue.setStructure(PAIRING);
+    result = result && (cqueue.m_array.empty()) && (cqueue.m_size == NORMAL_CASE - NORMAL_CASE / 4);
+    result = result && pairingHeapTest(result, cqueue.m_heap, cqueue.m_heapType);
+
+    //merged with the copy, then every order removed in priority order
+    cqueue.mergeWithQueue(sameQueue);
+    int total = NORMAL_CASE * 2 - NORMAL_CASE / 4;
+    result = result && (cqueue.m_size == total) && (sameQueue.m_heap == nullptr);
+    result = result && pairingHeapTest(result, cqueue.m_heap, cqueue.m_heapType);
+
+    int prevPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+    for (int i = 1; i < total; i++){
+        int currPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+        if (cqueue.m_heapType == MINHEAP){
+            result = result && (currPriority >= prevPriority);
         }
         else{
-            result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+            result = result && (currPriority <= prevPriority);
         }
+        prevPriority = currPriority;
     }
-    //catch exists to catch any potential domain_errors, and changes result to false
-    catch(const domain_error &domain){
-        result = false;
+    result = result && (cqueue.m_size == 0) && (cqueue.m_heap == nullptr) && (cqueue.m_pool.numLive() == 0);
+
+    //the compile-time queue must hand out the same orders as the runtime queue
+    BasicCQueue<PointsPriority, MAXHEAP, PAIRING> basicQueue;
+    CQueue runtimeQueue(priorityFn1, MAXHEAP, PAIRING);
+    randomFill(runtimeQueue, NORMAL_CASE);
+    CQueue copyQueue(runtimeQueue);
+    while (copyQueue.numOrders() > 0){
+        basicQueue.insertOrder(copyQueue.getNextOrder());
+    }
+    for (int i = 0; i < NORMAL_CASE; i++){
+        result = result && (basicQueue.getNextOrder().getPoints() == runtimeQueue.getNextOrder().getPoints());
     }
 
-    return result; //result returned
+    return result;
 }
 
-//normalAssignment
-//tests the assignment operator in normal cases
-bool Tester::normalAssignment(CQueue& cqueue){
-    bool result = true;
-
-    //randomFill called
-    randomFill(cqueue, NORMAL_CASE);
+//pairingHeapTest
+//checks that every node of a pairing heap has priority over each of its children
+//the children of a node are its m_left, then each m_right from there
+bool Tester::pairingHeapTest(bool result, const Node* curr, HEAPTYPE heapType){
+    if (curr != nullptr){
+        for (const Node* child = curr->m_left; child != nullptr; child = child->m_right){
+            if (heapType == MINHEAP){
+                result = result && (curr->getPriority() <= child->getPriority());
+            }
+            else{
+                result = result && (curr->getPriority() >= child->getPriority());
+            }
+            result = result && pairingHeapTest(result, child, heapType);
+        }
+    }
+    return result;
+}
 
-    //opposite values determines which values are opposite, and creates the opposite
-    HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
-    STRUCTURE oppStruct = ((cqueue.m_structure == LEFTIST) ? SKEW: LEFTIST);
+//testBucketMode
+//moves a filled queue into buckets, then copies, merges, re-keys and falls back, checking the order each time
+bool Tester::testBucketMode(CQueue& cqueue){
+    bool result = true;
+    int maxPriority = ((cqueue.m_priorFunc == priorityFn1) ? 5003 : 10); //largest value of the priority function
+    STRUCTURE structure = cqueue.m_structure;
 
-    //three queues created, one with the copy constructor, one with the same as the sent queue and the other with opposite
-    CQueue* sameQueue = new CQueue(cqueue); 
-    CQueue* newQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
-    CQueue* oppQueue = new CQueue(cqueue.m_priorFunc, oppHeap, oppStruct);
+    //invalid ranges are ignored
+    cqueue.setPriorityRange(5, 1);
+    cqueue.setPriorityRange(0, MAXBUCKETS);
+    result = result && !cqueue.isBucketMode();
 
-    //first checked is sameQueue to ensure it is exactly the same as cqueue, but in different locations
-    result = result && (cqueue.m_heap != sameQueue->m_heap);
-    result = result && assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap);
-    
-    //newQueue and oppQueue are both filled, newQueue plus one to prevent potential repeats
-    randomFill(*newQueue, NORMAL_CASE + 1);
-    randomFill(*oppQueue, NORMAL_CASE);
+    //cqueue filled, then every order moved into the buckets
+    randomFill(cqueue, NORMAL_CASE);
+    cqueue.setPriorityRange(0, maxPriority);
+    result = result && cqueue.isBucketMode() && (cqueue.m_size == NORMAL_CASE);
+    result = result && (cqueue.m_heap == nullptr) && (cqueue.m_array.empty());
+    result = result && (cqueue.m_pool.numLive() == NORMAL_CASE);
 
-    //first assignment is to the newQueue, to see if everything changed properly
-    cqueue = *newQueue;
-    //member variables are checked
-    result = result && (cqueue.m_size == newQueue->m_size);
-    result = result && (cqueue.m_heapType == newQueue->m_heapType);
-    result = result && (cqueue.m_structure == newQueue->m_structure);
-    result = result && (cqueue.m_priorFunc == newQueue->m_priorFunc);
-    result = result && (cqueue.m_heap != newQueue->m_heap);
+    //copy constructor checked, the copy is also in bucket mode
+    CQueue sameQueue(cqueue);
+    result = result && sameQueue.isBucketMode() && (sameQueue.m_size == NORMAL_CASE);
 
-    //assignment helper called for final check, and also checked to ensure not equal to same heap
-    result = result && assignmentHelper(result, cqueue.m_heap, newQueue->m_heap);
-    result = result && !(assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap));
+    //merged with the copy, the buckets are concatenated, then every order removed in priority order
+    cqueue.mergeWithQueue(sameQueue);
+    result = result && cqueue.isBucketMode() && (cqueue.m_size == NORMAL_CASE * 2) && (sameQueue.m_size == 0);
+    result = result && drainTest(cqueue) && (cqueue.m_pool.numLive() == 0);
 
-    //tests then run to ensure properties hold up
-    if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
-        result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-        result = result && leftistTest(result, cqueue.m_heap);
-    }
-    else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
-        result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-        result = result && leftistTest(result, cqueue.m_heap);
-    }
-    else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
-        result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+    //orders with the same priority leave in the order they arrived
+    for (int i = 0; i < NORMAL_CASE; i++){
+        cqueue.insertOrder(Order(COFFEE, ONE, TIER1, 0, MINCUSTID, MINORDERID + i));
     }
-    else{
-        result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+    for (int i = 0; i < NORMAL_CASE; i++){
+        result = result && (cqueue.getNextOrder().getOrderID() == MINORDERID + i);
     }
 
-    //the second one is then on oppHeap, assignment performed
-    cqueue = *oppQueue;
-    //member variables are checked   
-    result = result && (cqueue.m_size == oppQueue->m_size);
-    result = result && (cqueue.m_heapType == oppQueue->m_heapType);
-    result = result && (cqueue.m_structure == oppQueue->m_structure);
-    result = result && (cqueue.m_priorFunc == oppQueue->m_priorFunc);
-    result = result && (cqueue.m_heap != oppQueue->m_heap);
+    //changing the priority function re-keys the buckets, falling back if the new priorities do not fit
+    randomFill(cqueue, NORMAL_CASE);
+    prifn_t currFn = cqueue.m_priorFunc;
+    HEAPTYPE currHeap = cqueue.m_heapType;
+    cqueue.setPriorityFn(((currFn == priorityFn2) ? priorityFn1 : priorityFn2), ((currHeap == MINHEAP) ? MAXHEAP : MINHEAP));
+    result = result && (cqueue.isBucketMode() == (currFn == priorityFn1)) && (cqueue.m_size == NORMAL_CASE);
+    CQueue rekeyedQueue(cqueue);
+    result = result && drainTest(rekeyedQueue);
+    cqueue.setPriorityFn(currFn, currHeap);
 
-    //assignment helper called for final check, and also checked to ensure not equal to same heap
-    result = result && assignmentHelper(result, cqueue.m_heap, oppQueue->m_heap);
-    result = result && !(assignmentHelper(result, cqueue.m_heap, newQueue->m_heap));
+    //a range too narrow for the orders already queued makes the queue fall back at once
+    cqueue.setPriorityRange(0, maxPriority);
+    cqueue.setPriorityRange(0, 1);
+    result = result && !cqueue.isBucketMode() && (cqueue.m_size == NORMAL_CASE);
+    result = result && (cqueue.m_structure == structure) && drainTest(cqueue);
 
-    //tests then run to ensure properties hold up
-    if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == LEFTIST)){
-        result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-        result = result && leftistTest(result, cqueue.m_heap);
+    //an order outside the range makes the queue fall back when it is inserted
+    cqueue.setPriorityRange(0, 5);
+    for (int i = 0; i < NORMAL_CASE; i++){
+        cqueue.insertOrder(Order(COFFEE, ONE, TIER1, 0, MINCUSTID, MINORDERID + i));
     }
-    else if ((cqueue.m_heapType == MAXHEAP) && (cqueue.m_structure == LEFTIST)){
-        result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
-        result = result && leftistTest(result, cqueue.m_heap);
+    result = result && cqueue.isBucketMode();
+    cqueue.insertOrder(Order(ICEDTEA, DOZEN, TIER6, MAXPOINTS, MAXCUSTID, MAXORDERID));
+    result = result && !cqueue.isBucketMode() && (cqueue.m_size == NORMAL_CASE + 1);
+    if (structure == DARY){
+        result = result && daryHeapTest(cqueue);
     }
-    else if ((cqueue.m_heapType == MINHEAP) && (cqueue.m_structure == SKEW)){
-        result = result && minheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+    else if (structure == LEFTIST){
+        result = result && leftistTest(result, cqueue.m_heap) && NPLTest(result, cqueue.m_heap);
+    }
+    result = result && drainTest(cqueue) && (cqueue.m_pool.numLive() == 0);
+
+    //setStructure in bucket mode only changes the structure used after the queue leaves bucket mode
+    randomFill(cqueue, NORMAL_CASE);
+    cqueue.setPriorityRange(0, maxPriority);
+    cqueue.setStructure((structure == DARY) ? LEFTIST : DARY);
+    result = result && cqueue.isBucketMode() && (cqueue.m_heap == nullptr) && (cqueue.m_array.empty());
+    cqueue.clearPriorityRange();
+    result = result && !cqueue.isBucketMode() && (cqueue.m_size == NORMAL_CASE);
+    if (structure == DARY){
+        result = result && leftistTest(result, cqueue.m_heap) && NPLTest(result, cqueue.m_heap);
     }
     else{
-        result = result && maxheapTest(result, cqueue.m_heap, cqueue.getPriorityFn());
+        result = result && daryHeapTest(cqueue);
     }
+    result = result && drainTest(cqueue);
 
-    //all three temporary CQueues deleted
-    delete sameQueue;
-    delete newQueue; 
-    delete oppQueue;
     return result;
 }
 
-//edgeAssignment
-//Tests the assignment operator in edge cases
-bool Tester::edgeAssignment(CQueue& cqueue){
+//drainTest
+//removes every order, the priority must never get better than the previous one
+bool Tester::drainTest(CQueue& cqueue){
     bool result = true;
+    if (cqueue.m_size == 0){
+        return result;
+    }
 
-    //CQueue declared and initialized
-    CQueue* newQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
-
-    //assignment used with cQueue and newQueue
-    cqueue = *newQueue;
-    //all member variables checked, and ensured it is a nullptr
-    result = result && (cqueue.m_size == 0);
-    result = result && (cqueue.m_heapType == newQueue->m_heapType);
-    result = result && (cqueue.m_structure == newQueue->m_structure);
-    result = result && (cqueue.m_priorFunc == newQueue->m_priorFunc);
-    result = result && (cqueue.m_heap == nullptr);
-
-    //newQueue deleted, then one object inserted
-    delete newQueue;
-    newQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
-    randomFill(*newQueue, 1);
-
-    //assignment used with cQueue and newQueue
-    cqueue = *newQueue;
-    //all member variables checked, and ensured it is a nullptr
-    result = result && (cqueue.m_size == 1);
-    result = result && (cqueue.m_heapType == newQueue->m_heapType);
-    result = result && (cqueue.m_structure == newQueue->m_structure);
-    result = result && (cqueue.m_priorFunc == newQueue->m_priorFunc);
-    result = result && (cqueue.m_heap != nullptr);
-    result = result && (cqueue.m_heap->getOrder().getOrderID() == newQueue->m_heap->getOrder().getOrderID());
-
-    delete newQueue;
-    //result returned
-    return result;
-}
-
-//assignmentHelper
-//Helps to ensure that both heaps are equal to each other data wise, but not memory wise
-bool Tester::assignmentHelper(bool result, const Node* lhsPtr, const Node* rhsPtr){
-    if ((lhsPtr == nullptr) && (rhsPtr == nullptr)){
-        return result && true;
+    int num = cqueue.m_size;
+    int prevPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+    for (int i = 1; i < num; i++){
+        int currPriority = cqueue.m_priorFunc(cqueue.getNextOrder());
+        if (cqueue.m_heapType == MINHEAP){
+            result = result && (currPriority >= prevPriority);
+        }
+        else{
+            result = result && (currPriority <= prevPriority);
+        }
+        prevPriority = currPriority;
     }
-    else if ((lhsPtr != nullptr) && (rhsPtr != nullptr)){
-        bool result = true;
+    return result && (cqueue.m_size == 0);
+}
 
-        //m_left and m_right are both checked
-        result = result && assignmentHelper(result, lhsPtr->m_left, rhsPtr->m_left);
-        result = result && assignmentHelper(result, lhsPtr->m_right, rhsPtr->m_right);
-        
-        //if statement checks to ensure all orders are exactly the same by checking the ID, which was established to be unique
-        if ((lhsPtr->getOrder().getOrderID() == rhsPtr->getOrder().getOrderID())){
-            //second if statement checks to ensure the ptrs do not equal each other, and also checks some other variables to ensure also the same
-            if ((lhsPtr != rhsPtr) && (lhsPtr->m_npl == rhsPtr->m_npl)){
-                return result && true;
+//testConcurrentQueue
+//producers and consumers share the queue at the same time, every order must come out exactly once,
+//then a queue filled by several threads must hand out its orders in priority order
+bool Tester::testConcurrentQueue(ConcurrentCQueue& ccqueue){
+    bool result = true;
+    const int total = NUM_THREADS * NORMAL_CASE;
+
+    //an empty queue reports that nothing was found, or throws
+    Order order;
+    result = result && !ccqueue.tryGetNextOrder(order);
+    bool outOfRange = false;
+    try{
+        ccqueue.getNextOrder();
+    }
+    catch(const out_of_range &range){
+        outOfRange = true;
+    }
+    result = result && outOfRange;
+
+    //producers insert orders with unique IDs while consumers remove them
+    vector<int> seen(total, 0);
+    vector<vector<int> > removed(NUM_THREADS);
+    atomic<int> numRemoved(0);
+    vector<thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++){
+        threads.push_back(thread([&ccqueue, t](){
+            Random pointsGen(MINPOINTS, MAXPOINTS);
+            pointsGen.setSeed(t);
+            for (int i = 0; i < NORMAL_CASE; i++){
+                ccqueue.insertOrder(Order(static_cast<ITEM>(i % 6), ONE, static_cast<MEMBERSHIP>(t % 6),
+                        pointsGen.getRandNum(), MINCUSTID, MINORDERID + t * NORMAL_CASE + i));
             }
-            else{
-                return result && false; //else, false is returned
+        }));
+        threads.push_back(thread([&ccqueue, &removed, &numRemoved, total, t](){
+            Order myOrder;
+            while (numRemoved.load() < total){
+                if (ccqueue.tryGetNextOrder(myOrder)){
+                    removed[t].push_back(myOrder.getOrderID() - MINORDERID);
+                    ++numRemoved;
+                }
+            }
+        }));
+    }
+    for (unsigned int i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
+    threads.clear();
+
+    //every ID must have been removed exactly once
+    for (int t = 0; t < NUM_THREADS; t++){
+        for (unsigned int i = 0; i < removed[t].size(); i++){
+            ++seen[removed[t][i]];
+        }
+    }
+    for (int i = 0; i < total; i++){
+        result = result && (seen[i] == 1);
+    }
+    result = result && (ccqueue.numOrders() == 0) && (ccqueue.m_queue.numOrders() == 0);
+
+    //several threads fill the queue, then it is drained in priority order
+    for (int t = 0; t < NUM_THREADS; t++){
+        threads.push_back(thread([&ccqueue, t](){
+            Random pointsGen(MINPOINTS, MAXPOINTS);
+            pointsGen.setSeed(t + NUM_THREADS);
+            for (int i = 0; i < NORMAL_CASE; i++){
+                ccqueue.insertOrder(Order(static_cast<ITEM>(i % 6), ONE, static_cast<MEMBERSHIP>(t % 6),
+                        pointsGen.getRandNum(), MINCUSTID, MINORDERID + i));
             }
+        }));
+    }
+    for (unsigned int i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
+    result = result && (ccqueue.numOrders() == total);
+
+    prifn_t priorFn = ccqueue.m_queue.getPriorityFn();
+    int prevPriority = priorFn(ccqueue.getNextOrder());
+    for (int i = 1; i < total; i++){
+        int currPriority = priorFn(ccqueue.getNextOrder());
+        if (ccqueue.getHeapType() == MINHEAP){
+            result = result && (currPriority >= prevPriority);
         }
         else{
-            return result && false; //else, false is returned
+            result = result && (currPriority <= prevPriority);
         }
+        prevPriority = currPriority;
     }
-    else{
-        return result && false; //else, result and false is returned
-    }  
+    result = result && !ccqueue.tryGetNextOrder(order);
+
+    return result;
 }
 
-//normalCopyConstructor
-//tests copy constructor for normal cases
-bool Tester::normalCopyConstructor(CQueue& cqueue){
+//testCombinerException
+//several threads insert at once with a priority function that throws for some orders, each thread must
+//catch exactly the exceptions of its own orders, wherever the combiner ran them, and no lock or slot may be left held
+bool Tester::testCombinerException(){
     bool result = true;
+    const int total = NUM_THREADS * NORMAL_CASE;
+    ConcurrentCQueue ccqueue(failingFn, MINHEAP, LEFTIST);
+
+    //each thread counts the exceptions its inserts threw, and checks they were the orders expected to fail
+    vector<int> numThrown(NUM_THREADS, 0);
+    vector<int> threadResults(NUM_THREADS, 1); //one int per thread, the bits of a vector<bool> would be shared
+    vector<thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++){
+        threads.push_back(thread([&ccqueue, &numThrown, &threadResults, t](){
+            for (int i = 0; i < NORMAL_CASE; i++){
+                int orderID = MINORDERID + t * NORMAL_CASE + i;
+                try{
+                    ccqueue.insertOrder(Order(static_cast<ITEM>(i % 6), ONE, static_cast<MEMBERSHIP>(t % 6),
+                            MINPOINTS, MINCUSTID, orderID));
+                    threadResults[t] = threadResults[t] && (orderID % FAIL_EVERY != 0);
+                }
+                catch(const bad_alloc &error){
+                    ++numThrown[t];
+                    threadResults[t] = threadResults[t] && (orderID % FAIL_EVERY == 0);
+                }
+            }
+        }));
+    }
+    for (unsigned int i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
 
-    //randomFill called
-    randomFill(cqueue, NORMAL_CASE);
+    int expectedThrown = 0;
+    for (int id = MINORDERID; id < MINORDERID + total; id++){
+        expectedThrown += ((id % FAIL_EVERY == 0) ? 1 : 0);
+    }
+    int sumThrown = 0;
+    for (int t = 0; t < NUM_THREADS; t++){
+        sumThrown += numThrown[t];
+        result = result && threadResults[t];
+    }
+    result = result && (sumThrown == expectedThrown);
 
-    //first testQueue created to test if equal
-    CQueue* sameQueue = new CQueue(cqueue); 
+    //the lock is free and every slot is handed back without an exception left in it
+    result = result && !ccqueue.m_combining.load();
+    for (int i = 0; i < NUMCOMBINESLOTS; i++){
+        result = result && (ccqueue.m_slots[i].m_state.load() == SLOTFREE) && (ccqueue.m_slots[i].m_error == nullptr);
+    }
 
-    //first checked is sameQueue to ensure it is exactly the same as cqueue, but in different locations
-    result = result && assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap);
+    //the queue still works, holding exactly the orders that did not throw, in priority order
+    result = result && (ccqueue.m_queue.numOrders() == total - expectedThrown);
+    int prevPriority = 0;
+    for (int i = 0; (i < total - expectedThrown) && result; i++){
+        Order order = ccqueue.getNextOrder();
+        int currPriority = priorityFn2(order);
+        result = (order.getOrderID() % FAIL_EVERY != 0) && ((i == 0) || (currPriority >= prevPriority));
+        prevPriority = currPriority;
+    }
+    Order order;
+    return result && !ccqueue.tryGetNextOrder(order) && (ccqueue.numOrders() == 0);
+}
 
-    //then all member variables are checked
-    result = result && (cqueue.m_size == sameQueue->m_size);
-    result = result && (cqueue.m_heapType == sameQueue->m_heapType);
-    result = result && (cqueue.m_structure == sameQueue->m_structure);
-    result = result && (cqueue.m_priorFunc == sameQueue->m_priorFunc);
-    result = result && (cqueue.m_heap != sameQueue->m_heap);
+//testMultiQueue
+//producers and consumers share the queue at the same time, every order must come out exactly once,
+//then the rank reported by measureNextOrder is checked against a count taken from copies of the shards
+bool Tester::testMultiQueue(MultiCQueue& mqueue){
+    bool result = true;
+    const int total = NUM_THREADS * NORMAL_CASE;
+    result = result && (mqueue.numShards() == NUM_THREADS * DEFAULTSHARDFACTOR);
+
+    //an empty queue reports that nothing was found, or throws
+    Order order;
+    int rank = 0;
+    result = result && !mqueue.tryGetNextOrder(order) && !mqueue.measureNextOrder(order, rank);
+    bool outOfRange = false;
+    try{
+        mqueue.getNextOrder();
+    }
+    catch(const out_of_range &range){
+        outOfRange = true;
+    }
+    result = result && outOfRange;
+
+    //producers insert orders with unique IDs while consumers remove them
+    vector<int> seen(total, 0);
+    vector<vector<int> > removed(NUM_THREADS);
+    atomic<int> numRemoved(0);
+    vector<thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++){
+        threads.push_back(thread([&mqueue, t](){
+            Random pointsGen(MINPOINTS, MAXPOINTS);
+            pointsGen.setSeed(t);
+            for (int i = 0; i < NORMAL_CASE; i++){
+                mqueue.insertOrder(Order(static_cast<ITEM>(i % 6), ONE, static_cast<MEMBERSHIP>(t % 6),
+                        pointsGen.getRandNum(), MINCUSTID, MINORDERID + t * NORMAL_CASE + i));
+            }
+        }));
+        threads.push_back(thread([&mqueue, &removed, &numRemoved, total, t](){
+            Order myOrder;
+            while (numRemoved.load() < total){
+                if (mqueue.tryGetNextOrder(myOrder)){
+                    removed[t].push_back(myOrder.getOrderID() - MINORDERID);
+                    ++numRemoved;
+                }
+            }
+        }));
+    }
+    for (unsigned int i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
 
-    //tests then run to ensure properties hold up
-    if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == LEFTIST)){
-        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
-        result = result && leftistTest(result, sameQueue->m_heap);
+    //every ID must have been removed exactly once
+    for (int t = 0; t < NUM_THREADS; t++){
+        for (unsigned int i = 0; i < removed[t].size(); i++){
+            ++seen[removed[t][i]];
+        }
     }
-    else if ((sameQueue->m_heapType == MAXHEAP) && (sameQueue->m_structure == LEFTIST)){
-        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
-        result = result && leftistTest(result, sameQueue->m_heap);
+    for (int i = 0; i < total; i++){
+        result = result && (seen[i] == 1);
     }
-    else if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == SKEW)){
-        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    result = result && (mqueue.numOrders() == 0);
+
+    //the queue is refilled, then each measured rank is compared with a count from drained copies of every shard
+    Random pointsGen(MINPOINTS, MAXPOINTS);
+    for (int i = 0; i < NORMAL_CASE; i++){
+        mqueue.insertOrder(Order(static_cast<ITEM>(i % 6), ONE, static_cast<MEMBERSHIP>(i % 6),
+                pointsGen.getRandNum(), MINCUSTID, MINORDERID + i));
     }
-    else{
-        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    long rankSum = 0;
+    for (int i = 0; i < NORMAL_CASE; i++){
+        //the copies are taken before the removal, so they still hold the removed order, which is never ahead of itself
+        vector<CQueue> copies;
+        for (int s = 0; s < mqueue.numShards(); s++){
+            copies.push_back(mqueue.m_shards[s]->m_queue);
+        }
+
+        result = result && mqueue.measureNextOrder(order, rank);
+        prifn_t priorFn = copies[0].getPriorityFn();
+        int priority = priorFn(order);
+        int expected = 0;
+        for (unsigned int s = 0; s < copies.size(); s++){
+            //each copy is drained in priority order until its next order is no longer strictly ahead
+            while (copies[s].numOrders() > 0){
+                int currPriority = priorFn(copies[s].getNextOrder());
+                if ((mqueue.m_heapType == MINHEAP) ? (currPriority >= priority) : (currPriority <= priority)){
+                    break;
+                }
+                ++expected;
+            }
+        }
+        result = result && (rank == expected);
+        rankSum += rank;
     }
+    result = result && (mqueue.numOrders() == 0);
 
-    //cqueue cleared, then refilled
-    cqueue.clear();
+    //two choices keep the mean rank well below the size of the queue
+    result = result && (rankSum / NORMAL_CASE < NORMAL_CASE / 4);
 
-    randomFill(cqueue, NORMAL_CASE + 25);
+    return result;
+}
 
-    delete sameQueue; //sameQueue deleted
-    //double copy constructor done, to show that when copied twice, it'll still equal the same as the original
-    CQueue* tempQueue = new CQueue(cqueue);
-    sameQueue = new CQueue(*tempQueue);
+//testLazyMerge
+//merges several queues lazily, then checks that every removal still hands out the best order
+//and that copying, re-keying and turning lazy merging off meld the pending heaps correctly
+bool Tester::testLazyMerge(CQueue& cqueue){
+    bool result = true;
+    const int numQueues = 4;
 
-    //first checked is sameQueue to ensure it is exactly the same as cqueue, but in different locations
-    result = result && assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap);
+    //cqueue filled, then several more queues are merged into it without melding
+    cqueue.setLazyMerge(true);
+    result = result && cqueue.getLazyMerge();
+    randomFill(cqueue, NORMAL_CASE);
+    Node* root = cqueue.m_heap;
+    for (int i = 0; i < numQueues; i++){
+        CQueue closingQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        randomFill(closingQueue, NORMAL_CASE);
+        cqueue.mergeWithQueue(closingQueue);
+        result = result && (closingQueue.m_size == 0) && (closingQueue.m_heap == nullptr);
+    }
+    result = result && (cqueue.m_heap == root) && (int(cqueue.m_pending.size()) == numQueues);
+    result = result && (cqueue.m_size == NORMAL_CASE * (numQueues + 1));
+    result = result && (cqueue.m_pool.numLive() == NORMAL_CASE * (numQueues + 1));
+
+    //a queue with pending heaps of its own hands them over as well
+    CQueue lazyRegister(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    lazyRegister.setLazyMerge(true);
+    randomFill(lazyRegister, NORMAL_CASE);
+    CQueue innerRegister(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    randomFill(innerRegister, NORMAL_CASE);
+    lazyRegister.mergeWithQueue(innerRegister);
+    cqueue.mergeWithQueue(lazyRegister);
+    int total = NORMAL_CASE * (numQueues + 3);
+    result = result && (int(cqueue.m_pending.size()) == numQueues + 2) && (cqueue.m_size == total);
+
+    //the best priority is found without melding, and matches the first order removed
+    int topPriority = cqueue.getNextPriority();
+    result = result && (int(cqueue.m_pending.size()) == numQueues + 2);
+    result = result && (cqueue.countAhead(topPriority) == 0);
+
+    //a copy keeps the pending heaps, and both hand out their orders in priority order
+    CQueue sameQueue(cqueue);
+    result = result && (sameQueue.m_pending.size() == cqueue.m_pending.size());
+    result = result && (cqueue.m_priorFunc(cqueue.getNextOrder()) == topPriority);
+    result = result && (int(cqueue.m_pending.size()) == numQueues + 1);
+    result = result && drainTest(cqueue) && cqueue.m_pending.empty() && (cqueue.m_pool.numLive() == 0);
+
+    //changing the priority function melds the pending heaps first
+    prifn_t currFn = sameQueue.m_priorFunc;
+    HEAPTYPE currHeap = sameQueue.m_heapType;
+    sameQueue.setPriorityFn(((currFn == priorityFn2) ? priorityFn1 : priorityFn2), ((currHeap == MINHEAP) ? MAXHEAP : MINHEAP));
+    result = result && sameQueue.m_pending.empty() && (sameQueue.m_size == total);
+    result = result && drainTest(sameQueue);
+
+    //turning lazy merging off melds the pending heaps, and later merges meld at once
+    randomFill(cqueue, NORMAL_CASE);
+    CQueue lastRegister(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    randomFill(lastRegister, NORMAL_CASE);
+    cqueue.mergeWithQueue(lastRegister);
+    result = result && (cqueue.m_pending.size() == 1);
+    cqueue.setLazyMerge(false);
+    result = result && cqueue.m_pending.empty() && (cqueue.m_size == NORMAL_CASE * 2);
+    randomFill(lastRegister, NORMAL_CASE);
+    cqueue.mergeWithQueue(lastRegister);
+    result = result && cqueue.m_pending.empty() && (cqueue.m_size == NORMAL_CASE * 3);
+    result = result && drainTest(cqueue);
 
-    //then all member variables are checked
-    result = result && (cqueue.m_size == sameQueue->m_size);
-    result = result && (cqueue.m_heapType == sameQueue->m_heapType);
-    result = result && (cqueue.m_structure == sameQueue->m_structure);
-    result = result && (cqueue.m_priorFunc == sameQueue->m_priorFunc);
-    result = result && (cqueue.m_heap != sameQueue->m_heap);
+    return result;
+}
 
-    //tests then run to ensure properties hold up
-    if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == LEFTIST)){
-        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
-        result = result && leftistTest(result, sameQueue->m_heap);
+//testUpdateOrder
+//keeps a handle to every order, updates each one to a better or worse priority, and checks the heap,
+//the parent links and the handles after each round; pending heaps and bucket mode are updated as well
+bool Tester::testUpdateOrder(CQueue& cqueue){
+    bool result = true;
+    Random pointsGen(MINPOINTS, MAXPOINTS);
+    Random itemGen(0, 5); // there are six items
+    Random membershipGen(0, 5); // there are six tiers
+
+    //an empty handle is rejected, and a DARY heap hands out empty handles it cannot update
+    bool invalidArgument = false;
+    try{
+        cqueue.updateOrder(OrderHandle(), Order());
     }
-    else if ((sameQueue->m_heapType == MAXHEAP) && (sameQueue->m_structure == LEFTIST)){
-        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
-        result = result && leftistTest(result, sameQueue->m_heap);
+    catch(const invalid_argument &argument){
+        invalidArgument = true;
     }
-    else if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == SKEW)){
-        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    CQueue daryQueue(cqueue.m_priorFunc, cqueue.m_heapType, DARY);
+    result = result && invalidArgument && daryQueue.insertOrder(Order()).isEmpty();
+
+    //cqueue filled, every handle kept
+    vector<OrderHandle> handles;
+    for (int i = 0; i < NORMAL_CASE; i++){
+        handles.push_back(cqueue.insertOrder(Order(static_cast<ITEM>(itemGen.getRandNum()), ONE,
+                static_cast<MEMBERSHIP>(membershipGen.getRandNum()), pointsGen.getRandNum(), MINCUSTID, MINORDERID + i)));
     }
-    else{
-        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    result = result && updateHeapTest(cqueue);
+
+    //two rounds of updates, each order is given new data so its priority rises or falls
+    for (int round = 0; round < 2; round++){
+        for (int i = 0; i < NORMAL_CASE; i++){
+            Order order = handles[i].getOrder();
+            order.setPoints(pointsGen.getRandNum());
+            order.setItem(static_cast<ITEM>(itemGen.getRandNum()));
+            order.setMembership(static_cast<MEMBERSHIP>(membershipGen.getRandNum()));
+            cqueue.updateOrder(handles[i], order);
+            result = result && (handles[i].getOrder().getPoints() == order.getPoints());
+            if (i % 50 == 0){
+                result = result && updateHeapTest(cqueue);
+            }
+        }
     }
+    result = result && updateHeapTest(cqueue) && (cqueue.m_size == NORMAL_CASE) && (cqueue.m_pool.numLive() == NORMAL_CASE);
 
-    //everything is then emptied
-    cqueue.clear();
-    delete sameQueue;
-    delete tempQueue;
+    //the handles follow their orders through a rebuild
+    prifn_t currFn = cqueue.m_priorFunc;
+    HEAPTYPE currHeap = cqueue.m_heapType;
+    cqueue.setPriorityFn(((currFn == priorityFn2) ? priorityFn1 : priorityFn2), ((currHeap == MINHEAP) ? MAXHEAP : MINHEAP));
+    for (int i = 0; i < NORMAL_CASE; i += 3){
+        Order order = handles[i].getOrder();
+        order.setPoints(pointsGen.getRandNum());
+        order.setItem(static_cast<ITEM>(itemGen.getRandNum()));
+        cqueue.updateOrder(handles[i], order);
+    }
+    result = result && updateHeapTest(cqueue);
+    cqueue.setPriorityFn(currFn, currHeap);
 
-    //final test is done with assignment operator, then copied over using copy constructor
-    randomFill(cqueue, NORMAL_CASE + 50); //size slightly changed
-    tempQueue = new CQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
-    *tempQueue = cqueue;
-    sameQueue = new CQueue(*tempQueue);
+    //a lazily merged queue is updated through its handles, including the root of its pending heap
+    cqueue.setLazyMerge(true);
+    CQueue lazyQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    vector<OrderHandle> lazyHandles;
+    for (int i = 0; i < NORMAL_CASE; i++){
+        lazyHandles.push_back(lazyQueue.insertOrder(Order(static_cast<ITEM>(itemGen.getRandNum()), ONE,
+                static_cast<MEMBERSHIP>(membershipGen.getRandNum()), pointsGen.getRandNum(), MINCUSTID, MINORDERID + NORMAL_CASE + i)));
+    }
+    Node* pendingRoot = lazyQueue.m_heap;
+    cqueue.mergeWithQueue(lazyQueue);
+    result = result && (cqueue.m_pending.size() == 1);
+    for (int i = 0; i < NORMAL_CASE; i++){
+        Order order = lazyHandles[i].getOrder();
+        order.setPoints(pointsGen.getRandNum());
+        if (lazyHandles[i].m_node == pendingRoot){
+            //the root of a pending heap is cut off the pending list, so it is given a worse priority
+            order.setPoints((cqueue.m_heapType == MINHEAP) ? MAXPOINTS : MINPOINTS);
+            order.setItem(ICEDTEA);
+            order.setMembership(TIER6);
+            order.setCount(ONE);
+            cqueue.updateOrder(lazyHandles[i], order);
+            result = result && cqueue.m_pending.empty();
+        }
+        else{
+            cqueue.updateOrder(lazyHandles[i], order);
+        }
+    }
+    cqueue.setLazyMerge(false);
+    result = result && updateHeapTest(cqueue) && (cqueue.m_size == NORMAL_CASE * 2);
+
+    //every order comes out once, in priority order
+    vector<int> seen(NORMAL_CASE * 2, 0);
+    CQueue sameQueue(cqueue);
+    result = result && drainTest(sameQueue);
+    while (cqueue.m_size > 0){
+        ++seen[cqueue.getNextOrder().getOrderID() - MINORDERID];
+    }
+    for (int i = 0; i < NORMAL_CASE * 2; i++){
+        result = result && (seen[i] == 1);
+    }
 
-    //first checked is sameQueue to ensure it is exactly the same as cqueue, but in different locations
-    result = result && assignmentHelper(result, cqueue.m_heap, sameQueue->m_heap);
+    //bucket mode, the orders are kept below the top of the range so an update can fall outside it
+    handles.clear();
+    for (int i = 0; i < NORMAL_CASE; i++){
+        handles.push_back(cqueue.insertOrder(Order(static_cast<ITEM>(i % 3), ONE,
+                static_cast<MEMBERSHIP>(i % 3), pointsGen.getRandNum() / 2, MINCUSTID, MINORDERID + i)));
+    }
+    int maxPriority = 0;
+    for (int i = 0; i < NORMAL_CASE; i++){
+        int priority = cqueue.m_priorFunc(handles[i].getOrder());
+        maxPriority = ((priority > maxPriority) ? priority : maxPriority);
+    }
+    cqueue.setPriorityRange(0, maxPriority);
+    result = result && cqueue.isBucketMode();
+    for (int i = 0; i < NORMAL_CASE; i++){
+        Order order = handles[(i * 7) % NORMAL_CASE].getOrder();
+        order.setPoints(pointsGen.getRandNum() / 2);
+        order.setItem(static_cast<ITEM>(i % 3));
+        cqueue.updateOrder(handles[(i * 7) % NORMAL_CASE], order);
+    }
+    result = result && cqueue.isBucketMode() && bucketLinkTest(cqueue);
+
+    //an update outside the range falls back to the structure, and the handles stay valid
+    Order order = handles[0].getOrder();
+    order.setPoints(MAXPOINTS);
+    order.setItem(ICEDTEA);
+    order.setMembership(TIER6);
+    cqueue.updateOrder(handles[0], order);
+    result = result && !cqueue.isBucketMode() && (handles[0].getOrder().getPoints() == MAXPOINTS);
+    for (int i = 1; i < NORMAL_CASE; i += 5){
+        order = handles[i].getOrder();
+        order.setPoints(pointsGen.getRandNum());
+        cqueue.updateOrder(handles[i], order);
+    }
+    result = result && updateHeapTest(cqueue) && (cqueue.m_size == NORMAL_CASE);
+    result = result && drainTest(cqueue) && (cqueue.m_pool.numLive() == 0);
+
+    //a handle whose order was removed is stale, even once the pool hands its node out again
+    result = result && staleHandleTest(cqueue, handles[0]);
+    Order reused(COFFEE, ONE, TIER1, 10, MINCUSTID, MINORDERID);
+    OrderHandle reusedHandle;
+    for (int i = 0; (i < NORMAL_CASE) && (reusedHandle.m_node != handles[0].m_node); i++){
+        reusedHandle = cqueue.insertOrder(reused);
+    }
+    result = result && (reusedHandle.m_node == handles[0].m_node) && reusedHandle.isValid();
+    result = result && staleHandleTest(cqueue, handles[0]) && (reusedHandle.getOrder().getPoints() == 10);
+
+    //orders removed by getNextOrders or cancelOrder leave stale handles too
+    vector<Order> taken;
+    OrderHandle nextHandle = cqueue.insertOrder(Order(COFFEE, ONE, TIER1, 20, MINCUSTID, MINORDERID + 1));
+    cqueue.getNextOrders(cqueue.m_size, back_inserter(taken));
+    OrderHandle cancelHandle = cqueue.insertOrder(Order(COFFEE, ONE, TIER1, 30, MINCUSTID, MINORDERID + 2));
+    result = result && cqueue.cancelOrder(MINORDERID + 2);
+    result = result && staleHandleTest(cqueue, nextHandle) && staleHandleTest(cqueue, cancelHandle);
+
+    //orders moved into a DARY array and back are given new nodes, so their old handles are stale
+    OrderHandle movedHandle = cqueue.insertOrder(Order(COFFEE, ONE, TIER1, 40, MINCUSTID, MINORDERID + 3));
+    STRUCTURE structure = cqueue.m_structure;
+    cqueue.setStructure(DARY);
+    cqueue.setStructure(structure);
+    result = result && staleHandleTest(cqueue, movedHandle) && (cqueue.m_size == 1);
+
+    //an empty handle has no order to give
+    try{
+        OrderHandle().getOrder();
+        result = false;
+    }
+    catch (const invalid_argument& e){
+    }
 
-    //then all member variables are checked
-    result = result && (cqueue.m_size == sameQueue->m_size);
-    result = result && (cqueue.m_heapType == sameQueue->m_heapType);
-    result = result && (cqueue.m_structure == sameQueue->m_structure);
-    result = result && (cqueue.m_priorFunc == sameQueue->m_priorFunc);
-    result = result && (cqueue.m_heap != sameQueue->m_heap);
+    return result;
+}
 
-    //tests then run to ensure properties hold up
-    if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == LEFTIST)){
-        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
-        result = result && leftistTest(result, sameQueue->m_heap);
+//staleHandleTest
+//a stale handle is not valid, and neither updateOrder nor getOrder will use it; the queue must not change
+bool Tester::staleHandleTest(CQueue& cqueue, OrderHandle handle){
+    bool result = !handle.isEmpty() && !handle.isValid();
+    ostringstream before;
+    ostringstream after;
+    streambuf* coutBuf = cout.rdbuf(before.rdbuf());
+    cqueue.dump();
+    cout.rdbuf(coutBuf);
+
+    int thrown = 0;
+    try{
+        cqueue.updateOrder(handle, Order(WATER, DOZEN, TIER6, 0, MINCUSTID, MAXORDERID));
     }
-    else if ((sameQueue->m_heapType == MAXHEAP) && (sameQueue->m_structure == LEFTIST)){
-        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
-        result = result && leftistTest(result, sameQueue->m_heap);
+    catch (const domain_error& e){
+        ++thrown;
     }
-    else if ((sameQueue->m_heapType == MINHEAP) && (sameQueue->m_structure == SKEW)){
-        result = result && minheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    try{
+        handle.getOrder();
     }
-    else{
-        result = result && maxheapTest(result, sameQueue->m_heap, sameQueue->getPriorityFn());
+    catch (const domain_error& e){
+        ++thrown;
     }
 
+    coutBuf = cout.rdbuf(after.rdbuf());
+    cqueue.dump();
+    cout.rdbuf(coutBuf);
+    return result && (thrown == 2) && (before.str() == after.str());
+}
 
-    //all two temporary CQueues deleted
-    delete sameQueue;
-    delete tempQueue; 
-
+//parentTest
+//checks that every node points back to the node linking to it, its parent or its previous sibling
+bool Tester::parentTest(bool result, const Node* curr, const Node* linker){
+    //while loop walks the right links, recursing into the left ones
+    while (curr != nullptr){
+        result = result && (curr->m_parent == linker);
+        result = result && parentTest(result, curr->m_left, curr);
+        linker = curr;
+        curr = curr->m_right;
+    }
     return result;
 }
 
-//edgeCopyConstructor
-//tests copy constructor for edge cases
-bool Tester::edgeCopyConstructor(CQueue& cqueue){
+//updateHeapTest
+//checks the heap property, the parent links, and for a leftist heap the NPL and leftist property,
+//of m_heap and every pending heap
+bool Tester::updateHeapTest(CQueue& cqueue){
     bool result = true;
+    vector<Node*> roots(1, cqueue.m_heap);
+    roots.insert(roots.end(), cqueue.m_pending.begin(), cqueue.m_pending.end());
 
-    randomFill(cqueue, 1);//cqueue filled with one object
-
-    //first edge case is a copy construtor with an object with only one node
-    CQueue* testCQueue = new CQueue(cqueue);
+    for (unsigned int i = 0; i < roots.size(); i++){
+        result = result && parentTest(true, roots[i], nullptr);
+        if (cqueue.m_structure == PAIRING){
+            result = result && pairingHeapTest(true, roots[i], cqueue.m_heapType);
+        }
+        else if (cqueue.m_heapType == MINHEAP){
+            result = result && minheapTest(true, roots[i], cqueue.m_priorFunc);
+        }
+        else{
+            result = result && maxheapTest(true, roots[i], cqueue.m_priorFunc);
+        }
+        if (cqueue.m_structure == LEFTIST){
+            result = result && NPLTest(true, roots[i]) && leftistTest(true, roots[i]);
+        }
+    }
+    return result;
+}
 
-    result = result && (testCQueue->m_size == 1);
-    result = result && (testCQueue->m_heapType == cqueue.m_heapType);
-    result = result && (testCQueue->m_structure == cqueue.m_structure);
-    result = result && (testCQueue->m_priorFunc == cqueue.m_priorFunc);
-    result = result && (testCQueue->m_heap != nullptr);
+//bucketLinkTest
+//checks that every bucket holds only its own priority, and that each node points back to the one before it
+bool Tester::bucketLinkTest(CQueue& cqueue){
+    bool result = true;
+    int count = 0;
+    BucketQueue& buckets = cqueue.m_buckets;
+    for (int i = 0; i < int(buckets.m_heads.size()); i++){
+        const Node* prev = nullptr;
+        for (const Node* curr = buckets.m_heads[i]; curr != nullptr; curr = curr->m_right){
+            result = result && (curr->m_parent == prev) && (curr->m_priority == buckets.getMinPriority() + i);
+            result = result && (curr->m_priority == cqueue.m_priorFunc(curr->m_order));
+            prev = curr;
+            ++count;
+        }
+        result = result && (buckets.m_tails[i] == prev);
+    }
+    return result && (count == cqueue.m_size);
+}
 
-    //assignment helper called to double check
-    result = result && assignmentHelper(result, testCQueue->m_heap, cqueue.m_heap);
+//testCancelOrder
+//cancels orders by ID from the tree, pending heaps, buckets and a DARY array, first by searching and then
+//through the index; the heap and the index are checked after each step, and only the orders never
+//cancelled may come out at the end
+bool Tester::testCancelOrder(CQueue& cqueue){
+    bool result = true;
+    int maxPriority = ((cqueue.m_priorFunc == priorityFn1) ? 5003 : 10); //largest value of the priority function
+    STRUCTURE structure = cqueue.m_structure;
+    Random pointsGen(MINPOINTS, MAXPOINTS);
+    Random itemGen(0, 5); // there are six items
+    Random membershipGen(0, 5); // there are six tiers
+    const int total = NORMAL_CASE * 2;
+    vector<bool> present(total, false); //true while the order with ID MINORDERID + i is queued
+
+    //an empty queue has nothing to cancel
+    result = result && !cqueue.cancelOrder(MINORDERID);
+
+    //cqueue filled with unique order IDs
+    for (int i = 0; i < NORMAL_CASE; i++){
+        cqueue.insertOrder(Order(static_cast<ITEM>(itemGen.getRandNum()), ONE,
+                static_cast<MEMBERSHIP>(membershipGen.getRandNum()), pointsGen.getRandNum(), MINCUSTID, MINORDERID + i));
+        present[i] = true;
+    }
 
-    cqueue.clear(); //cqueue set to an empty object
+    //without the index every order is searched, a missing ID is reported
+    result = result && !cqueue.getOrderIndex() && cqueue.m_index.empty();
+    result = result && !cqueue.cancelOrder(MINORDERID + total);
+    result = result && cancelSome(cqueue, present, 0, 7) && updateHeapTest(cqueue);
+
+    //with the index every remaining node is filed, and cancelling keeps it in step
+    cqueue.setOrderIndex(true);
+    result = result && cqueue.getOrderIndex() && (int(cqueue.m_index.size()) == cqueue.m_size);
+    result = result && cancelSome(cqueue, present, 1, 7) && updateHeapTest(cqueue);
+    result = result && (int(cqueue.m_index.size()) == cqueue.m_size);
+
+    //a lazily merged queue without an index is indexed as it comes in, and its pending heap can be cancelled from
+    cqueue.setLazyMerge(true);
+    CQueue lazyQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    for (int i = NORMAL_CASE; i < total; i++){
+        lazyQueue.insertOrder(Order(static_cast<ITEM>(itemGen.getRandNum()), ONE,
+                static_cast<MEMBERSHIP>(membershipGen.getRandNum()), pointsGen.getRandNum(), MINCUSTID, MINORDERID + i));
+        present[i] = true;
+    }
+    cqueue.mergeWithQueue(lazyQueue);
+    result = result && (cqueue.m_pending.size() == 1) && (int(cqueue.m_index.size()) == cqueue.m_size);
+    result = result && cancelSome(cqueue, present, NORMAL_CASE, 5) && updateHeapTest(cqueue);
+    result = result && (int(cqueue.m_index.size()) == cqueue.m_size);
+    cqueue.setLazyMerge(false);
+
+    //two orders with the same ID are cancelled one at a time
+    cqueue.insertOrder(Order(COFFEE, ONE, TIER1, MINPOINTS, MINCUSTID, MINORDERID + total));
+    cqueue.insertOrder(Order(ICEDTEA, ONE, TIER6, MAXPOINTS, MINCUSTID, MINORDERID + total));
+    result = result && cqueue.cancelOrder(MINORDERID + total) && cqueue.cancelOrder(MINORDERID + total);
+    result = result && !cqueue.cancelOrder(MINORDERID + total) && (int(cqueue.m_index.size()) == cqueue.m_size);
+
+    //bucket mode, each order is unlinked from its bucket
+    cqueue.setPriorityRange(0, maxPriority);
+    result = result && cqueue.isBucketMode() && (int(cqueue.m_index.size()) == cqueue.m_size);
+    result = result && cancelSome(cqueue, present, 2, 7) && bucketLinkTest(cqueue);
+    result = result && (int(cqueue.m_index.size()) == cqueue.m_size);
+    cqueue.clearPriorityRange();
+
+    //a DARY heap has no nodes, so the index is emptied and the array is searched
+    cqueue.setStructure(DARY);
+    result = result && cqueue.m_index.empty() && cqueue.getOrderIndex();
+    result = result && cancelSome(cqueue, present, 3, 7) && daryHeapTest(cqueue);
+    cqueue.setStructure(structure);
+    result = result && (int(cqueue.m_index.size()) == cqueue.m_size);
+
+    //a copy keeps its own index, then the index is turned off and cancelling searches again
+    CQueue sameQueue(cqueue);
+    result = result && sameQueue.getOrderIndex() && (int(sameQueue.m_index.size()) == sameQueue.m_size);
+    result = result && drainTest(sameQueue) && sameQueue.m_index.empty();
+    cqueue.setOrderIndex(false);
+    result = result && cqueue.m_index.empty() && cancelSome(cqueue, present, 4, 7) && updateHeapTest(cqueue);
+
+    //only the orders never cancelled come out
+    int remaining = 0;
+    for (int i = 0; i < total; i++){
+        remaining += (present[i] ? 1 : 0);
+    }
+    result = result && (cqueue.m_size == remaining);
+    while (cqueue.m_size > 0){
+        int index = cqueue.getNextOrder().getOrderID() - MINORDERID;
+        result = result && present[index];
+        present[index] = false;
+    }
+    result = result && (cqueue.m_pool.numLive() == 0);
 
-    //two copy constructors are used
-    //the reason this is done is to prove that since the members variables are not initialized until...
-    //the assignment operator is called, the assignment operator still works correctly 
-    CQueue* tempCQueue = new CQueue(cqueue);
-    CQueue* emptyCQueue = new CQueue(*tempCQueue);
+    return result;
+}
 
-    //all member variables are checked between cqueue and emptyCQueue to ensure they match
-    result = result && (emptyCQueue->m_size == 0);
-    result = result && (emptyCQueue->m_heapType == cqueue.m_heapType);
-    result = result && (emptyCQueue->m_structure == cqueue.m_structure);
-    result = result && (emptyCQueue->m_priorFunc == cqueue.m_priorFunc);
-    result = result && (emptyCQueue->m_heap == nullptr);
+//cancelSome
+//cancels the orders start, start + step, ... that are still present, each must be found exactly once
+bool Tester::cancelSome(CQueue& cqueue, vector<bool>& present, int start, int step){
+    bool result = true;
+    for (int i = start; i < int(present.size()); i += step){
+        if (present[i]){
+            int size = cqueue.m_size;
+            result = result && cqueue.cancelOrder(MINORDERID + i) && (cqueue.m_size == size - 1);
+            result = result && !cqueue.cancelOrder(MINORDERID + i);
+            present[i] = false;
+        }
+    }
+    return result;
+}
 
-    //all dynamically allocated objects are deleted
-    delete testCQueue;
-    delete tempCQueue;
-    delete emptyCQueue;
+//testCompactOrder
+//checks that an Order packs into one word and a Node stays within 40 bytes, then that every
+//field keeps its largest and smallest value through the constructor and the setters, and that
+//a value too wide for its field is refused instead of wrapping
+bool Tester::testCompactOrder(){
+    bool result = (sizeof(Order) == 8) && (sizeof(Node) <= 40);
+
+    //largest values through the constructor
+    Order order(ICEDTEA, DOZEN, TIER6, MAXPOINTS, MAXCUSTID, MAXORDERID);
+    result = result && (order.getItem() == ICEDTEA) && (order.getCount() == DOZEN);
+    result = result && (order.getMemebership() == TIER6) && (order.getPoints() == MAXPOINTS);
+    result = result && (order.getCustomerID() == MAXCUSTID) && (order.getOrderID() == MAXORDERID);
+
+    //smallest values through the setters, one field at a time so no field spills into the next
+    order.setItem(COFFEE);
+    result = result && (order.getItem() == COFFEE) && (order.getCount() == DOZEN) && (order.getMemebership() == TIER6);
+    order.setCount(ONE);
+    result = result && (order.getCount() == ONE) && (order.getItem() == COFFEE) && (order.getPoints() == MAXPOINTS);
+    order.setMembership(TIER1);
+    result = result && (order.getMemebership() == TIER1) && (order.getPoints() == MAXPOINTS);
+    order.setPoints(MINPOINTS);
+    result = result && (order.getPoints() == MINPOINTS) && (order.getOrderID() == MAXORDERID);
+    order.setOrderID(MINORDERID);
+    result = result && (order.getOrderID() == MINORDERID) && (order.getCustomerID() == MAXCUSTID);
+    order.setCustomerID(MINCUSTID);
+    result = result && (order.getCustomerID() == MINCUSTID) && (order.getOrderID() == MINORDERID);
+
+    //the default order is still all zero fields
+    Order empty;
+    result = result && (empty.getOrderID() == 0) && (empty.getCustomerID() == 0) && (empty.getPoints() == 0);
+    result = result && (empty.getItem() == COFFEE) && (empty.getCount() == ONE) && (empty.getMemebership() == TIER5);
+
+    //the widest value of each field is kept exactly
+    const int maxID = (1 << IDBITS) - 1;
+    const int maxPoints = (1 << POINTSBITS) - 1;
+    Order widest(static_cast<ITEM>((1 << ITEMBITS) - 1), static_cast<COUNT>((1 << COUNTBITS) - 1),
+            static_cast<MEMBERSHIP>((1 << MEMBERSHIPBITS) - 1), maxPoints, maxID, maxID);
+    result = result && (widest.getPoints() == maxPoints) && (widest.getCustomerID() == maxID) && (widest.getOrderID() == maxID);
+    result = result && (widest.getItem() == (1 << ITEMBITS) - 1) && (widest.getCount() == (1 << COUNTBITS) - 1);
+    result = result && (widest.getMemebership() == (1 << MEMBERSHIPBITS) - 1);
+
+    //a negative or too wide value throws out_of_range from every setter and the constructor,
+    //and the order is left unchanged
+    auto refuses = [](auto change){
+        try{
+            change();
+        }
+        catch(const out_of_range &range){
+            return true;
+        }
+        return false;
+    };
+    result = result && refuses([&order](){ order.setPoints(-1); }) && refuses([&order](){ order.setPoints(maxPoints + 1); });
+    result = result && refuses([&order](){ order.setCustomerID(-1); }) && refuses([&order](){ order.setCustomerID(maxID + 1); });
+    result = result && refuses([&order](){ order.setOrderID(-1); }) && refuses([&order](){ order.setOrderID(maxID + 1); });
+    result = result && refuses([&order](){ order.setItem(static_cast<ITEM>(1 << ITEMBITS)); });
+    result = result && refuses([&order](){ order.setCount(static_cast<COUNT>(-1)); });
+    result = result && refuses([&order](){ order.setMembership(static_cast<MEMBERSHIP>(1 << MEMBERSHIPBITS)); });
+    result = result && (order.getPoints() == MINPOINTS) && (order.getCustomerID() == MINCUSTID) && (order.getOrderID() == MINORDERID);
+    result = result && (order.getItem() == COFFEE) && (order.getCount() == ONE) && (order.getMemebership() == TIER1);
+    result = result && refuses([](){ Order wrapped(COFFEE, ONE, TIER1, MINPOINTS, MINCUSTID, maxID + 1); });
+    result = result && refuses([](){ Order wrapped(COFFEE, ONE, TIER1, -1, MINCUSTID, MINORDERID); });
+
+    //an order ID that would once have wrapped onto a real one does not cancel it
+    CQueue cqueue(priorityFn2, MINHEAP, SKEW);
+    cqueue.insertOrder(Order(COFFEE, ONE, TIER1, MINPOINTS, MINCUSTID, 1));
+    result = result && !cqueue.cancelOrder(maxID + 2) && !cqueue.cancelOrder(-1) && (cqueue.numOrders() == 1);
+    result = result && cqueue.cancelOrder(1) && (cqueue.numOrders() == 0);
 
     return result;
 }
 
-//errorDequeue
-//tests to see if an out of range error is caught
-bool Tester::errorDequeue(CQueue& cqueue){
+//testDeepTree
+//builds a zigzag chain of DEEP_CASE nodes, which is as deep as a tree can be, then copies and clears it
+//and prints a shorter one, none of which may recurse on the depth of the tree
+bool Tester::testDeepTree(CQueue& cqueue){
     bool result = true;
 
-    //all are booleans used to ensure that the test is done correctly
-    bool pureEmpty = false;
-    bool emptyClear = false;
-    bool fullEmpty = false;
-    bool assignEmpty = false;
-
-    //first checks to ensure that the object is empty
-    result = result && (cqueue.m_heap == nullptr);
-    
-    //pure empty tested
-    try{
-        cqueue.getNextOrder();
+    //the copy must match node for node along the chain, with every parent link pointing into the copy
+    deepChain(cqueue, DEEP_CASE);
+    CQueue sameQueue(cqueue);
+    result = result && (sameQueue.m_size == DEEP_CASE) && (sameQueue.m_pool.numLive() == DEEP_CASE);
+    const Node* lhsPtr = cqueue.m_heap;
+    const Node* rhsPtr = sameQueue.m_heap;
+    const Node* rhsParent = nullptr;
+    for (int i = 0; (i < DEEP_CASE) && result; i++){
+        result = result && (rhsPtr != nullptr) && (rhsPtr != lhsPtr) && (rhsPtr->m_parent == rhsParent);
+        result = result && (rhsPtr->getOrder().getOrderID() == lhsPtr->getOrder().getOrderID());
+        result = result && (rhsPtr->getPriority() == lhsPtr->getPriority()) && (rhsPtr->getNPL() == lhsPtr->getNPL());
+        rhsParent = rhsPtr;
+        lhsPtr = ((i % 2 == 0) ? lhsPtr->m_left : lhsPtr->m_right);
+        rhsPtr = ((i % 2 == 0) ? rhsPtr->m_left : rhsPtr->m_right);
     }
-    catch(const out_of_range &range){
-        pureEmpty = true;
+    result = result && (rhsPtr == nullptr);
+
+    //both are cleared, every node goes back to its pool
+    sameQueue.clear();
+    cqueue.clear();
+    result = result && (sameQueue.m_pool.numLive() == 0) && (cqueue.m_pool.numLive() == 0);
+
+    //printOrdersQueue and dump write one entry per node of a shorter chain
+    deepChain(cqueue, LARGE_CASE);
+    ostringstream printed;
+    ostringstream dumped;
+    streambuf* coutBuf = cout.rdbuf(printed.rdbuf());
+    cqueue.printOrdersQueue();
+    cout.rdbuf(dumped.rdbuf());
+    cqueue.dump();
+    cout.rdbuf(coutBuf);
+    string printStr = printed.str();
+    string dumpStr = dumped.str();
+    result = result && (count(printStr.begin(), printStr.end(), '\n') == LARGE_CASE);
+    string rootPrefix = "[" + to_string(cqueue.m_heap->getPriority()) + "]";
+    result = result && (printStr.compare(0, rootPrefix.size(), rootPrefix) == 0);
+    result = result && (count(dumpStr.begin(), dumpStr.end(), '(') == LARGE_CASE);
+    result = result && (count(dumpStr.begin(), dumpStr.end(), ')') == LARGE_CASE);
+
+    //the deep chain is left in the queue for the destructor
+    return result;
+}
+
+//deepChain
+//replaces the queue with a chain of num nodes that alternates between left and right children,
+//ordered for the heap type and linked straight from the pool
+void Tester::deepChain(CQueue& cqueue, int num){
+    cqueue.clear();
+    Node* parent = nullptr;
+    for (int i = 0; i < num; i++){
+        //priority gets worse down the chain, since the best node must be at the root
+        int priority = ((cqueue.m_heapType == MINHEAP) ? i : num - i);
+        Node* curr = cqueue.m_pool.acquire(Order(COFFEE, ONE, TIER1, i % (MAXPOINTS + 1), MINCUSTID, MINORDERID + (i % (MAXORDERID - MINORDERID))), priority);
+        curr->setNPL(1);
+        curr->m_parent = parent;
+        if (parent == nullptr){
+            cqueue.m_heap = curr;
+        }
+        else if (i % 2 == 1){
+            parent->m_left = curr;
+        }
+        else{
+            parent->m_right = curr;
+        }
+        parent = curr;
     }
+    cqueue.m_size = num;
+}
 
-    //next, the cqueue is cleared
+//testPeekTopOrders
+//peeks at the top orders of an empty queue, a filled queue, a queue with pending heaps and a queue in buckets
+bool Tester::testPeekTopOrders(CQueue& cqueue){
+    bool result = true;
+    int maxPriority = ((cqueue.m_priorFunc == priorityFn1) ? 5003 : 10); //largest value of the priority function
+
+    //an empty queue, or a k that is not positive, gives nothing
+    result = result && cqueue.peekTopOrders(10).empty();
     randomFill(cqueue, NORMAL_CASE);
-    result = result && (cqueue.m_size == NORMAL_CASE);
+    result = result && cqueue.peekTopOrders(0).empty() && cqueue.peekTopOrders(-1).empty();
+
+    //a few, many, and more than every order
+    result = result && peekTest(cqueue, 1) && peekTest(cqueue, 10) && peekTest(cqueue, NORMAL_CASE / 2);
+    result = result && peekTest(cqueue, NORMAL_CASE * 2);
+
+    //inserts best first leave every other order as a child of a pairing root, a wide sibling list that a
+    //peek must not carry whole in its frontier
+    if (cqueue.m_structure == PAIRING){
+        CQueue sorted(cqueue.m_priorFunc, cqueue.m_heapType, PAIRING);
+        CQueue wideQueue(cqueue.m_priorFunc, cqueue.m_heapType, PAIRING);
+        randomFill(sorted, NORMAL_CASE);
+        while (sorted.m_size > 0){
+            wideQueue.insertOrder(sorted.getNextOrder());
+        }
+        int width = 0;
+        for (const Node* child = wideQueue.m_heap->m_left; child != nullptr; child = child->m_right){
+            ++width;
+        }
+        result = result && (width == NORMAL_CASE - 1);
+        result = result && peekTest(wideQueue, 1) && peekTest(wideQueue, 3) && peekTest(wideQueue, NORMAL_CASE / 2);
+        result = result && peekTest(wideQueue, NORMAL_CASE);
+    }
 
-    //next, clear is called, then again tested to see if it actually clears
-    cqueue.clear();
-    
-    //empty clear tested
-    try{
-        cqueue.getNextOrder();
+    //pending heaps are looked at without being melded
+    if (cqueue.m_structure != DARY){
+        cqueue.setLazyMerge(true);
+        CQueue lazyQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        randomFill(lazyQueue, NORMAL_CASE);
+        cqueue.mergeWithQueue(lazyQueue);
+        result = result && (cqueue.m_pending.size() == 1) && peekTest(cqueue, 10) && (cqueue.m_pending.size() == 1);
+        result = result && peekTest(cqueue, NORMAL_CASE * 2);
+        cqueue.setLazyMerge(false);
     }
-    catch(const out_of_range &range){
-        emptyClear = true;
+
+    //bucket mode, the buckets are read in priority order
+    cqueue.setPriorityRange(0, maxPriority);
+    result = result && cqueue.isBucketMode() && peekTest(cqueue, 10) && peekTest(cqueue, cqueue.m_size);
+
+    return result;
+}
+
+//peekTest
+//peeks at the top k orders, which must have the priorities a copy gives up in the same order,
+//and the printed queue, size and pool must be exactly the same afterwards
+bool Tester::peekTest(CQueue& cqueue, int k){
+    bool result = true;
+    ostringstream before;
+    ostringstream after;
+    streambuf* coutBuf = cout.rdbuf(before.rdbuf());
+    cqueue.printOrdersQueue();
+    int size = cqueue.m_size;
+    int live = cqueue.m_pool.numLive();
+
+    vector<Order> top = cqueue.peekTopOrders(k);
+
+    cout.rdbuf(after.rdbuf());
+    cqueue.printOrdersQueue();
+    cout.rdbuf(coutBuf);
+    result = result && (before.str() == after.str()) && (cqueue.m_size == size) && (cqueue.m_pool.numLive() == live);
+
+    //ties may come out in any order, so only the priorities are compared
+    CQueue sameQueue(cqueue);
+    result = result && (int(top.size()) == ((k < size) ? k : size));
+    for (unsigned int i = 0; i < top.size(); i++){
+        result = result && (cqueue.m_priorFunc(top[i]) == cqueue.m_priorFunc(sameQueue.getNextOrder()));
     }
+    return result;
+}
 
-    //next, randomly filled again, and each order is then removed
+//testSnapshot
+//saves and loads the queue empty, full, with a pending heap and in bucket mode, then checks that
+//a damaged or missing file is refused and that a snapshot of another kind of queue throws
+bool Tester::testSnapshot(CQueue& cqueue){
+    bool result = true;
+    int maxPriority = ((cqueue.m_priorFunc == priorityFn1) ? 5003 : 10); //largest value of the priority function
+
+    //an empty queue, then a full one
+    result = result && snapshotTest(cqueue);
     randomFill(cqueue, NORMAL_CASE);
+    result = result && snapshotTest(cqueue);
+
+    //a pending heap is saved as its own tree
+    if (cqueue.m_structure != DARY){
+        cqueue.setLazyMerge(true);
+        CQueue lazyQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        randomFill(lazyQueue, NORMAL_CASE);
+        cqueue.mergeWithQueue(lazyQueue);
+        result = result && (cqueue.m_pending.size() == 1) && snapshotTest(cqueue);
+        cqueue.setLazyMerge(false);
+    }
+
+    //a snapshot of another heap type or structure throws a domain error
+    result = result && cqueue.saveSnapshot(SNAPSHOT_FILE);
+    CQueue otherType(cqueue.m_priorFunc, ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP), cqueue.m_structure);
+    CQueue otherStructure(cqueue.m_priorFunc, cqueue.m_heapType, ((cqueue.m_structure == SKEW) ? PAIRING : SKEW));
     try{
-        for (int i = 0; i <= NORMAL_CASE; i++){
-            cqueue.getNextOrder();
-        }
+        otherType.loadSnapshot(SNAPSHOT_FILE);
+        result = false;
     }
-    catch(const out_of_range &range){
-        fullEmpty = true;
+    catch (const domain_error& e){
     }
-
-    //finally, is the assignment operator
-    CQueue* newQueue = new CQueue(cqueue);
-    
-    //tries to catch the assignment error
     try{
-        newQueue->getNextOrder();
+        otherStructure.loadSnapshot(SNAPSHOT_FILE);
+        result = false;
     }
-    catch(const out_of_range &range){
-        assignEmpty = true;
+    catch (const domain_error& e){
     }
 
-    //results of everything combined
-    result = result && pureEmpty && emptyClear && fullEmpty && assignEmpty;
+    //a missing file, a truncated file and a file with the wrong magic are refused, and the queue is left alone
+    ifstream inFile(SNAPSHOT_FILE, ios::binary);
+    string bytes((istreambuf_iterator<char>(inFile)), istreambuf_iterator<char>());
+    inFile.close();
+    string before = printed(cqueue);
+    remove(SNAPSHOT_FILE);
+    result = result && !cqueue.loadSnapshot(SNAPSHOT_FILE);
+    ofstream(SNAPSHOT_FILE, ios::binary).write(bytes.data(), bytes.size() - sizeof(SnapshotRecord) / 2);
+    result = result && !cqueue.loadSnapshot(SNAPSHOT_FILE);
+    string badMagic = bytes;
+    badMagic[0] = 'X';
+    ofstream(SNAPSHOT_FILE, ios::binary).write(badMagic.data(), badMagic.size());
+    result = result && !cqueue.loadSnapshot(SNAPSHOT_FILE) && (printed(cqueue) == before);
+
+    //a tree whose last record claims a child that is not there is refused, leaving the queue empty
+    if (cqueue.m_structure != DARY){
+        string badLinks = bytes;
+        badLinks[badLinks.size() - sizeof(SnapshotRecord) + sizeof(Order) + sizeof(int32_t)] = SNAPLEFT;
+        ofstream(SNAPSHOT_FILE, ios::binary).write(badLinks.data(), badLinks.size());
+        result = result && !cqueue.loadSnapshot(SNAPSHOT_FILE) && (cqueue.m_size == 0) && (cqueue.m_pool.numLive() == 0);
+        randomFill(cqueue, NORMAL_CASE);
+    }
 
-    delete newQueue;
+    //bucket mode, each bucket keeps its order
+    cqueue.setPriorityRange(0, maxPriority);
+    result = result && cqueue.isBucketMode() && snapshotTest(cqueue);
+
+    remove(SNAPSHOT_FILE);
     return result;
 }
 
-//errorMerge
-//attempts to get the errors for merge cases
-bool Tester::errorMerge(CQueue& cqueue){
-    bool result = true;
-
-    //all are booleans used to ensure that the test is done correctly
-    bool pureEmpty = false;
-    bool fullAttempt = false;
-    bool heapAttempts = false;
-    bool heapFullAttempt = false;
-    bool goodTest = true;
+//snapshotTest
+//saves the queue and loads it into a queue of the same kind that already holds orders, which must
+//then print and dump the same, keep every link, index and arity, and drain in priority order
+bool Tester::snapshotTest(CQueue& cqueue){
+    bool result = cqueue.saveSnapshot(SNAPSHOT_FILE);
+    CQueue loadedQueue(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure, ((cqueue.m_arity == 2) ? 8 : 2));
+    loadedQueue.setOrderIndex(true);
+    randomFill(loadedQueue, 10);
+    result = result && loadedQueue.loadSnapshot(SNAPSHOT_FILE);
+
+    result = result && (printed(loadedQueue) == printed(cqueue)) && (loadedQueue.m_size == cqueue.m_size);
+    result = result && (loadedQueue.m_pending.size() == cqueue.m_pending.size()) && (loadedQueue.m_bucketMode == cqueue.m_bucketMode);
+    result = result && (loadedQueue.m_arity == cqueue.m_arity) && (loadedQueue.m_pool.numLive() == ((cqueue.m_structure == DARY) && !cqueue.m_bucketMode ? 0 : cqueue.m_size));
+    result = result && (int(loadedQueue.m_index.size()) == (((cqueue.m_structure == DARY) && !cqueue.m_bucketMode) ? 0 : cqueue.m_size));
+
+    //the links are checked the same way as after an update
+    if (loadedQueue.m_bucketMode){
+        result = result && bucketLinkTest(loadedQueue);
+    }
+    else if (loadedQueue.m_structure == DARY){
+        result = result && daryHeapTest(loadedQueue);
+    }
+    else{
+        result = result && updateHeapTest(loadedQueue);
+    }
+    return result && drainTest(loadedQueue);
+}
 
-    //first checks to ensure that the object is empty
-    result = result && (cqueue.m_heap == nullptr);
-    
-    //testCQueue used to attempt to merge
-    CQueue* testCQueue = new CQueue(cqueue);
+//printed
+//returns what printOrdersQueue and dump write for the queue
+string Tester::printed(const CQueue& cqueue){
+    ostringstream output;
+    streambuf* coutBuf = cout.rdbuf(output.rdbuf());
+    cqueue.printOrdersQueue();
+    cqueue.dump();
+    cout.rdbuf(coutBuf);
+    return output.str();
+}
 
-    //opposite structure recorded
-    STRUCTURE oppStruct = ((cqueue.m_structure == LEFTIST) ? SKEW: LEFTIST);
+//testOrderLog
+//logs every kind of operation, including a merge, a change of priority function and a torn tail,
+//then recovers the queue after each stage; checks that commits are grouped, and that a priority
+//function the log cannot name is refused before the queue changes
+bool Tester::testOrderLog(CQueue& cqueue){
+    bool result = true;
+    vector<prifn_t> priFns = {priorityFn1, priorityFn2};
+    prifn_t oppFn = ((cqueue.m_priorFunc == priorityFn1) ? priorityFn2 : priorityFn1);
     HEAPTYPE oppHeap = ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP);
+    remove(LOG_FILE);
 
+    vector<Order> batch;
+    for (int i = 0; i < NORMAL_CASE / 2; i++){
+        batch.push_back(Order(static_cast<ITEM>(i % 6), static_cast<COUNT>(i % 4), static_cast<MEMBERSHIP>(i % 6),
+                    (i * 37) % MAXPOINTS, MINCUSTID + i, MINORDERID + i));
+    }
 
-    testCQueue->setStructure(oppStruct);
+    {
+        //attaching checkpoints the orders already queued
+        randomFill(cqueue, NORMAL_CASE);
+        OrderLog log(LOG_FILE, priFns, 200);
+        cqueue.attachLog(&log);
+        result = result && (cqueue.getLog() == &log) && recoverTest(cqueue, priFns);
+
+        //single and bulk insertions and removals, then a merge with a queue in bucket mode
+        randomFill(cqueue, 50);
+        cqueue.insertOrders(batch);
+        for (int i = 0; i < 20; i++){
+            cqueue.getNextOrder();
+        }
+        vector<Order> taken;
+        cqueue.getNextOrders(30, back_inserter(taken));
+        CQueue rhs(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        rhs.setPriorityRange(0, 5003);
+        rhs.insertOrders(batch);
+        cqueue.mergeWithQueue(rhs);
+        result = result && log.sync() && recoverTest(cqueue, priFns);
+
+        //a new priority function is logged, one the log cannot name is refused before anything changes
+        cqueue.setPriorityFn(oppFn, oppHeap);
+        cqueue.getNextOrder();
+        string before = printed(cqueue);
+        prifn_t unnamedFn = [](const Order& order){ return order.getPoints(); };
+        try{
+            cqueue.setPriorityFn(unnamedFn, MINHEAP);
+            result = false;
+        }
+        catch (const invalid_argument& e){
+        }
+        result = result && (printed(cqueue) == before) && (cqueue.m_priorFunc == oppFn);
+        result = result && log.sync() && recoverTest(cqueue, priFns);
+
+        //a torn record at the end is cut off, the records before it are still recovered
+        struct stat info;
+        stat(LOG_FILE, &info);
+        off_t whole = info.st_size;
+        ofstream(LOG_FILE, ios::binary | ios::app).write("\x01\x00\x00\x00\x08\x00\x00\x00torn", 12);
+        result = result && recoverTest(cqueue, priFns);
+        stat(LOG_FILE, &info);
+        result = result && (info.st_size == whole);
+
+        //a checkpoint starts the log again with only the priority function and a snapshot,
+        //and the queue is recovered from it and what follows
+        result = result && log.checkpoint(cqueue);
+        stat(LOG_FILE, &info);
+        result = result && (size_t(info.st_size) == 2 * sizeof(LogRecord) + 2 * sizeof(int32_t)
+                + sizeof(SnapshotHeader) + cqueue.m_size * sizeof(SnapshotRecord));
+        randomFill(cqueue, 10);
+        cqueue.getNextOrder();
+        result = result && log.sync() && recoverTest(cqueue, priFns);
 
-    //pure empty tested
-    try{
-        cqueue.mergeWithQueue(*testCQueue);
+        //commits are grouped, far fewer write and fsync pairs than operations
+        result = result && (log.numCommits() < 20) && !log.hasFailed();
+        cqueue.attachLog(nullptr);
     }
-    catch(const domain_error &domain){
-        pureEmpty = true;
+
+    {
+        //with no interval, every operation waits for its own commit
+        OrderLog eagerLog(LOG_FILE, priFns, 0);
+        cqueue.attachLog(&eagerLog);
+        for (int i = 0; i < 10; i++){
+            cqueue.insertOrder(batch[i]);
+        }
+        result = result && (eagerLog.numCommits() == 10) && recoverTest(cqueue, priFns);
+        cqueue.attachLog(nullptr);
     }
 
-    //next, both are filled, then they are attempted to be merged
-    randomFill(cqueue, NORMAL_CASE);
-    randomFill(*testCQueue, NORMAL_CASE);
-    result = result && (cqueue.m_size == NORMAL_CASE);
-    result = result && (testCQueue->m_size == NORMAL_CASE);
+    {
+        //two logged queues are merged, the log of rhs records that it was emptied, and each log
+        //recovers its own queue, including what rhs is given after the merge
+        OrderLog log(LOG_FILE, priFns, 200);
+        OrderLog rhsLog(RHS_LOG_FILE, priFns, 200);
+        cqueue.attachLog(&log);
+        CQueue rhs(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        randomFill(rhs, 50);
+        rhs.attachLog(&rhsLog);
+        rhs.insertOrders(batch);
+        cqueue.mergeWithQueue(rhs);
+        result = result && rhsLog.sync() && recoverTest(rhs, priFns, RHS_LOG_FILE) && (rhs.m_size == 0);
+        rhs.insertOrder(batch[0]);
+        cqueue.getNextOrder();
+        result = result && log.sync() && rhsLog.sync();
+        result = result && recoverTest(cqueue, priFns) && recoverTest(rhs, priFns, RHS_LOG_FILE);
+        cqueue.attachLog(nullptr);
+        rhs.attachLog(nullptr);
+        remove(RHS_LOG_FILE);
+    }
 
-    //next, they are attemped to be merge
-    try{
-        cqueue.mergeWithQueue(*testCQueue);
+    {
+        //the log moves with the orders, so the queue moved to keeps logging and the emptied rhs does not;
+        //the log of a queue that is moved into records that its own orders were dropped
+        OrderLog log(LOG_FILE, priFns, 200);
+        OrderLog targetLog(RHS_LOG_FILE, priFns, 200);
+        CQueue source(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        randomFill(source, 50);
+        source.attachLog(&log);
+        CQueue moved(std::move(source));
+        result = result && (moved.getLog() == &log) && (source.getLog() == nullptr);
+        moved.insertOrders(batch);
+        moved.getNextOrder();
+        source.insertOrder(batch[0]);
+        result = result && log.sync() && recoverTest(moved, priFns);
+
+        CQueue target(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        randomFill(target, 20);
+        target.attachLog(&targetLog);
+        target = std::move(moved);
+        result = result && (target.getLog() == &log) && (moved.getLog() == nullptr);
+        target.getNextOrder();
+        moved.insertOrder(batch[1]);
+        CQueue empty(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        result = result && log.sync() && targetLog.sync();
+        result = result && recoverTest(target, priFns) && recoverTest(empty, priFns, RHS_LOG_FILE);
+        target.attachLog(nullptr);
+        remove(RHS_LOG_FILE);
     }
-    catch(const domain_error &domain){
-        fullAttempt = true;
+
+    {
+        //clear, a copy, an update, a cancel, a loaded snapshot and each change of layout are logged,
+        //and the queue is recovered after each of them
+        OrderLog log(LOG_FILE, priFns, 200);
+        CQueue logged(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+        randomFill(logged, 50);
+        logged.attachLog(&log);
+        logged.insertOrders(batch);
+        logged.clear();
+        logged.insertOrder(batch[0]);
+        result = result && log.sync() && recoverTest(logged, priFns);
+
+        //a copy takes the policy and structure of rhs
+        CQueue other(oppFn, oppHeap, ((cqueue.m_structure == SKEW) ? PAIRING : SKEW));
+        randomFill(other, NORMAL_CASE / 2);
+        logged = other;
+        logged.getNextOrder();
+        result = result && log.sync() && recoverTest(logged, priFns);
+
+        //the index is not logged, so a cancel must remove the same one of two orders sharing an ID without it
+        logged.setOrderIndex(true);
+        Order twin(COFFEE, ONE, TIER1, 10, MINCUSTID, MINORDERID);
+        Order otherTwin(MILK, PAIR, TIER2, 4000, MINCUSTID + 1, MINORDERID);
+        OrderHandle handle = logged.insertOrder(twin);
+        logged.insertOrder(otherTwin);
+        logged.updateOrder(handle, Order(LATTE, HALFDOZEN, TIER3, 2500, MINCUSTID + 2, MINORDERID));
+        result = result && logged.cancelOrder(MINORDERID) && !logged.cancelOrder(MAXORDERID + 1);
+        result = result && log.sync() && recoverTest(logged, priFns);
+
+        //a snapshot loaded over the orders, then every change of layout
+        CQueue saved(logged.m_priorFunc, logged.m_heapType, logged.m_structure);
+        saved.insertOrders(batch);
+        result = result && saved.saveSnapshot(SNAPSHOT_FILE) && logged.loadSnapshot(SNAPSHOT_FILE);
+        result = result && log.sync() && recoverTest(logged, priFns);
+        logged.setStructure(DARY);
+        logged.setArity(4);
+        logged.cancelOrder(MINORDERID + 1);
+        logged.setStructure(cqueue.m_structure);
+        logged.setPriorityRange(0, 5003);
+        logged.getNextOrder();
+        result = result && log.sync() && recoverTest(logged, priFns);
+        logged.clearPriorityRange();
+        result = result && log.sync() && recoverTest(logged, priFns);
+
+        //heaps merged lazily are melded when lazy merging is turned off
+        if (cqueue.m_structure != DARY){
+            logged.setLazyMerge(true);
+            CQueue rhs(logged.m_priorFunc, logged.m_heapType, logged.m_structure);
+            randomFill(rhs, 30);
+            logged.mergeWithQueue(rhs);
+            logged.setLazyMerge(false);
+            result = result && log.sync() && recoverTest(logged, priFns);
+        }
+        logged.attachLog(nullptr);
+        remove(SNAPSHOT_FILE);
     }
 
-    //next, clear is called for both
-    cqueue.clear();
-    testCQueue->clear();
+    {
+        //a priority function that throws leaves the queue, its count, its pool and its log as they were,
+        //and the queue stays logged; a move is the only thing that must not throw
+        vector<prifn_t> failFns = {priorityFn1, priorityFn2, failingFn};
+        OrderLog log(LOG_FILE, failFns, 200);
+        CQueue logged(failingFn, MINHEAP, cqueue.m_structure);
+        vector<Order> safe;
+        for (const Order& order : batch){
+            if (order.getOrderID() % FAIL_EVERY != 0){
+                safe.push_back(order);
+            }
+        }
+        logged.insertOrders(safe);
+        logged.attachLog(&log);
+        OrderHandle handle = logged.insertOrder(safe[0]);
+        string before = printed(logged);
+        int live = logged.m_pool.numLive();
+        Order failing(COFFEE, ONE, TIER1, 10, MINCUSTID, FAIL_EVERY * (MINORDERID / FAIL_EVERY + 1));
+        int thrown = 0;
+        try{
+            logged.insertOrders(batch);
+        }
+        catch (const bad_alloc& e){
+            ++thrown;
+        }
+        try{
+            logged.insertOrder(failing);
+        }
+        catch (const bad_alloc& e){
+            ++thrown;
+        }
+        if (!handle.isEmpty()){
+            try{
+                logged.updateOrder(handle, failing);
+            }
+            catch (const bad_alloc& e){
+                ++thrown;
+            }
+        }
+        result = result && (thrown == (handle.isEmpty() ? 2 : 3)) && (printed(logged) == before) && (logged.m_pool.numLive() == live);
+        result = result && (logged.getLog() == &log) && log.sync() && recoverTest(logged, failFns);
+        result = result && is_nothrow_move_constructible<CQueue>::value;
+
+        //a replay that throws passes the exception on and leaves the recovering queue with its own log
+        OrderLog otherLog(RHS_LOG_FILE, failFns, 200);
+        CQueue recovered(priorityFn1, MINHEAP, cqueue.m_structure);
+        recovered.attachLog(&otherLog);
+        vector<prifn_t> swappedFns = {failingFn, priorityFn2, priorityFn2}; //priorityFn1 is replayed as failingFn
+        logged.setPriorityFn(priorityFn1, MAXHEAP);
+        logged.insertOrders(batch);
+        result = result && log.sync();
+        try{
+            OrderLog::recover(recovered, LOG_FILE, swappedFns);
+            result = false;
+        }
+        catch (const bad_alloc& e){
+        }
+        result = result && (recovered.getLog() == &otherLog);
+        logged.attachLog(nullptr);
+        recovered.attachLog(nullptr);
+        remove(RHS_LOG_FILE);
+    }
 
-    //then, the structures are the same, but the heaptypes are swapped
-    testCQueue->setStructure(cqueue.m_structure);
-    testCQueue->setPriorityFn(cqueue.m_priorFunc, oppHeap);
+    //a log that does not exist cannot be recovered
+    remove(LOG_FILE);
+    CQueue missing(cqueue.m_priorFunc, cqueue.m_heapType, cqueue.m_structure);
+    result = result && !OrderLog::recover(missing, LOG_FILE, priFns);
+    return result;
+}
 
-    //tries again this time with different heap types
-    try{
-        cqueue.mergeWithQueue(*testCQueue);
-    }
-    catch(const domain_error &domain){
-        heapAttempts = true;
+//recoverTest
+//recovers the log at path into a queue of the same structure but another policy, which must end up
+//printing and dumping exactly like cqueue, with the same policy and a valid heap
+bool Tester::recoverTest(const CQueue& cqueue, const vector<prifn_t>& priFns, const char* path){
+    CQueue recovered(((cqueue.m_priorFunc == priorityFn1) ? priorityFn2 : priorityFn1),
+            ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP), cqueue.m_structure);
+    bool result = OrderLog::recover(recovered, path, priFns);
+    result = result && (recovered.m_priorFunc == cqueue.m_priorFunc) && (recovered.m_heapType == cqueue.m_heapType);
+    result = result && (recovered.m_size == cqueue.m_size) && (printed(recovered) == printed(cqueue));
+    return result && drainTest(recovered);
+}
+
+//testIngest
+//writes a CSV file with a header, blank lines, carriage returns, spaces and a last line with no newline,
+//mixed with lines that are malformed or out of range, and a binary file with bad records and a cut off
+//tail; each is ingested with chunks smaller than a line or record and with the default chunk
+bool Tester::testIngest(CQueue& cqueue){
+    bool result = true;
+    randomFill(cqueue, NORMAL_CASE / 2);
+    vector<Order> expected;
+    for (int i = 0; i < NORMAL_CASE; i++){
+        expected.push_back(Order(static_cast<ITEM>(i % 6), static_cast<COUNT>((i / 6) % 4), static_cast<MEMBERSHIP>((i / 3) % 6),
+                    (i * 37) % (MAXPOINTS + 1), MINCUSTID + i, MAXORDERID - i));
     }
 
-    //next, randomly filled
-    randomFill(cqueue, NORMAL_CASE);
-    randomFill(*testCQueue, NORMAL_CASE);
-    result = result && (cqueue.m_size == NORMAL_CASE);
-    result = result && (testCQueue->m_size == NORMAL_CASE);
+    //every tenth line is followed by a line that must be rejected, the first on line 3
+    const char* badLines[] = {"6,0,0,10,100001,100001", "0,4,0,10,100001,100001", "0,0,6,10,100001,100001",
+        "0,0,0,5001,100001,100001", "0,0,0,-1,100001,100001", "0,0,0,10,100000,100001", "0,0,0,10,100001,1000000",
+        "0,0,0,10,100001", "0,0,0,10,100001,100001,7", "0,0,x,10,100001,100001", "0,0,,10,100001,100001",
+        "0,0,0,10,100001,10000100001"};
+    int numBad = sizeof(badLines) / sizeof(badLines[0]);
+    long numRejected = 0;
+    {
+        ofstream file(INGEST_FILE, ios::binary | ios::trunc);
+        file << "item,count,membership,points,customerID,orderID\n";
+        for (int i = 0; i < NORMAL_CASE; i++){
+            const Order& order = expected[i];
+            file << order.getItem() << "," << order.getCount() << ((i % 7 == 0) ? " , " : ",") << order.getMemebership() << ","
+                << order.getPoints() << "," << order.getCustomerID() << "," << order.getOrderID();
+            if (i == NORMAL_CASE - 1){
+                break;
+            }
+            file << ((i % 5 == 0) ? "\r\n" : "\n");
+            if (i % 10 == 0){
+                file << badLines[numRejected++ % numBad] << "\n";
+            }
+            if (i % 50 == 0){
+                file << "\n";
+            }
+        }
+    }
+    OrderIngest smallCSV(CSVFORMAT, 7);
+    result = result && ingestTest(cqueue, smallCSV, expected);
+    result = result && (smallCSV.numRejected() == numRejected) && (smallCSV.firstRejected() == 3);
+    OrderIngest wholeCSV(CSVFORMAT);
+    result = result && ingestTest(cqueue, wholeCSV, expected) && (wholeCSV.numRejected() == numRejected);
+
+    //binary records with a bad field or a nonzero padding byte are rejected, and so is a cut off tail
+    result = result && OrderIngest::writeBinary(INGEST_FILE, expected);
+    {
+        fstream file(INGEST_FILE, ios::binary | ios::in | ios::out);
+        file.seekp(5 * BINARYORDERSIZE);
+        file.put(6);
+        file.seekp(9 * BINARYORDERSIZE + 3);
+        file.put(1);
+        file.seekp(0, ios::end);
+        file.write("\x01\x02\x03", 3);
+    }
+    vector<Order> valid = expected;
+    valid.erase(valid.begin() + 9);
+    valid.erase(valid.begin() + 5);
+    OrderIngest smallBinary(BINARYFORMAT, 5);
+    result = result && ingestTest(cqueue, smallBinary, valid);
+    result = result && (smallBinary.numRejected() == 3) && (smallBinary.firstRejected() == 6);
+    OrderIngest wholeBinary(BINARYFORMAT);
+    result = result && ingestTest(cqueue, wholeBinary, valid) && (wholeBinary.numRejected() == 3);
+
+    //a file that does not exist is refused and the queue is left alone
+    remove(INGEST_FILE);
+    CQueue unchanged(cqueue);
+    string before = printed(unchanged);
+    result = result && !wholeBinary.ingest(INGEST_FILE, unchanged) && (printed(unchanged) == before);
+    return result;
+}
 
-    //finally, tested again with full but different heap types
-    try{
-        cqueue.mergeWithQueue(*testCQueue);
+//ingestTest
+//ingests the file into a copy of cqueue, which must then hold the orders of cqueue and exactly the
+//expected orders, and still be a valid heap
+bool Tester::ingestTest(const CQueue& cqueue, OrderIngest& ingest, const vector<Order>& expected){
+    CQueue ingested(cqueue);
+    bool result = ingest.ingest(INGEST_FILE, ingested) && (ingest.numOrders() == long(expected.size()));
+    result = result && (ingested.m_size == cqueue.m_size + int(expected.size()));
+
+    //the orders are compared by every field, sorted by order ID
+    CQueue original(cqueue);
+    vector<Order> orders(expected);
+    while (original.m_size > 0){
+        orders.push_back(original.getNextOrder());
     }
-    catch(const domain_error &domain){
-        heapFullAttempt = true;
+    vector<Order> drained;
+    CQueue copy(ingested);
+    while (copy.m_size > 0){
+        drained.push_back(copy.getNextOrder());
+    }
+    auto fields = [](const Order& order){
+        return make_tuple(order.getOrderID(), order.getCustomerID(), order.getPoints(),
+                int(order.getItem()), int(order.getCount()), int(order.getMemebership()));
+    };
+    auto byFields = [&fields](const Order& lhs, const Order& rhs){ return fields(lhs) < fields(rhs); };
+    sort(orders.begin(), orders.end(), byFields);
+    sort(drained.begin(), drained.end(), byFields);
+    result = result && (orders.size() == drained.size());
+    for (size_t i = 0; result && (i < orders.size()); i++){
+        result = (fields(orders[i]) == fields(drained[i]));
     }
+    return result && drainTest(ingested);
+}
 
-    //finally, heap type as the same, to prove that the try remains the same
-    cqueue.clear();
-    testCQueue->clear();
+//testStats
+//inserts, removes, merges and rebuilds, checking each counter against the work that must have been done;
+//a build without CQUEUE_STATS must report zero for everything
+bool Tester::testStats(CQueue& cqueue){
+    bool result = true;
+    bool nodes = (cqueue.m_structure != DARY);
+    randomFill(cqueue, 10);
+    cqueue.resetStats();
 
-    //finally, changed to be the same structure
-    testCQueue->setStructure(cqueue.m_structure);
-    testCQueue->setPriorityFn(cqueue.m_priorFunc, cqueue.m_heapType);
+    //each insertion calls the priority function once, and merges one lone node into the heap
+    randomFill(cqueue, NORMAL_CASE);
+    QueueStats stats = cqueue.stats();
+    if (!QueueStats::enabled()){
+        cqueue.getNextOrder();
+        stats = cqueue.stats();
+        ostringstream exported;
+        stats.exportCSV(exported);
+        return (stats.m_merges == 0) && (stats.m_priorityCalls == 0) && (stats.m_allocations == 0)
+            && (stats.m_insertLatency.count() == 0) && (stats.m_nextLatency.count() == 0)
+            && (exported.str().find("merges,0\n") == 0);
+    }
+    result = result && (stats.m_priorityCalls == NORMAL_CASE) && (stats.m_insertLatency.count() == NORMAL_CASE);
+    result = result && (stats.m_merges == (nodes ? NORMAL_CASE : 0)) && (stats.m_allocations == (nodes ? NORMAL_CASE : 0));
+    result = result && (stats.m_maxSpine <= stats.m_spineNodes) && (nodes == (stats.m_maxSpine > 0));
+    result = result && ((stats.m_nplSwaps > 0) == (cqueue.m_structure == LEFTIST)) && (stats.m_rebuilds == 0);
+
+    //a leftist right spine is at most log2(n+1) long, so one merge walks at most two of them
+    if (cqueue.m_structure == LEFTIST){
+        result = result && (stats.m_maxSpine <= 2 * 10);
+    }
 
-    //tested, so that goodTest remains true
+    //removals are timed, and every node heap merges to remove its root
+    for (int i = 0; i < 100; i++){
+        cqueue.getNextOrder();
+    }
+    QueueStats removed = cqueue.stats();
+    result = result && (removed.m_nextLatency.count() == 100) && (removed.m_priorityCalls == NORMAL_CASE);
+    result = result && ((removed.m_merges > stats.m_merges) == nodes);
+
+    //a new priority function keys every order again in one rebuild
+    cqueue.setPriorityFn(((cqueue.m_priorFunc == priorityFn1) ? priorityFn2 : priorityFn1),
+            ((cqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP));
+    QueueStats rebuilt = cqueue.stats();
+    result = result && (rebuilt.m_rebuilds == 1) && (rebuilt.m_priorityCalls == NORMAL_CASE + cqueue.m_size);
+
+    //a merge is timed once, and a copy starts with its own counters
+    CQueue rhs(cqueue);
+    result = result && (rhs.stats().m_mergeLatency.count() == 0) && (rhs.stats().m_priorityCalls == 0);
+    cqueue.mergeWithQueue(rhs);
+    stats = cqueue.stats();
+    result = result && (stats.m_mergeLatency.count() == 1) && (stats.m_insertLatency.count() == NORMAL_CASE);
+    result = result && (stats.m_insertLatency.percentile(0.5) > 0)
+        && (stats.m_insertLatency.percentile(0.5) <= stats.m_insertLatency.percentile(0.99));
+
+    //the export names every counter and the median of each histogram
+    ostringstream exported;
+    stats.exportCSV(exported);
+    result = result && (exported.str().find("priority_calls," + to_string(stats.m_priorityCalls) + "\n") != string::npos);
+    result = result && (exported.str().find("insertOrder_count," + to_string(NORMAL_CASE) + "\n") != string::npos);
+    result = result && (exported.str().find("mergeWithQueue_p50_ns,") != string::npos);
+
+    //a reset starts every count again
+    cqueue.resetStats();
+    stats = cqueue.stats();
+    result = result && (stats.m_merges == 0) && (stats.m_allocations == 0) && (stats.m_insertLatency.count() == 0);
+    return result;
+}
+
+//testPersistentQueue
+//takes snapshots and changes the queue after each, checking that every version keeps its own orders,
+//that the versions share their nodes, and that dropping a version frees only what it alone used;
+//then reader threads drain snapshots while the queue keeps changing, and drop them on their own threads
+bool Tester::testPersistentQueue(PersistentCQueue& pqueue){
+    bool result = true;
+    const long baseline = PersistentCQueue::numLiveNodes();
+    prifn_t priorFn = pqueue.m_priorFunc;
+    Random pointsGen(MINPOINTS, MAXPOINTS);
+    Random tierGen(0, 5);
+    int nextID = MINORDERID;
+    auto makeOrder = [&pointsGen, &tierGen, &nextID](){
+        int orderID = nextID++;
+        return Order(static_cast<ITEM>(tierGen.getRandNum()), static_cast<COUNT>(orderID % 4),
+                static_cast<MEMBERSHIP>(tierGen.getRandNum()), pointsGen.getRandNum(), MINCUSTID, orderID);
+    };
+
+    //with no other version alive, every node is changed in place, so the queue holds one node per order
+    vector<Order> orders;
+    for (int i = 0; i < NORMAL_CASE; i++){
+        orders.push_back(makeOrder());
+        pqueue.insertOrder(orders.back());
+    }
+    result = result && (PersistentCQueue::numLiveNodes() - baseline == NORMAL_CASE);
+
+    //a snapshot shares the root and costs nothing until either version changes
+    PersistentCQueue before = pqueue.snapshot();
+    result = result && (before.m_heap == pqueue.m_heap) && (PersistentCQueue::numLiveNodes() - baseline == NORMAL_CASE);
+
+    //changes to the queue copy only the shared nodes they walk, and the snapshot keeps every order
+    vector<Order> current(orders);
+    for (int i = 0; i < 100; i++){
+        Order removed = pqueue.getNextOrder();
+        for (unsigned int j = 0; j < current.size(); j++){
+            if (current[j].getOrderID() == removed.getOrderID()){
+                current.erase(current.begin() + j);
+                break;
+            }
+        }
+    }
+    for (int i = 0; i < 50; i++){
+        current.push_back(makeOrder());
+        pqueue.insertOrder(current.back());
+    }
+    long shared = PersistentCQueue::numLiveNodes() - baseline;
+    result = result && (shared < NORMAL_CASE + pqueue.m_size) && versionTest(before, orders) && versionTest(pqueue, current);
+
+    //dropping the snapshot frees the nodes only it used
+    before.clear();
+    result = result && (PersistentCQueue::numLiveNodes() - baseline == pqueue.m_size) && versionTest(pqueue, current);
+
+    //a merge leaves rhs empty but a snapshot of rhs keeps its orders, and a mismatched queue is refused
+    PersistentCQueue rhs(priorFn, pqueue.m_heapType, pqueue.m_structure);
+    vector<Order> rhsOrders;
+    for (int i = 0; i < 50; i++){
+        rhsOrders.push_back(makeOrder());
+        rhs.insertOrder(rhsOrders.back());
+    }
+    PersistentCQueue rhsBefore = rhs.snapshot();
+    pqueue.mergeWithQueue(rhs);
+    current.insert(current.end(), rhsOrders.begin(), rhsOrders.end());
+    result = result && (rhs.m_size == 0) && (rhs.m_heap == nullptr) && versionTest(rhsBefore, rhsOrders) && versionTest(pqueue, current);
+    PersistentCQueue mismatched(priorFn, ((pqueue.m_heapType == MINHEAP) ? MAXHEAP : MINHEAP), pqueue.m_structure);
     try{
-        cqueue.mergeWithQueue(*testCQueue);
+        pqueue.mergeWithQueue(mismatched);
+        result = false;
     }
-    catch(const domain_error &domain){
-        goodTest = false;
+    catch (const domain_error& e){
     }
 
-    //result then combined with the results of the other tests
-    result = result && pureEmpty && fullAttempt && heapAttempts && heapFullAttempt && goodTest;
+    //readers each drain a snapshot on their own thread while the queue keeps changing, then drop it there
+    vector<char> passed(NUM_THREADS, 0);
+    vector<thread> readers;
+    for (int t = 0; t < NUM_THREADS; t++){
+        readers.push_back(thread([this, &passed, t](PersistentCQueue version, vector<Order> expected){
+            passed[t] = versionTest(version, expected);
+        }, pqueue.snapshot(), current));
+
+        //the queue changes under the reader that was just started
+        for (int i = 0; i < 20; i++){
+            Order removed = pqueue.getNextOrder();
+            for (unsigned int j = 0; j < current.size(); j++){
+                if (current[j].getOrderID() == removed.getOrderID()){
+                    current.erase(current.begin() + j);
+                    break;
+                }
+            }
+            current.push_back(makeOrder());
+            pqueue.insertOrder(current.back());
+        }
+    }
+    for (unsigned int t = 0; t < readers.size(); t++){
+        readers[t].join();
+        result = result && passed[t];
+    }
+    result = result && versionTest(pqueue, current);
 
-    delete testCQueue; //testCQueue deleted
+    //the merge is the one a CQueue runs, so the same operations build exactly the same heap,
+    //whether every node is owned or a snapshot makes the spines shared
+    {
+        PersistentCQueue same(priorFn, pqueue.m_heapType, pqueue.m_structure);
+        CQueue reference(priorFn, pqueue.m_heapType, pqueue.m_structure);
+        for (const Order& order : orders){
+            same.insertOrder(order);
+            reference.insertOrder(order);
+        }
+        PersistentCQueue sameBefore = same.snapshot();
+        for (int i = 0; i < 100; i++){
+            result = result && (same.getNextOrder().getOrderID() == reference.getNextOrder().getOrderID());
+        }
+        result = result && sameShape(same, reference);
+        PersistentCQueue sameRhs(priorFn, pqueue.m_heapType, pqueue.m_structure);
+        CQueue referenceRhs(priorFn, pqueue.m_heapType, pqueue.m_structure);
+        for (const Order& order : rhsOrders){
+            sameRhs.insertOrder(order);
+            referenceRhs.insertOrder(order);
+        }
+        same.mergeWithQueue(sameRhs);
+        reference.mergeWithQueue(referenceRhs);
+        result = result && sameShape(same, reference);
+    }
+
+    //once only the queue is left, its nodes are all that remain, and clearing it frees them
+    rhsBefore.clear();
+    result = result && (PersistentCQueue::numLiveNodes() - baseline == pqueue.m_size);
+    pqueue.clear();
+    result = result && (PersistentCQueue::numLiveNodes() == baseline) && (pqueue.m_size == 0);
     return result;
-}
\ No newline at end of file
+}
+
+//sameShape
+//walks both heaps together, which must hold the same order with the same priority at every position
+bool Tester::sameShape(const PersistentCQueue& pqueue, const CQueue& cqueue){
+    bool result = (pqueue.m_size == cqueue.m_size);
+    vector<pair<const PersistentNode*, const Node*> > stack(1, make_pair(pqueue.m_heap, cqueue.m_heap));
+    while (!stack.empty() && result){
+        const PersistentNode* pcurr = stack.back().first;
+        const Node* curr = stack.back().second;
+        stack.pop_back();
+        result = ((pcurr == nullptr) == (curr == nullptr));
+        if (!result || (curr == nullptr)){
+            continue;
+        }
+        result = (pcurr->m_order.getOrderID() == curr->m_order.getOrderID()) && (pcurr->m_priority == curr->m_priority);
+        stack.push_back(make_pair(pcurr->m_left, curr->m_left));
+        stack.push_back(make_pair(pcurr->m_right, curr->m_right));
+    }
+    return result;
+}
+
+//versionTest
+//checks the heap order and, for a leftist heap, the NPL of every node of the version, then drains its own copy,
+//which must give back exactly the expected orders in priority order
+bool Tester::versionTest(PersistentCQueue version, const vector<Order>& expected){
+    bool result = (version.m_size == int(expected.size()));
+    vector<const PersistentNode*> stack(1, version.m_heap);
+    while (!stack.empty() && result){
+        const PersistentNode* curr = stack.back();
+        stack.pop_back();
+        if (curr == nullptr){
+            continue;
+        }
+        for (const PersistentNode* child : {curr->m_left, curr->m_right}){
+            result = result && ((child == nullptr) || version.hasPriority(curr, child));
+            stack.push_back(child);
+        }
+        if (version.m_structure == LEFTIST){
+            int leftNPL = ((curr->m_left == nullptr) ? 0 : curr->m_left->m_npl);
+            int rightNPL = ((curr->m_right == nullptr) ? 0 : curr->m_right->m_npl);
+            result = result && (leftNPL >= rightNPL) && (curr->m_npl == 1 + rightNPL);
+        }
+    }
+
+    //the orders come out in priority order, and as a set they are exactly the expected ones
+    vector<int> drainedIDs;
+    vector<int> expectedIDs;
+    int prevPriority = 0;
+    while (result && (version.m_size > 0)){
+        int currPriority = version.getNextPriority();
+        drainedIDs.push_back(version.getNextOrder().getOrderID());
+        if (drainedIDs.size() > 1){
+            result = (version.m_heapType == MINHEAP) ? (currPriority >= prevPriority) : (currPriority <= prevPriority);
+        }
+        prevPriority = currPriority;
+    }
+    for (const Order& order : expected){
+        expectedIDs.push_back(order.getOrderID());
+    }
+    sort(drainedIDs.begin(), drainedIDs.end());
+    sort(expectedIDs.begin(), expectedIDs.end());
+    return result && (drainedIDs == expectedIDs);
+}
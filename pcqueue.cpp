@@ -0,0 +1,272 @@
+// CMSC 341 - Spring 2023 - Project 3
+#include "pcqueue.h"
+
+atomic<long> PersistentCQueue::m_liveNodes(0);
+
+//constructor
+//creates an empty version, only a skew or leftist heap merges by walking its right spines
+PersistentCQueue::PersistentCQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure)
+    : m_heap(nullptr), m_size(0), m_priorFunc(priFn), m_heapType((heapType == MAXHEAP) ? MAXHEAP : MINHEAP),
+      m_structure(structure){
+    if ((structure != SKEW) && (structure != LEFTIST)){
+        throw domain_error("Domain error");
+    }
+}
+
+//destructor
+//drops the reference to the root, freeing whatever no other version shares
+PersistentCQueue::~PersistentCQueue(){
+    clear();
+}
+
+//copy constructor
+//shares the whole heap of rhs by taking one more reference to its root
+PersistentCQueue::PersistentCQueue(const PersistentCQueue& rhs)
+    : m_heap(retain(rhs.m_heap)), m_size(rhs.m_size), m_priorFunc(rhs.m_priorFunc), m_heapType(rhs.m_heapType),
+      m_structure(rhs.m_structure){
+}
+
+//assignment operator
+//the root of rhs is retained before the old root is released, so assigning a version to itself is safe
+PersistentCQueue& PersistentCQueue::operator=(const PersistentCQueue& rhs){
+    PersistentNode* heap = retain(rhs.m_heap);
+    release(m_heap);
+    m_heap = heap;
+    m_size = rhs.m_size;
+    m_priorFunc = rhs.m_priorFunc;
+    m_heapType = rhs.m_heapType;
+    m_structure = rhs.m_structure;
+    return *this;
+}
+
+//move constructor
+//takes over the reference rhs held, rhs is left empty
+PersistentCQueue::PersistentCQueue(PersistentCQueue&& rhs) noexcept
+    : m_heap(rhs.m_heap), m_size(rhs.m_size), m_priorFunc(rhs.m_priorFunc), m_heapType(rhs.m_heapType),
+      m_structure(rhs.m_structure){
+    rhs.m_heap = nullptr;
+    rhs.m_size = 0;
+}
+
+//move assignment operator
+//drops the old root and takes over the reference rhs held, rhs is left empty
+PersistentCQueue& PersistentCQueue::operator=(PersistentCQueue&& rhs) noexcept{
+    if (this != &rhs){
+        release(m_heap);
+        m_heap = rhs.m_heap;
+        m_size = rhs.m_size;
+        m_priorFunc = rhs.m_priorFunc;
+        m_heapType = rhs.m_heapType;
+        m_structure = rhs.m_structure;
+        rhs.m_heap = nullptr;
+        rhs.m_size = 0;
+    }
+    return *this;
+}
+
+//snapshot
+//returns a version sharing every node, the next change to either one copies what it touches
+PersistentCQueue PersistentCQueue::snapshot() const{
+    return PersistentCQueue(*this);
+}
+
+//insertOrder
+//merges a lone node holding the order into the heap
+void PersistentCQueue::insertOrder(const Order& order){
+    PersistentNode* node = newNode(order, m_priorFunc(order), 1);
+    m_heap = merge(m_heap, node);
+    ++m_size;
+}
+
+//getNextOrder
+//removes the root and merges its subtrees; a root shared with another version is left to that
+//version, and only references to its subtrees are taken
+Order PersistentCQueue::getNextOrder(){
+    if (m_heap == nullptr){
+        throw out_of_range("Out of Range");
+    }
+
+    PersistentNode* root = m_heap;
+    Order myOrder = root->m_order;
+    PersistentNode* left = nullptr;
+    PersistentNode* right = nullptr;
+
+    //if statement checks if the root belongs to this version alone, if so its references move here
+    if (root->m_refs.load(memory_order_acquire) == 1){
+        left = root->m_left;
+        right = root->m_right;
+        delete root;
+        m_liveNodes.fetch_sub(1, memory_order_relaxed);
+    }
+    else{
+        left = retain(root->m_left);
+        right = retain(root->m_right);
+        release(root);
+    }
+
+    m_heap = merge(left, right);
+    --m_size;
+    return myOrder;
+}
+
+//getNextPriority
+//returns the priority cached in the root, throws out_of_range if empty
+int PersistentCQueue::getNextPriority() const{
+    if (m_heap == nullptr){
+        throw out_of_range("Out of Range");
+    }
+    return m_heap->m_priority;
+}
+
+//mergeWithQueue
+//the heap of rhs is merged into this one and rhs is left empty, throws domain_error if the type or structure differ
+void PersistentCQueue::mergeWithQueue(PersistentCQueue& rhs){
+    if ((rhs.m_heapType != m_heapType) || (rhs.m_structure != m_structure)){
+        throw domain_error("Domain error");
+    }
+    if (this != &rhs){
+        //the reference rhs held moves into the merge
+        m_heap = merge(m_heap, rhs.m_heap);
+        m_size += rhs.m_size;
+        rhs.m_heap = nullptr;
+        rhs.m_size = 0;
+    }
+}
+
+//clear
+//drops the reference to the root, versions sharing the nodes keep them
+void PersistentCQueue::clear(){
+    release(m_heap);
+    m_heap = nullptr;
+    m_size = 0;
+}
+
+//numOrders
+//returns the number of orders in this version
+int PersistentCQueue::numOrders() const{
+    return m_size;
+}
+
+//printOrdersQueue
+//prints each node with its priority, parent first then left then right, with a stack instead of recursion
+void PersistentCQueue::printOrdersQueue() const{
+    vector<const PersistentNode*> stack(1, m_heap);
+
+    //while loop runs until every node has been printed
+    while (!stack.empty()){
+        const PersistentNode* curr = stack.back();
+        stack.pop_back();
+        if (curr == nullptr){
+            continue;
+        }
+
+        //the right child is pushed first so the left child comes off the stack first
+        cout << "[" << curr->m_priority << "] " << curr->m_order << endl;
+        stack.push_back(curr->m_right);
+        stack.push_back(curr->m_left);
+    }
+}
+
+//getPriorityFn
+//returns the priority function of the queue
+prifn_t PersistentCQueue::getPriorityFn() const{
+    return m_priorFunc;
+}
+
+//getHeapType
+//returns the heap type of the queue
+HEAPTYPE PersistentCQueue::getHeapType() const{
+    return m_heapType;
+}
+
+//getStructure
+//returns the structure of the queue
+STRUCTURE PersistentCQueue::getStructure() const{
+    return m_structure;
+}
+
+//numLiveNodes
+//returns the number of nodes every queue together has not yet freed
+long PersistentCQueue::numLiveNodes(){
+    return m_liveNodes.load(memory_order_relaxed);
+}
+
+//hasPriority
+//returns true if lhs belongs above rhs, ties keep lhs on top
+bool PersistentCQueue::hasPriority(const PersistentNode* lhs, const PersistentNode* rhs) const{
+    return (m_heapType == MINHEAP) ? (lhs->m_priority <= rhs->m_priority) : (lhs->m_priority >= rhs->m_priority);
+}
+
+//merge
+//takes one reference to each heap and returns one reference to the merged heap, through the same MergeEngine
+//as a CQueue; PersistentLinks owns each node taken off the right spines, copying it if it is shared, so the
+//nodes below the spines are shared untouched
+PersistentNode* PersistentCQueue::merge(PersistentNode* leftNode, PersistentNode* rightNode){
+    NoMergeCount counter;
+    PersistentLinks links;
+    if (m_structure == SKEW){
+        return (m_heapType == MINHEAP) ? MergeEngine<MINHEAP, SKEW>::merge(leftNode, rightNode, counter, links)
+                                       : MergeEngine<MAXHEAP, SKEW>::merge(leftNode, rightNode, counter, links);
+    }
+    return (m_heapType == MINHEAP) ? MergeEngine<MINHEAP, LEFTIST>::merge(leftNode, rightNode, counter, links)
+                                   : MergeEngine<MAXHEAP, LEFTIST>::merge(leftNode, rightNode, counter, links);
+}
+
+//own
+//returns node if the caller's reference is its only one, so it can be changed in place; otherwise
+//returns a copy that holds new references to both children, and drops the caller's reference to node
+PersistentNode* PersistentLinks::own(PersistentNode* node) const{
+    //the acquire load sees every change made by a version that has since dropped node
+    if (node->m_refs.load(memory_order_acquire) == 1){
+        return node;
+    }
+
+    PersistentNode* copy = PersistentCQueue::newNode(node->m_order, node->m_priority, node->m_npl);
+    copy->m_left = PersistentCQueue::retain(node->m_left);
+    copy->m_right = PersistentCQueue::retain(node->m_right);
+    PersistentCQueue::release(node);
+    return copy;
+}
+
+//newNode
+//allocates a node holding one reference, counted until it is freed
+PersistentNode* PersistentCQueue::newNode(const Order& order, int priority, int npl){
+    m_liveNodes.fetch_add(1, memory_order_relaxed);
+    return new PersistentNode(order, priority, npl);
+}
+
+//retain
+//adds a reference, nothing is ordered by it since the caller already reaches node
+PersistentNode* PersistentCQueue::retain(PersistentNode* node){
+    if (node != nullptr){
+        node->m_refs.fetch_add(1, memory_order_relaxed);
+    }
+    return node;
+}
+
+//release
+//drops a reference; a node left with none is freed and its children are released in turn, with a
+//stack instead of recursion since a skew heap can be deep
+void PersistentCQueue::release(PersistentNode* node){
+    //the release half orders this version's reads of node before whoever frees or changes it,
+    //and the acquire half orders every other version's reads before the free
+    if ((node == nullptr) || (node->m_refs.fetch_sub(1, memory_order_acq_rel) != 1)){
+        return;
+    }
+
+    vector<PersistentNode*> stack(1, node);
+    while (!stack.empty()){
+        PersistentNode* curr = stack.back();
+        stack.pop_back();
+
+        //each child is only freed if this was its last reference
+        PersistentNode* children[2] = {curr->m_left, curr->m_right};
+        for (PersistentNode* child : children){
+            if ((child != nullptr) && (child->m_refs.fetch_sub(1, memory_order_acq_rel) == 1)){
+                stack.push_back(child);
+            }
+        }
+        delete curr;
+        m_liveNodes.fetch_sub(1, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,94 @@
+// CMSC 341 - Spring 2023 - Project 3
+#ifndef PCQUEUE_H
+#define PCQUEUE_H
+#include "cqueue.h"
+#include <atomic>
+class PersistentCQueue; // forward declaration
+
+class PersistentNode{
+    // a node shared between versions of a PersistentCQueue; m_refs counts the
+    // nodes and versions linking to it, a node with one reference belongs to
+    // whoever holds that reference and may be changed in place, any other is
+    // copied before it is changed, and the last release frees it
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class PersistentCQueue;
+    friend class PersistentLinks;
+    template <HEAPTYPE heapType, STRUCTURE structure> friend class MergeEngine;
+    PersistentNode(const Order& order, int priority, int npl = 1)
+        : m_order(order), m_priority(priority), m_npl(npl), m_refs(1), m_left(nullptr), m_right(nullptr) {}
+    Order getOrder() const {return m_order;}
+    int getPriority() const {return m_priority;}
+    int getNPL() const {return m_npl;}
+
+    private:
+    Order m_order;           // order information
+    int m_priority;          // priority of m_order, computed once by the queue it was inserted into
+    int m_npl;               // null path length for leftist heap
+    atomic<int> m_refs;      // nodes and versions linking to this node
+    PersistentNode* m_left;  // left child
+    PersistentNode* m_right; // right child
+};
+
+class PersistentLinks{
+    // how a skew or leftist MergeEngine links the nodes of a PersistentCQueue:
+    // a node is owned before it is changed, copying it if another version
+    // shares it, and no parent is kept, since a shared node cannot point back
+    // to the one node it belongs under
+    public:
+    typedef PersistentNode NodeType;
+    PersistentNode* own(PersistentNode* node) const; // Return node itself if the reference is the only one, else a copy
+    void setParent(PersistentNode*, PersistentNode*) const {}
+};
+
+class PersistentCQueue{
+    // skew or leftist heap whose versions share every node they have in common;
+    // merge path-copies only the shared nodes it takes off the right spines,
+    // and a node only this version can reach is changed in place, so with no
+    // other version alive nothing is copied; snapshot and the copy constructor
+    // take one reference to the root in O(1), and the nodes of a version are
+    // freed when the last version using them is dropped; one thread changes a
+    // queue at a time, but its snapshots may be read, drained and dropped on
+    // any thread while it does
+    public:
+    friend class Grader; // for grading purposes
+    friend class Tester; // for testing purposes
+    friend class PersistentLinks;
+
+    // A domain error is thrown for a structure other than SKEW or LEFTIST
+    PersistentCQueue(prifn_t priFn, HEAPTYPE heapType, STRUCTURE structure);
+    ~PersistentCQueue();
+    PersistentCQueue(const PersistentCQueue& rhs); // Share every node of rhs in O(1)
+    PersistentCQueue& operator=(const PersistentCQueue& rhs);
+    PersistentCQueue(PersistentCQueue&& rhs) noexcept; // Take over the heap of rhs, leaving rhs empty
+    PersistentCQueue& operator=(PersistentCQueue&& rhs) noexcept;
+    PersistentCQueue snapshot() const; // Return a version that later changes to this queue leave alone, in O(1)
+    void insertOrder(const Order& order);
+    Order getNextOrder(); // Return the highest priority order, throws out_of_range if empty
+    int getNextPriority() const; // Return the priority of the next order, throws out_of_range if empty
+    // Merge rhs into this queue and leave rhs empty; versions taken from rhs keep its orders
+    void mergeWithQueue(PersistentCQueue& rhs);
+    void clear();
+    int numOrders() const; // Return number of orders in queue
+    void printOrdersQueue() const; // Print the queue using preorder traversal
+    prifn_t getPriorityFn() const;
+    HEAPTYPE getHeapType() const;
+    STRUCTURE getStructure() const;
+    static long numLiveNodes(); // Return number of nodes not yet freed by any queue
+
+    private:
+    PersistentNode* m_heap; // root of this version, the version holds one reference to it
+    int m_size;             // Current size of the heap
+    prifn_t m_priorFunc;    // Function to compute priority
+    HEAPTYPE m_heapType;    // either a MINHEAP or a MAXHEAP
+    STRUCTURE m_structure;  // skew or leftist heap
+    static atomic<long> m_liveNodes; // nodes allocated and not yet freed
+
+    bool hasPriority(const PersistentNode* lhs, const PersistentNode* rhs) const; //true if lhs belongs above rhs
+    PersistentNode* merge(PersistentNode* leftNode, PersistentNode* rightNode); //dispatches to the MergeEngine for this heap
+    static PersistentNode* newNode(const Order& order, int priority, int npl); //allocates a node holding one reference
+    static PersistentNode* retain(PersistentNode* node); //adds a reference to node, which may be nullptr
+    static void release(PersistentNode* node); //drops a reference, freeing every node left without one
+};
+#endif